@@ -0,0 +1,208 @@
+/*****< bondtable.c >**********************************************************/
+/*                                                                            */
+/*  BONDTABLE - Table of bonded devices with LRU eviction.                    */
+/*                                                                            */
+/******************************************************************************/
+#include "BondTable.h"           /* Bond Table Prototypes/Constants.          */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+   /* The following value is used to mark the end of the hash, free and */
+   /* LRU lists (all lists are linked by entry index).                  */
+#define BOND_TABLE_INVALID_INDEX                         (0xFF)
+
+   /* The following MACRO determines the hash bucket of a BD_ADDR.      */
+#define BOND_TABLE_HASH(_x)                              ((Byte_t)((_x).BD_ADDR0 ^ (_x).BD_ADDR1 ^ (_x).BD_ADDR2 ^ (_x).BD_ADDR3 ^ (_x).BD_ADDR4 ^ (_x).BD_ADDR5) & (BOND_TABLE_HASH_SIZE - 1))
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the compiler*/
+   /* as part of standard C/C++).                                       */
+
+static Bond_Entry_t BondTable[BOND_TABLE_SIZE];     /* Holds the bonded       */
+                                                    /* devices.               */
+
+static Byte_t       HashHead[BOND_TABLE_HASH_SIZE]; /* Holds the first entry  */
+static Byte_t       HashNext[BOND_TABLE_SIZE];      /* of every hash bucket   */
+                                                    /* and the next entry in  */
+                                                    /* the same bucket (or in */
+                                                    /* the free list).        */
+
+static Byte_t       FreeHead;                       /* Holds the first unused */
+                                                    /* entry.                 */
+
+static Byte_t       LRUPrevious[BOND_TABLE_SIZE];   /* Holds the LRU list,    */
+static Byte_t       LRUNext[BOND_TABLE_SIZE];       /* ordered from the Most  */
+static Byte_t       LRUHead;                        /* (head) to the Least    */
+static Byte_t       LRUTail;                        /* (tail) Recently Used.  */
+
+static Boolean_t    Initialized;                    /* Flags whether the lists*/
+                                                    /* have been initialized. */
+
+   /* Internal Function Prototypes.                                     */
+static Byte_t FindEntry(BD_ADDR_t BD_ADDR);
+static void LRUUnlink(Byte_t Index);
+static void LRUInsertHead(Byte_t Index);
+static void RemoveEntry(Byte_t Index);
+
+   /* The following function returns the index of the entry of the      */
+   /* specified device, or BOND_TABLE_INVALID_INDEX if the device is not*/
+   /* in the table.                                                     */
+static Byte_t FindEntry(BD_ADDR_t BD_ADDR)
+{
+   Byte_t Index;
+
+   if(!Initialized)
+      BondTable_Initialize();
+
+   Index = HashHead[BOND_TABLE_HASH(BD_ADDR)];
+
+   while((Index != BOND_TABLE_INVALID_INDEX) && (!COMPARE_BD_ADDR(BondTable[Index].BD_ADDR, BD_ADDR)))
+      Index = HashNext[Index];
+
+   return(Index);
+}
+
+   /* The following function removes an entry from the LRU list.        */
+static void LRUUnlink(Byte_t Index)
+{
+   if(LRUPrevious[Index] != BOND_TABLE_INVALID_INDEX)
+      LRUNext[LRUPrevious[Index]] = LRUNext[Index];
+   else
+      LRUHead = LRUNext[Index];
+
+   if(LRUNext[Index] != BOND_TABLE_INVALID_INDEX)
+      LRUPrevious[LRUNext[Index]] = LRUPrevious[Index];
+   else
+      LRUTail = LRUPrevious[Index];
+}
+
+   /* The following function inserts an entry at the head (Most Recently*/
+   /* Used end) of the LRU list.                                        */
+static void LRUInsertHead(Byte_t Index)
+{
+   LRUPrevious[Index] = BOND_TABLE_INVALID_INDEX;
+   LRUNext[Index]     = LRUHead;
+
+   if(LRUHead != BOND_TABLE_INVALID_INDEX)
+      LRUPrevious[LRUHead] = Index;
+   else
+      LRUTail = Index;
+
+   LRUHead = Index;
+}
+
+   /* The following function removes an entry from its hash bucket and  */
+   /* the LRU list and returns it to the free list.                     */
+static void RemoveEntry(Byte_t Index)
+{
+   Byte_t *Link;
+
+   /* Unlink the entry from its hash bucket.                            */
+   Link = &(HashHead[BOND_TABLE_HASH(BondTable[Index].BD_ADDR)]);
+   while(*Link != Index)
+      Link = &(HashNext[*Link]);
+
+   *Link = HashNext[Index];
+
+   LRUUnlink(Index);
+
+   BTPS_MemInitialize(&(BondTable[Index]), 0, BOND_ENTRY_DATA_SIZE);
+
+   HashNext[Index] = FreeHead;
+   FreeHead        = Index;
+}
+
+   /* The following function removes all devices from the Bond Table.   */
+void BondTable_Initialize(void)
+{
+   Byte_t Index;
+
+   BTPS_MemInitialize(BondTable, 0, sizeof(BondTable));
+   BTPS_MemInitialize(HashHead, BOND_TABLE_INVALID_INDEX, sizeof(HashHead));
+
+   /* Chain all entries into the free list.                             */
+   for(Index = 0; Index < BOND_TABLE_SIZE; Index++)
+      HashNext[Index] = (Byte_t)((Index < (BOND_TABLE_SIZE - 1))?(Index + 1):BOND_TABLE_INVALID_INDEX);
+
+   FreeHead    = 0;
+   LRUHead     = BOND_TABLE_INVALID_INDEX;
+   LRUTail     = BOND_TABLE_INVALID_INDEX;
+   Initialized = TRUE;
+}
+
+   /* The following function looks up a device in the Bond Table.       */
+Bond_Entry_t *BondTable_Search(BD_ADDR_t BD_ADDR)
+{
+   Byte_t        Index;
+   Bond_Entry_t *ret_val = NULL;
+
+   if((Index = FindEntry(BD_ADDR)) != BOND_TABLE_INVALID_INDEX)
+   {
+      /* Mark the device as the Most Recently Used.                     */
+      LRUUnlink(Index);
+      LRUInsertHead(Index);
+
+      ret_val = &(BondTable[Index]);
+   }
+
+   return(ret_val);
+}
+
+   /* The following function adds a device to the Bond Table.           */
+Bond_Entry_t *BondTable_Add(BD_ADDR_t BD_ADDR, Bond_Entry_t *EvictedEntry, Boolean_t *Evicted)
+{
+   Byte_t        Index;
+   Byte_t        Bucket;
+   Bond_Entry_t *ret_val;
+
+   if(Evicted)
+      *Evicted = FALSE;
+
+   if((ret_val = BondTable_Search(BD_ADDR)) == NULL)
+   {
+      /* The device is not yet in the table, evict the Least Recently   */
+      /* Used device if there is no unused entry left.                  */
+      if(FreeHead == BOND_TABLE_INVALID_INDEX)
+      {
+         if(EvictedEntry)
+            *EvictedEntry = BondTable[LRUTail];
+
+         if(Evicted)
+            *Evicted = TRUE;
+
+         RemoveEntry(LRUTail);
+      }
+
+      /* Take the first unused entry and link it into its hash bucket   */
+      /* and at the head of the LRU list.                               */
+      Index    = FreeHead;
+      FreeHead = HashNext[Index];
+
+      BondTable[Index].BD_ADDR = BD_ADDR;
+
+      Bucket           = BOND_TABLE_HASH(BD_ADDR);
+      HashNext[Index]  = HashHead[Bucket];
+      HashHead[Bucket] = Index;
+
+      LRUInsertHead(Index);
+
+      ret_val = &(BondTable[Index]);
+   }
+
+   return(ret_val);
+}
+
+   /* The following function removes a device from the Bond Table.      */
+Boolean_t BondTable_Delete(BD_ADDR_t BD_ADDR)
+{
+   Byte_t    Index;
+   Boolean_t ret_val = FALSE;
+
+   if((Index = FindEntry(BD_ADDR)) != BOND_TABLE_INVALID_INDEX)
+   {
+      RemoveEntry(Index);
+
+      ret_val = TRUE;
+   }
+
+   return(ret_val);
+}
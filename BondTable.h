@@ -0,0 +1,74 @@
+/*****< bondtable.h >**********************************************************/
+/*                                                                            */
+/*  BONDTABLE - Table of bonded devices with LRU eviction.                    */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __BONDTABLE_H__
+#define __BONDTABLE_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following defines the number of bonded devices that are       */
+   /* retained in the Bond Table.  Once the table is full, adding a new */
+   /* device evicts the Least Recently Used one.  This value may be     */
+   /* overridden on the compiler command line.                          */
+   /* * NOTE * This value MUST be less than 255.                        */
+#ifndef BOND_TABLE_SIZE
+   #define BOND_TABLE_SIZE                               (8)
+#endif
+
+   /* The following defines the number of hash buckets that are used to */
+   /* look up a device in the Bond Table.                               */
+   /* * NOTE * This value MUST be a power of two.                       */
+#define BOND_TABLE_HASH_SIZE                             (16)
+
+   /* The following bit masks are used with the Flags member of the     */
+   /* Bond_Entry_t structure.                                           */
+#define BOND_ENTRY_FLAGS_LINK_KEY_VALID                  0x01
+#define BOND_ENTRY_FLAGS_LE_BONDED                       0x02
+
+   /* The following structure represents a single bonded device.  The   */
+   /* Link Key is only valid if BOND_ENTRY_FLAGS_LINK_KEY_VALID is set  */
+   /* (BR/EDR bond), the Address Type is only valid if                  */
+   /* BOND_ENTRY_FLAGS_LE_BONDED is set (LE bond).                      */
+   /* * NOTE * The Link Key is not stored in an LE only build (see      */
+   /*          LE_ONLY_BUILD in SPPLEDemo.c).                           */
+typedef struct _tagBond_Entry_t
+{
+   BD_ADDR_t             BD_ADDR;
+   GAP_LE_Address_Type_t AddressType;
+   Byte_t                Flags;
+#ifndef LE_ONLY_BUILD
+   Link_Key_t            LinkKey;
+#endif
+} Bond_Entry_t;
+
+#define BOND_ENTRY_DATA_SIZE                             (sizeof(Bond_Entry_t))
+
+   /* The following function removes all devices from the Bond Table.   */
+void BondTable_Initialize(void);
+
+   /* The following function looks up the specified device in the Bond  */
+   /* Table and marks it as the Most Recently Used.  This function      */
+   /* returns a pointer to the entry of the device, or NULL if the      */
+   /* device is not in the table.                                       */
+   /* * NOTE * The returned entry may be modified by the caller, but is */
+   /*          only valid until the next call to BondTable_Add() or     */
+   /*          BondTable_Delete().                                      */
+Bond_Entry_t *BondTable_Search(BD_ADDR_t BD_ADDR);
+
+   /* The following function adds the specified device to the Bond Table*/
+   /* (or returns its existing entry) and marks it as the Most Recently */
+   /* Used.  A new entry has all Flags cleared.  If the table is full,  */
+   /* the Least Recently Used device is evicted first:  its entry is    */
+   /* copied to the second parameter (if not NULL) and the third        */
+   /* parameter is set to TRUE.  This function returns a pointer to the */
+   /* entry of the device.                                              */
+Bond_Entry_t *BondTable_Add(BD_ADDR_t BD_ADDR, Bond_Entry_t *EvictedEntry, Boolean_t *Evicted);
+
+   /* The following function removes the specified device from the Bond */
+   /* Table.  This function returns TRUE if the device was in the table */
+   /* or FALSE otherwise.                                               */
+Boolean_t BondTable_Delete(BD_ADDR_t BD_ADDR);
+
+#endif
@@ -0,0 +1,91 @@
+/*****< boottime.c >***********************************************************/
+/*                                                                            */
+/*  BOOTTIME - Boot-to-advertising time measurement.                          */
+/*                                                                            */
+/******************************************************************************/
+#include "HAL.h"                 /* Function for Hardware Abstraction.        */
+#include "BootTime.h"            /* Boot Time Prototypes/Constants.           */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+#define Display(_x)                                do { BTPS_OutputMessage _x; } while(0)
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the compiler*/
+   /* as part of standard C/C++).                                       */
+
+static Boolean_t  Started;                          /* Time from the reset to */
+static DWord_t    ResetTime;                        /* the first start.       */
+
+static DWord_t    StartTimeStamp;                   /* Time stamps of the     */
+static DWord_t    TimeStamps[BOOT_TIME_NUMBER_OF_PHASES]; /* current start-up.*/
+static Byte_t     Marks;
+
+static BTPSCONST char *PhaseNames[BOOT_TIME_NUMBER_OF_PHASES] =
+{
+   "Controller",
+   "Stack",
+   "Services",
+   "Advertising"
+};
+
+   /* The following function starts the measurement of a start-up.  The */
+   /* tick count starts at zero when the hardware is configured, so the */
+   /* time stamp of the first start is the time spent since the reset.  */
+void BootTime_Start(void)
+{
+   StartTimeStamp = (DWord_t)HAL_GetTickCount();
+   Marks          = 0;
+
+   if(!Started)
+   {
+      ResetTime = StartTimeStamp;
+      Started   = TRUE;
+   }
+}
+
+   /* The following function marks the end of a start-up phase.         */
+void BootTime_Mark(BootTime_Phase_t Phase)
+{
+   if((unsigned int)Phase < BOOT_TIME_NUMBER_OF_PHASES)
+   {
+      TimeStamps[Phase]  = (DWord_t)HAL_GetTickCount();
+      Marks             |= (Byte_t)(1 << Phase);
+   }
+}
+
+   /* The following function returns the duration of a start-up phase.  */
+   /* A phase starts where the closest preceding completed phase ended. */
+DWord_t BootTime_Get_Phase_Time(BootTime_Phase_t Phase)
+{
+   int     Index;
+   DWord_t ret_val = 0;
+
+   if(((unsigned int)Phase < BOOT_TIME_NUMBER_OF_PHASES) && (Marks & (1 << Phase)))
+   {
+      for(Index = (int)Phase - 1; (Index >= 0) && (!(Marks & (1 << Index))); Index--)
+         ;
+
+      ret_val = TimeStamps[Phase] - ((Index >= 0)?TimeStamps[Index]:StartTimeStamp);
+   }
+
+   return(ret_val);
+}
+
+   /* The following function displays the start-up phase durations.     */
+void BootTime_Display(void)
+{
+   unsigned int Phase;
+
+   Display(("Boot: Reset->Start %lums\r\n", (unsigned long)ResetTime));
+
+   for(Phase = 0; Phase < BOOT_TIME_NUMBER_OF_PHASES; Phase++)
+   {
+      if(Marks & (1 << Phase))
+         Display(("Boot: %-11s %lums\r\n", PhaseNames[Phase], (unsigned long)BootTime_Get_Phase_Time((BootTime_Phase_t)Phase)));
+      else
+         Display(("Boot: %-11s not completed\r\n", PhaseNames[Phase]));
+   }
+
+   if(Marks & (1 << bpAdvertising))
+      Display(("Boot: Start->Advertising %lums\r\n", (unsigned long)(TimeStamps[bpAdvertising] - StartTimeStamp)));
+}
@@ -0,0 +1,48 @@
+/*****< boottime.h >***********************************************************/
+/*                                                                            */
+/*  BOOTTIME - Boot-to-advertising time measurement.                          */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __BOOTTIME_H__
+#define __BOOTTIME_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following enumerates the phases of the application start-up   */
+   /* that are measured.  Every phase ends with the mark of the same    */
+   /* name (see BootTime_Mark()), the first phase starts with           */
+   /* BootTime_Start() and every other phase starts where the previous  */
+   /* phase ended.                                                      */
+typedef enum
+{
+   bpController,
+   bpStack,
+   bpServices,
+   bpAdvertising
+} BootTime_Phase_t;
+
+#define BOOT_TIME_NUMBER_OF_PHASES                       (4)
+
+   /* The following function starts the measurement of an application   */
+   /* start-up.  This function is called every time the application is  */
+   /* (re)started, the time since the reset is retained from the first  */
+   /* call.                                                             */
+void BootTime_Start(void);
+
+   /* The following function marks the end of the specified start-up    */
+   /* phase.  Phases that are not marked (because the start-up failed)  */
+   /* are reported as not completed.                                    */
+void BootTime_Mark(BootTime_Phase_t Phase);
+
+   /* The following function returns the duration (in milliseconds) of  */
+   /* the specified start-up phase, or zero if the phase has not        */
+   /* completed.                                                        */
+DWord_t BootTime_Get_Phase_Time(BootTime_Phase_t Phase);
+
+   /* The following function displays the duration of every start-up    */
+   /* phase, the total time from the start of the application to        */
+   /* advertising and the time from the reset to the first start on the */
+   /* debug console.                                                    */
+void BootTime_Display(void);
+
+#endif
@@ -0,0 +1,209 @@
+/*****< config.c >*************************************************************/
+/*                                                                            */
+/*  CONFIG - Runtime configuration retained in INFO flash.                    */
+/*                                                                            */
+/******************************************************************************/
+#include "HAL.h"                 /* Function for Hardware Abstraction.        */
+#include "Config.h"              /* Configuration Prototypes/Constants.       */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+#define Display(_x)                                do { BTPS_OutputMessage _x; } while(0)
+
+   /* The following defines the value that marks a valid configuration  */
+   /* record in INFO flash (an erased segment reads as 0xFFFF).         */
+   /* * NOTE * This value MUST be changed whenever the layout of        */
+   /*          Config_t changes, so that a record written by a previous */
+   /*          version is not mistaken for a valid one.                 */
+#define CONFIG_RECORD_SIGNATURE                          (0xC0F1)
+
+   /* The following structure represents the configuration record that  */
+   /* is stored in INFO flash.  The Checksum is the sum of all preceding*/
+   /* words of the record.                                              */
+typedef struct _tagConfig_Record_t
+{
+   Word_t   Signature;
+   Config_t Config;
+   Word_t   Checksum;
+} Config_Record_t;
+
+#define CONFIG_RECORD_WORDS                              (sizeof(Config_Record_t) / sizeof(Word_t))
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the compiler*/
+   /* as part of standard C/C++).                                       */
+
+static Config_t  Config;                            /* Configuration in       */
+                                                    /* effect.                */
+
+static Boolean_t Dirty;                             /* Configuration changed  */
+                                                    /* since it was written.  */
+
+   /* The configuration record lives in INFO D (see the linker command  */
+   /* file), it is only ever written through the flash controller by    */
+   /* WriteRecord().                                                    */
+   /* * NOTE * The INFO segments must be excluded from the erase that is*/
+   /*          done when the device is programmed, otherwise the        */
+   /*          configuration is lost on every firmware update.          */
+#pragma DATA_SECTION(ConfigRecord, ".infoD")
+static volatile BTPSCONST Config_Record_t ConfigRecord;
+
+static BTPSCONST Config_t DefaultConfig =
+{
+   CONFIG_DEFAULT_BUTTON_POLL_PERIOD,
+   CONFIG_DEFAULT_ADVERTISING_INTERVAL_MIN,
+   CONFIG_DEFAULT_ADVERTISING_INTERVAL_MAX,
+   CONFIG_DEFAULT_HCILL_TIMEOUT_MIN,
+   CONFIG_DEFAULT_HCILL_TIMEOUT_MAX,
+   CONFIG_DEFAULT_BUTTON_MASK,
+   CONFIG_DEFAULT_JOURNAL_BATCH_SIZE
+};
+
+   /* Internal Function Prototypes.                                     */
+static Word_t CalculateChecksum(volatile BTPSCONST Word_t *Words);
+static void WriteRecord(Config_Record_t *Record);
+
+   /* The following function calculates the checksum of the specified   */
+   /* configuration record (given as an array of words).                */
+static Word_t CalculateChecksum(volatile BTPSCONST Word_t *Words)
+{
+   Word_t       ret_val;
+   unsigned int Index;
+
+   for(Index = 0, ret_val = 0; Index < (CONFIG_RECORD_WORDS - 1); Index++)
+      ret_val += Words[Index];
+
+   return(ret_val);
+}
+
+   /* The following function erases the INFO flash segment that holds   */
+   /* the configuration record and writes the specified record into it. */
+   /* * NOTE * Interrupts are left enabled.  This code runs from flash, */
+   /*          so the flash controller holds the CPU (and defers        */
+   /*          interrupts) only for the duration of the segment erase   */
+   /*          and of every single word write, pending interrupts are   */
+   /*          serviced in between.  No interrupt handler may write to  */
+   /*          flash.                                                   */
+static void WriteRecord(Config_Record_t *Record)
+{
+   unsigned int     Index;
+   volatile Word_t *Destination;
+
+   Destination = (volatile Word_t *)&ConfigRecord;
+
+   /* Unlock the flash and erase the segment (by a dummy write).        */
+   FCTL3 = FWKEY;
+   FCTL1 = FWKEY + ERASE;
+   *Destination = 0;
+
+   /* Write the record one word at a time.                              */
+   FCTL1 = FWKEY + WRT;
+
+   for(Index = 0; Index < CONFIG_RECORD_WORDS; Index++)
+      Destination[Index] = ((Word_t *)Record)[Index];
+
+   /* Lock the flash again.                                             */
+   FCTL1 = FWKEY;
+   FCTL3 = FWKEY + LOCK;
+}
+
+   /* The following function loads the configuration that is stored in  */
+   /* INFO flash.  The default configuration is used if no valid        */
+   /* configuration has been stored.                                    */
+void Config_Initialize(void)
+{
+   Config_t StoredConfig;
+
+   StoredConfig = *((BTPSCONST Config_t *)&(ConfigRecord.Config));
+
+   if((ConfigRecord.Signature == CONFIG_RECORD_SIGNATURE) && (ConfigRecord.Checksum == CalculateChecksum((volatile BTPSCONST Word_t *)&ConfigRecord)) && (Config_Validate(&StoredConfig)))
+      Config = StoredConfig;
+   else
+      Config = DefaultConfig;
+
+   Dirty = FALSE;
+}
+
+   /* The following function returns a pointer to the configuration that*/
+   /* is currently in effect.                                           */
+BTPSCONST Config_t *Config_Get(void)
+{
+   return(&Config);
+}
+
+   /* The following function checks that every parameter of the         */
+   /* specified configuration is within its valid range.  This function */
+   /* returns TRUE if the configuration is valid or FALSE otherwise.    */
+Boolean_t Config_Validate(BTPSCONST Config_t *Config)
+{
+   Boolean_t ret_val;
+
+   if((Config) && (Config->ButtonPollPeriod >= CONFIG_MINIMUM_BUTTON_POLL_PERIOD) && (Config->ButtonPollPeriod <= CONFIG_MAXIMUM_BUTTON_POLL_PERIOD))
+   {
+      if((Config->AdvertisingIntervalMin >= CONFIG_MINIMUM_ADVERTISING_INTERVAL) && (Config->AdvertisingIntervalMin <= Config->AdvertisingIntervalMax) && (Config->AdvertisingIntervalMax <= CONFIG_MAXIMUM_ADVERTISING_INTERVAL))
+      {
+         if((Config->HCILLTimeoutMin >= CONFIG_MINIMUM_HCILL_TIMEOUT) && (Config->HCILLTimeoutMin <= Config->HCILLTimeoutMax) && (Config->HCILLTimeoutMax <= CONFIG_MAXIMUM_HCILL_TIMEOUT))
+            ret_val = (Boolean_t)(Config->ButtonMask != 0);
+         else
+            ret_val = FALSE;
+      }
+      else
+         ret_val = FALSE;
+   }
+   else
+      ret_val = FALSE;
+
+   return(ret_val);
+}
+
+   /* The following function makes the specified configuration the one  */
+   /* that is in effect (if it is valid) and marks it to be written to  */
+   /* INFO flash on the next call to Config_Flush().  This function     */
+   /* returns TRUE if the configuration was accepted or FALSE if it is  */
+   /* invalid.                                                          */
+Boolean_t Config_Set(BTPSCONST Config_t *NewConfig)
+{
+   Boolean_t ret_val;
+
+   if(Config_Validate(NewConfig))
+   {
+      /* Only flag the configuration to be written if it changed.       */
+      if(BTPS_MemCompare(&Config, NewConfig, CONFIG_DATA_SIZE))
+      {
+         Config = *NewConfig;
+         Dirty  = TRUE;
+      }
+
+      ret_val = TRUE;
+   }
+   else
+      ret_val = FALSE;
+
+   return(ret_val);
+}
+
+   /* The following function writes the configuration to INFO flash if  */
+   /* it has changed since it was last written.  This function returns  */
+   /* TRUE if the flash was written.                                    */
+Boolean_t Config_Flush(void)
+{
+   Boolean_t       ret_val;
+   Config_Record_t Record;
+
+   if(Dirty)
+   {
+      Record.Signature = CONFIG_RECORD_SIGNATURE;
+      Record.Config    = Config;
+      Record.Checksum  = CalculateChecksum((Word_t *)&Record);
+
+      WriteRecord(&Record);
+
+      Dirty   = FALSE;
+      ret_val = TRUE;
+
+      Display(("Configuration stored.\r\n"));
+   }
+   else
+      ret_val = FALSE;
+
+   return(ret_val);
+}
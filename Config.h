@@ -0,0 +1,87 @@
+/*****< config.h >*************************************************************/
+/*                                                                            */
+/*  CONFIG - Runtime configuration retained in INFO flash.                    */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __CONFIG_H__
+#define __CONFIG_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following define the default value and the valid range of     */
+   /* every configuration parameter (see Config_t).  All periods,       */
+   /* intervals and timeouts are in milliseconds.                       */
+#define CONFIG_DEFAULT_BUTTON_POLL_PERIOD                (50)
+#define CONFIG_MINIMUM_BUTTON_POLL_PERIOD                (10)
+#define CONFIG_MAXIMUM_BUTTON_POLL_PERIOD                (1000)
+
+#define CONFIG_DEFAULT_ADVERTISING_INTERVAL_MIN          (100)
+#define CONFIG_DEFAULT_ADVERTISING_INTERVAL_MAX          (200)
+#define CONFIG_MINIMUM_ADVERTISING_INTERVAL              (20)
+#define CONFIG_MAXIMUM_ADVERTISING_INTERVAL              (10240)
+
+#define CONFIG_DEFAULT_HCILL_TIMEOUT_MIN                 (100)
+#define CONFIG_DEFAULT_HCILL_TIMEOUT_MAX                 (2000)
+#define CONFIG_MINIMUM_HCILL_TIMEOUT                     (10)
+#define CONFIG_MAXIMUM_HCILL_TIMEOUT                     (10000)
+
+#define CONFIG_DEFAULT_BUTTON_MASK                       (0x0F)
+
+#define CONFIG_DEFAULT_JOURNAL_BATCH_SIZE                (0)
+
+   /* The following structure holds the runtime configuration.          */
+   /* ButtonPollPeriod is the period at which the button inputs are     */
+   /* polled, AdvertisingIntervalMin/Max are the (undirected) LE        */
+   /* Advertising Interval and HCILLTimeoutMin/Max bound the adaptive   */
+   /* HCILL inactivity timeout.  ButtonMask selects the Port 2 pins that*/
+   /* are used as button inputs and JournalBatchSize is the maximum     */
+   /* number of records per Offline Journal notification (zero means as */
+   /* many as fit in the MTU).                                          */
+typedef struct _tagConfig_t
+{
+   Word_t ButtonPollPeriod;
+   Word_t AdvertisingIntervalMin;
+   Word_t AdvertisingIntervalMax;
+   Word_t HCILLTimeoutMin;
+   Word_t HCILLTimeoutMax;
+   Byte_t ButtonMask;
+   Byte_t JournalBatchSize;
+} Config_t;
+
+#define CONFIG_DATA_SIZE                                 (sizeof(Config_t))
+
+   /* The following function loads the configuration that is stored in  */
+   /* INFO flash.  The default configuration is used if no valid        */
+   /* configuration has been stored.  This function must be called      */
+   /* before any other function of this module.                         */
+void Config_Initialize(void);
+
+   /* The following function returns a pointer to the configuration that*/
+   /* is currently in effect.  The configuration may change whenever    */
+   /* Config_Set() is called, so users that need to react to changes    */
+   /* should compare against the value they applied last.               */
+BTPSCONST Config_t *Config_Get(void);
+
+   /* The following function checks that every parameter of the         */
+   /* specified configuration is within its valid range.  This function */
+   /* returns TRUE if the configuration is valid or FALSE otherwise.    */
+Boolean_t Config_Validate(BTPSCONST Config_t *Config);
+
+   /* The following function makes the specified configuration the one  */
+   /* that is in effect.  The configuration is validated first and is   */
+   /* written to INFO flash on the next call to Config_Flush().  This   */
+   /* function returns TRUE if the configuration was accepted or FALSE  */
+   /* if it is invalid.                                                 */
+Boolean_t Config_Set(BTPSCONST Config_t *NewConfig);
+
+   /* The following function writes the configuration to INFO flash if  */
+   /* it has changed since it was last written.  This function returns  */
+   /* TRUE if the flash was written.                                    */
+   /* * NOTE * Erasing the INFO flash segment stalls the CPU for up to  */
+   /*          32 ms (interrupts that occur meanwhile are serviced once */
+   /*          the erase completes), so this function should only be    */
+   /*          called when no HCI traffic is expected (i.e. with the    */
+   /*          controller in HCILL Sleep).                              */
+Boolean_t Config_Flush(void);
+
+#endif
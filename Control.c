@@ -0,0 +1,153 @@
+/*****< control.c >************************************************************/
+/*                                                                            */
+/*  CONTROL - Remote control of the LEDs and output pins.                     */
+/*                                                                            */
+/******************************************************************************/
+#include "HAL.h"                 /* Function for Hardware Abstraction.        */
+#include "Control.h"             /* Control Prototypes/Constants.             */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+   /* The following MACROs are used to name the registers of a port     */
+   /* (e.g.  CONTROL_REGISTER(P1, OUT) is P1OUT).  The extra level of   */
+   /* indirection expands a port that is itself a MACRO first.          */
+#define CONTROL_REGISTER(_Port, _Register)         CONTROL_REGISTER_(_Port, _Register)
+#define CONTROL_REGISTER_(_Port, _Register)        _Port##_Register
+
+   /* The following structure holds the blink state of a single LED.  A */
+   /* Period of zero means the LED is not blinking, otherwise NextToggle*/
+   /* is the System Tick Count at which the LED is toggled next.        */
+typedef struct _tagBlink_Info_t
+{
+   Word_t  Period;
+   DWord_t NextToggle;
+} Blink_Info_t;
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the compiler*/
+   /* as part of standard C/C++).                                       */
+
+static Blink_Info_t BlinkInfo[CONTROL_NUMBER_OF_LEDS];
+                                                    /* Blink state of every   */
+                                                    /* LED.                   */
+
+static Boolean_t    Blinking;                       /* TRUE if any LED is     */
+                                                    /* blinking.              */
+
+   /* The following function configures the output pins and resets them */
+   /* and the LEDs.                                                     */
+void Control_Initialize(void)
+{
+#if CONTROL_OUTPUT_MASK
+
+   CONTROL_REGISTER(CONTROL_OUTPUT_PORT, OUT) &= (Byte_t)~(CONTROL_OUTPUT_MASK);
+   CONTROL_REGISTER(CONTROL_OUTPUT_PORT, DIR) |= (CONTROL_OUTPUT_MASK);
+
+#endif
+
+   Control_Reset();
+}
+
+   /* The following function stops all blinking, turns the controlled   */
+   /* LEDs off and drives the output pins low.                          */
+void Control_Reset(void)
+{
+   Byte_t LED;
+
+   for(LED = CONTROL_FIRST_LED; LED < CONTROL_NUMBER_OF_LEDS; LED++)
+   {
+      BlinkInfo[LED].Period = 0;
+
+      HAL_SetLED(LED, 0);
+   }
+
+   Blinking = FALSE;
+
+   Control_Write_Outputs((CONTROL_OUTPUT_MASK), 0);
+}
+
+   /* The following function turns the specified LED on or off.         */
+Boolean_t Control_Set_LED(Byte_t LED, Boolean_t On)
+{
+   Boolean_t ret_val;
+
+   if((LED >= CONTROL_FIRST_LED) && (LED < CONTROL_NUMBER_OF_LEDS))
+   {
+      BlinkInfo[LED].Period = 0;
+
+      HAL_SetLED(LED, (On)?1:0);
+
+      ret_val = TRUE;
+   }
+   else
+      ret_val = FALSE;
+
+   return(ret_val);
+}
+
+   /* The following function starts (or stops) blinking the specified   */
+   /* LED.                                                              */
+Boolean_t Control_Blink_LED(Byte_t LED, Word_t Period)
+{
+   Boolean_t ret_val;
+
+   if((LED >= CONTROL_FIRST_LED) && (LED < CONTROL_NUMBER_OF_LEDS))
+   {
+      BlinkInfo[LED].Period = Period;
+
+      if(Period)
+      {
+         /* Turn the LED on right away, the first toggle is one period  */
+         /* from now.                                                   */
+         BlinkInfo[LED].NextToggle = (DWord_t)HAL_GetTickCount() + Period;
+
+         Blinking = TRUE;
+      }
+
+      HAL_SetLED(LED, (Period)?1:0);
+
+      ret_val = TRUE;
+   }
+   else
+      ret_val = FALSE;
+
+   return(ret_val);
+}
+
+   /* The following function drives the specified output pins.          */
+void Control_Write_Outputs(Byte_t Mask, Byte_t Value)
+{
+#if CONTROL_OUTPUT_MASK
+
+   Mask &= (CONTROL_OUTPUT_MASK);
+
+   CONTROL_REGISTER(CONTROL_OUTPUT_PORT, OUT) = (Byte_t)((CONTROL_REGISTER(CONTROL_OUTPUT_PORT, OUT) & ~Mask) | (Value & Mask));
+
+#endif
+}
+
+   /* The following function advances the blinking LEDs.                */
+void Control_Process(DWord_t TimeStamp)
+{
+   Byte_t LED;
+
+   /* Nothing to do unless an LED has been blinking since the last call.*/
+   if(Blinking)
+   {
+      Blinking = FALSE;
+
+      for(LED = CONTROL_FIRST_LED; LED < CONTROL_NUMBER_OF_LEDS; LED++)
+      {
+         if(BlinkInfo[LED].Period)
+         {
+            if((long)(TimeStamp - BlinkInfo[LED].NextToggle) >= 0)
+            {
+               HAL_LedToggle(LED);
+
+               BlinkInfo[LED].NextToggle = TimeStamp + BlinkInfo[LED].Period;
+            }
+
+            Blinking = TRUE;
+         }
+      }
+   }
+}
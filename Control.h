@@ -0,0 +1,67 @@
+/*****< control.h >************************************************************/
+/*                                                                            */
+/*  CONTROL - Remote control of the LEDs and output pins.                     */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __CONTROL_H__
+#define __CONTROL_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following defines the number of LEDs (see HAL_SetLED()) that  */
+   /* may be controlled.                                                */
+#ifndef CONTROL_NUMBER_OF_LEDS
+#define CONTROL_NUMBER_OF_LEDS                           (2)
+#endif
+
+   /* The following defines the first LED that may be controlled.  The  */
+   /* LEDs below it are owned by the application (LED 0 shows the       */
+   /* connection state).                                                */
+#ifndef CONTROL_FIRST_LED
+#define CONTROL_FIRST_LED                                (1)
+#endif
+
+   /* The following may be defined (project wide) to select the output  */
+   /* pins that may be controlled.  The pins in CONTROL_OUTPUT_MASK of  */
+   /* CONTROL_OUTPUT_PORT are configured as outputs (driven low) at     */
+   /* start-up.  A mask of zero (the default) disables the outputs.     */
+#ifndef CONTROL_OUTPUT_MASK
+#define CONTROL_OUTPUT_MASK                              (0)
+#endif
+
+#ifndef CONTROL_OUTPUT_PORT
+#define CONTROL_OUTPUT_PORT                              P1
+#endif
+
+   /* The following function configures the output pins and resets them */
+   /* and the LEDs (see Control_Reset()).                               */
+void Control_Initialize(void);
+
+   /* The following function stops all blinking, turns all controlled   */
+   /* LEDs off and drives all output pins low.                          */
+void Control_Reset(void);
+
+   /* The following function turns the specified LED on or off (and     */
+   /* stops it from blinking).  This function returns TRUE if the LED   */
+   /* may be controlled or FALSE otherwise.                             */
+Boolean_t Control_Set_LED(Byte_t LED, Boolean_t On);
+
+   /* The following function starts blinking the specified LED, the LED */
+   /* is toggled every Period milliseconds.  A period of zero stops the */
+   /* blinking and turns the LED off.  This function returns TRUE if the*/
+   /* LED may be controlled or FALSE otherwise.                         */
+   /* * NOTE * The blinking is driven by Control_Process(), so the      */
+   /*          period is rounded up to the interval at which that       */
+   /*          function is called.                                      */
+Boolean_t Control_Blink_LED(Byte_t LED, Word_t Period);
+
+   /* The following function drives the output pins in the specified    */
+   /* mask to the corresponding bits of the specified value.  Pins      */
+   /* outside of CONTROL_OUTPUT_MASK are left unchanged.                */
+void Control_Write_Outputs(Byte_t Mask, Byte_t Value);
+
+   /* The following function advances the blinking LEDs.  The parameter */
+   /* is the current System Tick Count.                                 */
+void Control_Process(DWord_t TimeStamp);
+
+#endif
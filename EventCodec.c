@@ -0,0 +1,164 @@
+/*****< eventcodec.c >*********************************************************/
+/*                                                                            */
+/*  EVENTCODEC - Compact encoding of Event Log button transitions.            */
+/*                                                                            */
+/******************************************************************************/
+#include "EventCodec.h"          /* Event Codec Prototypes/Constants.         */
+#include "EventLog.h"            /* Event Log Prototypes/Constants.           */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+   /* Internal Function Prototypes.                                     */
+static Word_t WriteToken(Byte_t *Buffer, Byte_t Kind, DWord_t Value);
+static Word_t WriteInteger(Byte_t *Buffer, DWord_t Value);
+static Word_t ExpectedState(Event_Codec_t *Codec);
+static void Advance(Event_Codec_t *Codec, Event_Log_Entry_t *Entry, Byte_t Kind);
+
+   /* The following function writes a token header (the kind in the two */
+   /* least significant bits followed by the value) as a variable length*/
+   /* integer.  This function returns the number of bytes written (at   */
+   /* most five).                                                       */
+static Word_t WriteToken(Byte_t *Buffer, Byte_t Kind, DWord_t Value)
+{
+   Word_t Length = 0;
+   Byte_t Byte;
+
+   Byte    = (Byte_t)(((Value & 0x1F) << 2) | Kind);
+   Value >>= 5;
+
+   while(Value)
+   {
+      Buffer[Length++] = (Byte_t)(Byte | 0x80);
+      Byte             = (Byte_t)(Value & 0x7F);
+      Value          >>= 7;
+   }
+
+   Buffer[Length++] = Byte;
+
+   return(Length);
+}
+
+   /* The following function writes the specified value as a variable   */
+   /* length integer.  This function returns the number of bytes        */
+   /* written.                                                          */
+static Word_t WriteInteger(Byte_t *Buffer, DWord_t Value)
+{
+   Word_t Length = 0;
+
+   while(Value > 0x7F)
+   {
+      Buffer[Length++] = (Byte_t)((Value & 0x7F) | 0x80);
+      Value          >>= 7;
+   }
+
+   Buffer[Length++] = (Byte_t)Value;
+
+   return(Length);
+}
+
+   /* The following function returns the state that a repeat of the     */
+   /* previous transition leads to:  the state before the previous      */
+   /* transition if it toggled, otherwise the same state again.         */
+static Word_t ExpectedState(Event_Codec_t *Codec)
+{
+   return((Codec->Kind == EVENT_CODEC_TOKEN_TOGGLE)?Codec->States[1]:Codec->States[0]);
+}
+
+   /* The following function advances the encoder past the specified    */
+   /* transition, which was encoded as the specified kind.              */
+static void Advance(Event_Codec_t *Codec, Event_Log_Entry_t *Entry, Byte_t Kind)
+{
+   Codec->Delta     = Entry->TimeStamp - Codec->TimeStamp;
+   Codec->TimeStamp = Entry->TimeStamp;
+   Codec->States[1] = Codec->States[0];
+   Codec->States[0] = Entry->State;
+   Codec->Kind      = Kind;
+
+   if(Codec->Count < 2)
+      Codec->Count++;
+
+   Codec->Sequence++;
+}
+
+   /* The following function initializes an encoder.                    */
+void EventCodec_Initialize(Event_Codec_t *Codec, DWord_t Sequence, DWord_t BaseTimeStamp)
+{
+   if(Codec)
+   {
+      BTPS_MemInitialize(Codec, 0, EVENT_CODEC_DATA_SIZE);
+
+      Codec->Sequence  = Sequence;
+      Codec->TimeStamp = BaseTimeStamp;
+   }
+}
+
+   /* The following function encodes the next token.  A run is only used*/
+   /* for two or more repeated transitions, a single repeat is encoded  */
+   /* as an ordinary transition (which is no longer).                   */
+Word_t EventCodec_Encode(Event_Codec_t *Codec, DWord_t End, Byte_t *Buffer)
+{
+   Word_t            ret_val = 0;
+   Byte_t            Kind;
+   DWord_t           Run;
+   Event_Codec_t     Next;
+   Event_Log_Entry_t Entry;
+
+   if((Codec) && (Buffer) && (Codec->Sequence < End) && (EventLog_Get(Codec->Sequence, &Entry)))
+   {
+      /* Count the transitions that repeat the previous transition.     */
+      Next = *Codec;
+      Run  = 0;
+
+      while((Next.Count) && ((Entry.TimeStamp - Next.TimeStamp) == Next.Delta) && (Entry.State == ExpectedState(&Next)))
+      {
+         Advance(&Next, &Entry, Next.Kind);
+         Run++;
+
+         if((Next.Sequence >= End) || (!EventLog_Get(Next.Sequence, &Entry)))
+            break;
+      }
+
+      if(Run >= 2)
+      {
+         ret_val = WriteToken(Buffer, EVENT_CODEC_TOKEN_RUN, Run);
+
+         *Codec  = Next;
+      }
+      else
+      {
+         EventLog_Get(Codec->Sequence, &Entry);
+
+         /* A transition back to the state before the previous          */
+         /* transition does not need to carry the state.                */
+         if((Codec->Count >= 2) && (Entry.State == Codec->States[1]))
+         {
+            Kind    = EVENT_CODEC_TOKEN_TOGGLE;
+            ret_val = WriteToken(Buffer, Kind, (Entry.TimeStamp - Codec->TimeStamp));
+         }
+         else
+         {
+            Kind     = EVENT_CODEC_TOKEN_STATE;
+            ret_val  = WriteToken(Buffer, Kind, (Entry.TimeStamp - Codec->TimeStamp));
+            ret_val += WriteInteger(&(Buffer[ret_val]), Entry.State);
+         }
+
+         Advance(Codec, &Entry, Kind);
+      }
+   }
+
+   return(ret_val);
+}
+
+   /* The following function returns the length of a state token.  A    */
+   /* toggle token is never longer and a run token (at most two bytes   */
+   /* for the transitions the Event Log holds) covers at least two      */
+   /* transitions of at least two bytes each.                           */
+Word_t EventCodec_Transition_Length(DWord_t Delta, Word_t State)
+{
+   Byte_t Buffer[EVENT_CODEC_MAXIMUM_TOKEN_LENGTH];
+   Word_t ret_val;
+
+   ret_val  = WriteToken(Buffer, EVENT_CODEC_TOKEN_STATE, Delta);
+   ret_val += WriteInteger(&(Buffer[ret_val]), State);
+
+   return(ret_val);
+}
@@ -0,0 +1,78 @@
+/*****< eventcodec.h >*********************************************************/
+/*                                                                            */
+/*  EVENTCODEC - Compact encoding of Event Log button transitions.            */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __EVENTCODEC_H__
+#define __EVENTCODEC_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following define the kinds of tokens that the Event Log       */
+   /* transitions are encoded into.  Every token starts with a variable */
+   /* length integer (7 bits per byte, least significant bits first, bit*/
+   /* 7 set in every byte but the last) that holds the token kind in its*/
+   /* two least significant bits and the token value in the remaining   */
+   /* bits.                                                             */
+   /* EVENT_CODEC_TOKEN_STATE - one transition, the value is the time   */
+   /* (in milliseconds) since the previous transition and is followed by*/
+   /* the new state (variable length integer).                          */
+   /* EVENT_CODEC_TOKEN_TOGGLE - one transition, the value is the time  */
+   /* since the previous transition and the new state is the state      */
+   /* before the previous transition (i.e.  a button press followed by  */
+   /* its release).                                                     */
+   /* EVENT_CODEC_TOKEN_RUN - the value is the number of transitions    */
+   /* that repeat the previous transition, each after the same time and */
+   /* each either toggling again or keeping the same state (as the      */
+   /* previous transition did).                                         */
+#define EVENT_CODEC_TOKEN_STATE                          0
+#define EVENT_CODEC_TOKEN_TOGGLE                         1
+#define EVENT_CODEC_TOKEN_RUN                            2
+
+   /* The following defines the maximum number of bytes that a single   */
+   /* call to EventCodec_Encode() produces (a 32 bit time plus a 16 bit */
+   /* state).                                                           */
+#define EVENT_CODEC_MAXIMUM_TOKEN_LENGTH                 (8)
+
+   /* The following structure holds the state of the encoder, it is     */
+   /* initialized with EventCodec_Initialize().  The Sequence member is */
+   /* the sequence number of the next transition that will be encoded.  */
+typedef struct _tagEvent_Codec_t
+{
+   DWord_t Sequence;
+   DWord_t TimeStamp;
+   DWord_t Delta;
+   Word_t  States[2];
+   Byte_t  Count;
+   Byte_t  Kind;
+} Event_Codec_t;
+
+#define EVENT_CODEC_DATA_SIZE                            (sizeof(Event_Codec_t))
+
+   /* The following function initializes the specified encoder.  The    */
+   /* second parameter is the sequence number of the first transition to*/
+   /* encode and the third parameter is the time stamp that the time of */
+   /* the first transition is encoded relative to.                      */
+void EventCodec_Initialize(Event_Codec_t *Codec, DWord_t Sequence, DWord_t BaseTimeStamp);
+
+   /* The following function encodes the next token into the specified  */
+   /* buffer (which must hold at least EVENT_CODEC_MAXIMUM_TOKEN_LENGTH */
+   /* bytes).  A token covers one or more transitions from the Event    */
+   /* Log, but never the transition with the specified End sequence     */
+   /* number (or any later transition).  This function returns the      */
+   /* length of the token, or zero if there is nothing left to encode or*/
+   /* if the next transition has been overwritten in the Event Log.     */
+   /* * NOTE * The encoder is only advanced if a token is returned.  To */
+   /*          encode into a limited buffer encode into a copy of the   */
+   /*          encoder and only keep the copy (and the token) if the    */
+   /*          token fits.                                              */
+Word_t EventCodec_Encode(Event_Codec_t *Codec, DWord_t End, Byte_t *Buffer);
+
+   /* The following function returns the length of a state token for a  */
+   /* transition with the specified time since the previous transition  */
+   /* and the specified new state.  No token spends more bytes on a     */
+   /* single transition, so the sum over a range of transitions bounds  */
+   /* the length of their encoding.                                     */
+Word_t EventCodec_Transition_Length(DWord_t Delta, Word_t State);
+
+#endif
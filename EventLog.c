@@ -0,0 +1,64 @@
+/*****< eventlog.c >***********************************************************/
+/*                                                                            */
+/*  EVENTLOG - Retained ring of timestamped button transitions.               */
+/*                                                                            */
+/******************************************************************************/
+#include "EventLog.h"            /* Event Log Prototypes/Constants.           */
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the compiler*/
+   /* as part of standard C/C++).                                       */
+   /* * NOTE * The Event Log lives in .bss (and NOT in the Bluetopia    */
+   /*          memory pool) so that it is retained if the Bluetooth     */
+   /*          Stack is closed and re-opened.                           */
+
+static Event_Log_Entry_t EventLog[EVENT_LOG_SIZE];  /* Holds the recorded     */
+                                                    /* transitions.           */
+
+static DWord_t           NextSequence;              /* Sequence number of the */
+                                                    /* next transition.       */
+
+   /* The following function records a button transition in the Event  */
+   /* Log.                                                              */
+DWord_t EventLog_Add(DWord_t TimeStamp, Word_t State)
+{
+   Event_Log_Entry_t *Entry;
+
+   Entry            = &(EventLog[NextSequence & (EVENT_LOG_SIZE - 1)]);
+   Entry->TimeStamp = TimeStamp;
+   Entry->State     = State;
+
+   return(NextSequence++);
+}
+
+   /* The following function returns the sequence number of the oldest */
+   /* transition that is still retained in the Event Log.               */
+DWord_t EventLog_Oldest_Sequence(void)
+{
+   return((NextSequence > EVENT_LOG_SIZE)?(NextSequence - EVENT_LOG_SIZE):0);
+}
+
+   /* The following function returns the sequence number that will be  */
+   /* assigned to the next recorded transition.                         */
+DWord_t EventLog_Next_Sequence(void)
+{
+   return(NextSequence);
+}
+
+   /* The following function retrieves the transition with the         */
+   /* specified sequence number.                                        */
+Boolean_t EventLog_Get(DWord_t Sequence, Event_Log_Entry_t *Entry)
+{
+   Boolean_t ret_val;
+
+   if((Entry) && (Sequence >= EventLog_Oldest_Sequence()) && (Sequence < NextSequence))
+   {
+      *Entry  = EventLog[Sequence & (EVENT_LOG_SIZE - 1)];
+
+      ret_val = TRUE;
+   }
+   else
+      ret_val = FALSE;
+
+   return(ret_val);
+}
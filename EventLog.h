@@ -0,0 +1,53 @@
+/*****< eventlog.h >***********************************************************/
+/*                                                                            */
+/*  EVENTLOG - Retained ring of timestamped button transitions.               */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __EVENTLOG_H__
+#define __EVENTLOG_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following defines the number of button transitions that are   */
+   /* retained in the Event Log.  Once the log is full the oldest       */
+   /* transition is overwritten.                                        */
+   /* * NOTE * This value MUST be a power of two.                       */
+#define EVENT_LOG_SIZE                                   (64)
+
+   /* The following structure represents a single button transition that*/
+   /* has been recorded in the Event Log.  The TimeStamp is the System  */
+   /* Tick Count (in milliseconds) at which the transition was detected */
+   /* and State is the button state after the transition.               */
+typedef struct _tagEvent_Log_Entry_t
+{
+   DWord_t TimeStamp;
+   Word_t  State;
+} Event_Log_Entry_t;
+
+#define EVENT_LOG_ENTRY_DATA_SIZE                        (sizeof(Event_Log_Entry_t))
+
+   /* The following function records a button transition in the Event   */
+   /* Log.  The first parameter is the System Tick Count at which the   */
+   /* transition was detected and the second is the new button state.   */
+   /* This function returns the sequence number assigned to the         */
+   /* transition.  Sequence numbers start at zero and increase by one   */
+   /* for every recorded transition.                                    */
+DWord_t EventLog_Add(DWord_t TimeStamp, Word_t State);
+
+   /* The following function returns the sequence number of the oldest  */
+   /* transition that is still retained in the Event Log.               */
+DWord_t EventLog_Oldest_Sequence(void);
+
+   /* The following function returns the sequence number that will be   */
+   /* assigned to the next recorded transition (i.e.  one past the      */
+   /* newest transition in the Event Log).                              */
+DWord_t EventLog_Next_Sequence(void);
+
+   /* The following function retrieves the transition with the specified*/
+   /* sequence number.  This function returns TRUE if the transition is */
+   /* still retained in the Event Log (and copies it into the specified */
+   /* entry) or FALSE if it has not yet been recorded or has been       */
+   /* overwritten.                                                      */
+Boolean_t EventLog_Get(DWord_t Sequence, Event_Log_Entry_t *Entry);
+
+#endif
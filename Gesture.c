@@ -0,0 +1,160 @@
+/*****< gesture.c >************************************************************/
+/*                                                                            */
+/*  GESTURE - Button gesture (click, double-click, long-press) recognition.   */
+/*                                                                            */
+/******************************************************************************/
+#include "Gesture.h"             /* Gesture Prototypes/Constants.             */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+   /* The following enumerates the states of the gesture recognition of */
+   /* a single button.                                                  */
+typedef enum
+{
+   gsIdle,
+   gsPressed,
+   gsReleased,
+   gsPressedAgain,
+   gsLongPressed
+} Gesture_State_t;
+
+   /* The following structure holds the gesture recognition state of a  */
+   /* single button.  PressTime and ReleaseTime are the times of the    */
+   /* first press and release of the gesture in progress and AgainTime  */
+   /* is the time of the second press (of a double-click).              */
+typedef struct _tagButton_Info_t
+{
+   Byte_t  State;
+   DWord_t PressTime;
+   DWord_t ReleaseTime;
+   DWord_t AgainTime;
+} Button_Info_t;
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the compiler*/
+   /* as part of standard C/C++).                                       */
+
+static Button_Info_t ButtonInfo[GESTURE_NUMBER_OF_BUTTONS];
+                                                    /* Recognition state of   */
+                                                    /* every button.          */
+
+   /* Internal Function Prototypes.                                     */
+static void Report(Byte_t Button, Gesture_Type_t Gesture, DWord_t TimeStamp, DWord_t EndTime, Gesture_Callback_t Callback);
+
+   /* The following function reports a recognized gesture to the        */
+   /* specified callback.                                               */
+static void Report(Byte_t Button, Gesture_Type_t Gesture, DWord_t TimeStamp, DWord_t EndTime, Gesture_Callback_t Callback)
+{
+   Gesture_Event_t Event;
+
+   if(Callback)
+   {
+      Event.Button    = Button;
+      Event.Gesture   = (Byte_t)Gesture;
+      Event.Duration  = (Word_t)(((EndTime - TimeStamp) > 0xFFFF)?0xFFFF:(EndTime - TimeStamp));
+      Event.TimeStamp = TimeStamp;
+
+      (*Callback)(&Event);
+   }
+}
+
+   /* The following function resets the gesture recognition of all      */
+   /* buttons.                                                          */
+void Gesture_Initialize(void)
+{
+   BTPS_MemInitialize(ButtonInfo, 0, sizeof(ButtonInfo));
+}
+
+   /* The following function advances the gesture recognition of every  */
+   /* button.                                                           */
+void Gesture_Process(DWord_t TimeStamp, Byte_t Pressed, Gesture_Callback_t Callback)
+{
+   Byte_t         Button;
+   Boolean_t      Down;
+   Button_Info_t *Info;
+
+   for(Button = 0; Button < GESTURE_NUMBER_OF_BUTTONS; Button++)
+   {
+      Info = &(ButtonInfo[Button]);
+      Down = (Boolean_t)((Pressed & (1 << Button)) != 0);
+
+      switch(Info->State)
+      {
+         case gsIdle:
+            if(Down)
+            {
+               Info->State     = gsPressed;
+               Info->PressTime = TimeStamp;
+            }
+            break;
+         case gsPressed:
+            if(!Down)
+            {
+               Info->State       = gsReleased;
+               Info->ReleaseTime = TimeStamp;
+            }
+            else
+            {
+               if((TimeStamp - Info->PressTime) >= GESTURE_LONG_PRESS_TIME)
+               {
+                  Report(Button, gtLongPress, Info->PressTime, TimeStamp, Callback);
+
+                  Info->State = gsLongPressed;
+               }
+            }
+            break;
+         case gsReleased:
+            if(Down)
+            {
+               if((TimeStamp - Info->ReleaseTime) < GESTURE_DOUBLE_CLICK_TIME)
+               {
+                  Info->State     = gsPressedAgain;
+                  Info->AgainTime = TimeStamp;
+               }
+               else
+               {
+                  /* The double-click time expired between two polls,   */
+                  /* this press starts a new gesture.                   */
+                  Report(Button, gtClick, Info->PressTime, Info->ReleaseTime, Callback);
+
+                  Info->State     = gsPressed;
+                  Info->PressTime = TimeStamp;
+               }
+            }
+            else
+            {
+               if((TimeStamp - Info->ReleaseTime) >= GESTURE_DOUBLE_CLICK_TIME)
+               {
+                  Report(Button, gtClick, Info->PressTime, Info->ReleaseTime, Callback);
+
+                  Info->State = gsIdle;
+               }
+            }
+            break;
+         case gsPressedAgain:
+            if(!Down)
+            {
+               Report(Button, gtDoubleClick, Info->PressTime, TimeStamp, Callback);
+
+               Info->State = gsIdle;
+            }
+            else
+            {
+               /* A second press that is held is a click followed by a  */
+               /* long-press.                                           */
+               if((TimeStamp - Info->AgainTime) >= GESTURE_LONG_PRESS_TIME)
+               {
+                  Report(Button, gtClick, Info->PressTime, Info->ReleaseTime, Callback);
+                  Report(Button, gtLongPress, Info->AgainTime, TimeStamp, Callback);
+
+                  Info->State = gsLongPressed;
+               }
+            }
+            break;
+         case gsLongPressed:
+         default:
+            if(!Down)
+               Info->State = gsIdle;
+            break;
+      }
+   }
+}
@@ -0,0 +1,70 @@
+/*****< gesture.h >************************************************************/
+/*                                                                            */
+/*  GESTURE - Button gesture (click, double-click, long-press) recognition.   */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __GESTURE_H__
+#define __GESTURE_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following define the timing (in milliseconds) of the          */
+   /* recognized gestures.  A press that is held for at least           */
+   /* GESTURE_LONG_PRESS_TIME is a long-press, a shorter press is a     */
+   /* click unless the button is pressed again within                   */
+   /* GESTURE_DOUBLE_CLICK_TIME of the release, in which case the two   */
+   /* presses are a double-click.                                       */
+   /* * NOTE * A click is only reported once the double-click time has  */
+   /*          expired, the accuracy of all gestures is bounded by the  */
+   /*          button poll period.                                      */
+#define GESTURE_LONG_PRESS_TIME                          (800)
+#define GESTURE_DOUBLE_CLICK_TIME                        (300)
+
+   /* The following defines the number of buttons (i.e. Port 2 pins)    */
+   /* that are tracked.                                                 */
+#define GESTURE_NUMBER_OF_BUTTONS                        (8)
+
+   /* The following enumerates the recognized gestures.  The values are */
+   /* used in the MYLE Gesture characteristic value (see MYLETyp.h).    */
+typedef enum
+{
+   gtClick       = 1,
+   gtDoubleClick = 2,
+   gtLongPress   = 3
+} Gesture_Type_t;
+
+   /* The following structure represents a recognized gesture.  Button  */
+   /* is the Port 2 pin number of the button, TimeStamp is the System   */
+   /* Tick Count at which the (first) press of the gesture was detected */
+   /* and Duration is the time (in milliseconds) from that press to the */
+   /* last release of the gesture (to the moment it was recognized for a*/
+   /* long-press).                                                      */
+typedef struct _tagGesture_Event_t
+{
+   Byte_t  Button;
+   Byte_t  Gesture;
+   Word_t  Duration;
+   DWord_t TimeStamp;
+} Gesture_Event_t;
+
+#define GESTURE_EVENT_DATA_SIZE                          (sizeof(Gesture_Event_t))
+
+   /* The following declared type represents the Prototype Function for */
+   /* the function that is called for every gesture that is recognized  */
+   /* by Gesture_Process().                                             */
+typedef void (*Gesture_Callback_t)(BTPSCONST Gesture_Event_t *Event);
+
+   /* The following function resets the gesture recognition of all      */
+   /* buttons, any gesture in progress is discarded.                    */
+void Gesture_Initialize(void);
+
+   /* The following function advances the gesture recognition.  The     */
+   /* first parameter is the current System Tick Count and the second is*/
+   /* the mask of the buttons that are currently pressed.  The specified*/
+   /* callback is called for every gesture that is recognized.          */
+   /* * NOTE * This function must be called on every button poll (and   */
+   /*          not only when the button state changes), since clicks and*/
+   /*          long-presses are recognized by the passing of time.      */
+void Gesture_Process(DWord_t TimeStamp, Byte_t Pressed, Gesture_Callback_t Callback);
+
+#endif
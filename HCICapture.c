@@ -0,0 +1,172 @@
+/*****< hcicapture.c >*********************************************************/
+/*                                                                            */
+/*  HCICAPTURE - Capture of HCI traffic into a RAM ring (btsnoop format).     */
+/*                                                                            */
+/******************************************************************************/
+#include "HCICapture.h"          /* HCI Capture Prototypes/Constants.         */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+#if HCI_CAPTURE_RECORDS
+
+#define Display(_x)                                do { BTPS_OutputMessage _x; } while(0)
+
+   /* The following define the constants of the btsnoop file format.    */
+   /* The time stamps of the records are in microseconds since midnight */
+   /* January 1st, 0 AD, the System Tick Count is reported relative to  */
+   /* January 1st, 1970.                                                */
+#define BTSNOOP_VERSION                                  (1)
+#define BTSNOOP_DATALINK_TYPE_H4                         (1002)
+
+#define BTSNOOP_FLAGS_RECEIVED                           0x01
+#define BTSNOOP_FLAGS_COMMAND_EVENT                      0x02
+
+#define BTSNOOP_EPOCH_OFFSET                             (0x00DCDDB30F2F8000ULL)
+
+   /* The following defines the number of bytes that are dumped per     */
+   /* line.                                                             */
+#define HCI_CAPTURE_LINE_BYTES                           (32)
+
+   /* The following structure represents a single captured HCI packet.  */
+   /* TimeStamp is the System Tick Count at which the packet was        */
+   /* exchanged, Length is the original length of the packet and Type is*/
+   /* the HCI Packet Type (which is also the H4 packet indicator).      */
+typedef struct _tagHCI_Capture_Record_t
+{
+   DWord_t   TimeStamp;
+   Word_t    Length;
+   Byte_t    Type;
+   Boolean_t Sent;
+   Byte_t    Data[HCI_CAPTURE_SNAP_LENGTH];
+} HCI_Capture_Record_t;
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the compiler*/
+   /* as part of standard C/C++).                                       */
+
+static HCI_Capture_Record_t Records[HCI_CAPTURE_RECORDS];
+static DWord_t              RecordCount;
+
+static char                 Line[(HCI_CAPTURE_LINE_BYTES * 2) + 1];
+static unsigned int         LineLength;
+
+static BTPSCONST char       HexDigits[] = "0123456789ABCDEF";
+
+   /* Internal Function Prototypes.                                     */
+static void DumpBytes(BTPSCONST Byte_t *Data, unsigned int Length);
+static void DumpDWord(DWord_t Value);
+static void FlushLine(void);
+
+   /* The following function dumps the specified bytes (in hexadecimal),*/
+   /* a line is displayed whenever it is full.                          */
+static void DumpBytes(BTPSCONST Byte_t *Data, unsigned int Length)
+{
+   while(Length--)
+   {
+      Line[LineLength++] = HexDigits[(*Data) >> 4];
+      Line[LineLength++] = HexDigits[(*Data) & 0x0F];
+
+      Data++;
+
+      if(LineLength == (HCI_CAPTURE_LINE_BYTES * 2))
+         FlushLine();
+   }
+}
+
+   /* The following function dumps the specified value as a Big-Endian  */
+   /* DWord (as used throughout the btsnoop format).                    */
+static void DumpDWord(DWord_t Value)
+{
+   Byte_t Buffer[DWORD_SIZE];
+
+   ASSIGN_HOST_DWORD_TO_BIG_ENDIAN_UNALIGNED_DWORD(Buffer, Value);
+
+   DumpBytes(Buffer, DWORD_SIZE);
+}
+
+   /* The following function displays the line that is being dumped (if */
+   /* it is not empty).                                                 */
+static void FlushLine(void)
+{
+   if(LineLength)
+   {
+      Line[LineLength] = '\0';
+
+      Display(("%s\r\n", Line));
+
+      LineLength = 0;
+   }
+}
+
+   /* The following function captures an HCI packet.  The packet is     */
+   /* copied (up to HCI_CAPTURE_SNAP_LENGTH bytes) into the capture     */
+   /* ring.                                                             */
+void HCICapture_Packet(Boolean_t PacketSent, HCI_Packet_t *HCIPacket)
+{
+   unsigned int          Length;
+   HCI_Capture_Record_t *Record;
+
+   if(HCIPacket)
+   {
+      Record = &(Records[RecordCount % HCI_CAPTURE_RECORDS]);
+
+      Length = (HCIPacket->HCIPacketLength < HCI_CAPTURE_SNAP_LENGTH)?HCIPacket->HCIPacketLength:HCI_CAPTURE_SNAP_LENGTH;
+
+      Record->TimeStamp = BTPS_GetTickCount();
+      Record->Length    = (Word_t)HCIPacket->HCIPacketLength;
+      Record->Type      = (Byte_t)HCIPacket->HCIPacketType;
+      Record->Sent      = PacketSent;
+
+      BTPS_MemCopy(Record->Data, HCIPacket->HCIPacketData, Length);
+
+      RecordCount++;
+   }
+}
+
+   /* The following function dumps the captured HCI packets.            */
+void HCICapture_Dump(void)
+{
+   DWord_t               Index;
+   DWord_t               Oldest;
+   DWord_t               Included;
+   unsigned long long    TimeStamp;
+   HCI_Capture_Record_t *Record;
+
+   Oldest = (RecordCount > HCI_CAPTURE_RECORDS)?(RecordCount - HCI_CAPTURE_RECORDS):0;
+
+   Display(("HCI Capture: %lu packets, %lu overwritten.\r\n", (unsigned long)(RecordCount - Oldest), (unsigned long)Oldest));
+   Display(("-----BEGIN BTSNOOP-----\r\n"));
+
+   /* File Header: Identification Pattern, Version and Datalink Type.   */
+   DumpBytes((BTPSCONST Byte_t *)"btsnoop", 8);
+   DumpDWord(BTSNOOP_VERSION);
+   DumpDWord(BTSNOOP_DATALINK_TYPE_H4);
+   FlushLine();
+
+   for(Index = Oldest; Index < RecordCount; Index++)
+   {
+      Record   = &(Records[Index % HCI_CAPTURE_RECORDS]);
+      Included = (Record->Length < HCI_CAPTURE_SNAP_LENGTH)?Record->Length:HCI_CAPTURE_SNAP_LENGTH;
+
+      /* Record Header:  Original and Included Length (both including   */
+      /* the H4 packet indicator), Packet Flags, Cumulative Drops and   */
+      /* the 64 bit Time Stamp.                                         */
+      DumpDWord((DWord_t)Record->Length + 1);
+      DumpDWord(Included + 1);
+      DumpDWord((DWord_t)(((Record->Sent)?0:BTSNOOP_FLAGS_RECEIVED) | (((Record->Type == ptHCICommandPacket) || (Record->Type == ptHCIEventPacket))?BTSNOOP_FLAGS_COMMAND_EVENT:0)));
+      DumpDWord(Oldest);
+
+      TimeStamp = BTSNOOP_EPOCH_OFFSET + ((unsigned long long)Record->TimeStamp * 1000);
+
+      DumpDWord((DWord_t)(TimeStamp >> 32));
+      DumpDWord((DWord_t)TimeStamp);
+
+      /* Packet Data: H4 packet indicator followed by the packet.       */
+      DumpBytes(&(Record->Type), BYTE_SIZE);
+      DumpBytes(Record->Data, (unsigned int)Included);
+      FlushLine();
+   }
+
+   Display(("-----END BTSNOOP-----\r\n"));
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*****< hcicapture.h >*********************************************************/
+/*                                                                            */
+/*  HCICAPTURE - Capture of HCI traffic into a RAM ring (btsnoop format).     */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __HCICAPTURE_H__
+#define __HCICAPTURE_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following defines the number of HCI packets that are retained */
+   /* in the capture ring.  Once the ring is full the oldest packet is  */
+   /* overwritten.  A value of zero disables the capture (and removes it*/
+   /* from the build).                                                  */
+   /* * NOTE * This value must be defined for the whole project (i.e.   */
+   /*          on the compiler command line) so that every module agrees*/
+   /*          on whether the capture is present.                       */
+#ifndef HCI_CAPTURE_RECORDS
+#define HCI_CAPTURE_RECORDS                              (0)
+#endif
+
+   /* The following defines the maximum number of bytes of every HCI    */
+   /* packet that are retained.  Longer packets are truncated (the      */
+   /* original length is still recorded).                               */
+#ifndef HCI_CAPTURE_SNAP_LENGTH
+#define HCI_CAPTURE_SNAP_LENGTH                          (32)
+#endif
+
+#if HCI_CAPTURE_RECORDS
+
+   /* The following function captures the specified HCI packet.  It is  */
+   /* called (from the Debug Callback of the Bluetooth Stack) for every */
+   /* HCI packet that is sent to or received from the controller.       */
+void HCICapture_Packet(Boolean_t PacketSent, HCI_Packet_t *HCIPacket);
+
+   /* The following function dumps the captured HCI packets (oldest     */
+   /* first) on the debug console as a btsnoop file (Datalink Type HCI  */
+   /* UART (H4)) in hexadecimal.  The file is enclosed in BEGIN/END     */
+   /* BTSNOOP lines, the lines in between can be converted to the binary*/
+   /* file on the host (e.g.  with xxd -r -p).                          */
+void HCICapture_Dump(void);
+
+#endif
+
+#endif
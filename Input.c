@@ -0,0 +1,170 @@
+/*****< input.c >**************************************************************/
+/*                                                                            */
+/*  INPUT - Multi-port and key matrix input scanning.                         */
+/*                                                                            */
+/******************************************************************************/
+#include "HAL.h"                 /* Function for Hardware Abstraction.        */
+#include "Input.h"               /* Input Prototypes/Constants.               */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+#define INPUT_MATRIX_SETTLE_CYCLES                 (25)  /* Denotes the number*/
+                                                         /* of cycles a column*/
+                                                         /* is given to settle*/
+                                                         /* after its row is  */
+                                                         /* driven low.       */
+
+   /* The following MACROs are used to name the registers of a port     */
+   /* (e.g. INPUT_REGISTER(P3, IN) is P3IN).  The extra level of        */
+   /* indirection expands a port that is itself a MACRO first.          */
+#define INPUT_REGISTER(_Port, _Register)           INPUT_REGISTER_(_Port, _Register)
+#define INPUT_REGISTER_(_Port, _Register)          _Port##_Register
+
+   /* The following MACRO expands an entry of INPUT_PORT_LIST into an   */
+   /* Input_Port_t.                                                     */
+#define INPUT_PORT_ENTRY(_Port, _Mask)             { &INPUT_REGISTER(_Port, IN), &INPUT_REGISTER(_Port, DIR), &INPUT_REGISTER(_Port, REN), &INPUT_REGISTER(_Port, OUT), (_Mask) },
+
+   /* The following structure describes the registers and the input     */
+   /* pins of a port.                                                   */
+typedef struct _tagInput_Port_t
+{
+   volatile unsigned char *In;
+   volatile unsigned char *Dir;
+   volatile unsigned char *Ren;
+   volatile unsigned char *Out;
+   Byte_t                  Mask;
+} Input_Port_t;
+
+   /* The following table holds the ports of INPUT_PORT_LIST, it is     */
+   /* terminated by an entry without registers.                         */
+static BTPSCONST Input_Port_t InputPorts[] =
+{
+   INPUT_PORT_LIST(INPUT_PORT_ENTRY)
+   { NULL, NULL, NULL, NULL, 0 }
+};
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the compiler*/
+   /* as part of standard C/C++).                                       */
+
+static Byte_t InputCount;                           /* Number of inputs.      */
+
+   /* Internal Function Prototypes.                                     */
+static Byte_t BitCount(Byte_t Mask);
+static void Pack(Byte_t Active, Byte_t Mask, Byte_t *Index, Input_Bitmap_t *Bitmap);
+
+   /* The following function returns the number of bits that are set in */
+   /* the specified mask.                                               */
+static Byte_t BitCount(Byte_t Mask)
+{
+   Byte_t ret_val;
+
+   for(ret_val = 0; Mask; Mask &= (Byte_t)(Mask - 1))
+      ret_val++;
+
+   return(ret_val);
+}
+
+   /* The following function packs the active pins of a port into the   */
+   /* bitmap.  Every pin in the mask takes the next input (the second   */
+   /* parameter is the first input and is advanced past the pins).      */
+static void Pack(Byte_t Active, Byte_t Mask, Byte_t *Index, Input_Bitmap_t *Bitmap)
+{
+   Byte_t Pin;
+
+   for(Pin = 0x01; (Pin) && (*Index < INPUT_MAXIMUM_INPUTS); Pin <<= 1)
+   {
+      if(Mask & Pin)
+      {
+         if(Active & Pin)
+            Bitmap->Bits[*Index >> 3] |= (Byte_t)(1 << (*Index & 0x07));
+
+         (*Index)++;
+      }
+   }
+}
+
+   /* The following function configures the pins of INPUT_PORT_LIST and */
+   /* of the key matrix.                                                */
+Byte_t Input_Initialize(void)
+{
+   Word_t                  Count;
+   BTPSCONST Input_Port_t *Port;
+
+   Count = 8;
+
+   for(Port = InputPorts; Port->In; Port++)
+   {
+      *(Port->Dir) &= (Byte_t)~(Port->Mask);
+      *(Port->Ren) |= Port->Mask;
+      *(Port->Out) |= Port->Mask;
+
+      Count += BitCount(Port->Mask);
+   }
+
+#if INPUT_MATRIX_ROW_MASK
+
+   /* The rows are left floating (inputs) and are driven low one at a   */
+   /* time while scanning, so that two pressed keys never short two     */
+   /* driven rows.                                                      */
+   INPUT_REGISTER(INPUT_MATRIX_ROW_PORT, DIR) &= (Byte_t)~(INPUT_MATRIX_ROW_MASK);
+   INPUT_REGISTER(INPUT_MATRIX_ROW_PORT, REN) &= (Byte_t)~(INPUT_MATRIX_ROW_MASK);
+   INPUT_REGISTER(INPUT_MATRIX_ROW_PORT, OUT) &= (Byte_t)~(INPUT_MATRIX_ROW_MASK);
+
+   INPUT_REGISTER(INPUT_MATRIX_COLUMN_PORT, DIR) &= (Byte_t)~(INPUT_MATRIX_COLUMN_MASK);
+   INPUT_REGISTER(INPUT_MATRIX_COLUMN_PORT, REN) |= (INPUT_MATRIX_COLUMN_MASK);
+   INPUT_REGISTER(INPUT_MATRIX_COLUMN_PORT, OUT) |= (INPUT_MATRIX_COLUMN_MASK);
+
+   Count += BitCount(INPUT_MATRIX_ROW_MASK) * BitCount(INPUT_MATRIX_COLUMN_MASK);
+
+#endif
+
+   InputCount = (Byte_t)((Count > INPUT_MAXIMUM_INPUTS)?INPUT_MAXIMUM_INPUTS:Count);
+
+   return(InputCount);
+}
+
+   /* The following function returns the number of inputs.              */
+Byte_t Input_Get_Count(void)
+{
+   return(InputCount);
+}
+
+   /* The following function scans all inputs into the specified        */
+   /* bitmap.                                                           */
+void Input_Scan(Byte_t Buttons, Input_Bitmap_t *Bitmap)
+{
+   Byte_t                  Index;
+   BTPSCONST Input_Port_t *Port;
+#if INPUT_MATRIX_ROW_MASK
+   Byte_t                  Row;
+   Byte_t                  Columns;
+#endif
+
+   BTPS_MemInitialize(Bitmap, 0, INPUT_BITMAP_DATA_SIZE);
+
+   Bitmap->Bits[0] = Buttons;
+   Index           = 8;
+
+   for(Port = InputPorts; Port->In; Port++)
+      Pack((Byte_t)~(*(Port->In)), Port->Mask, &Index, Bitmap);
+
+#if INPUT_MATRIX_ROW_MASK
+
+   for(Row = 0x01; Row; Row <<= 1)
+   {
+      if(INPUT_MATRIX_ROW_MASK & Row)
+      {
+         INPUT_REGISTER(INPUT_MATRIX_ROW_PORT, DIR) |= Row;
+
+         __delay_cycles(INPUT_MATRIX_SETTLE_CYCLES);
+
+         Columns = (Byte_t)~(INPUT_REGISTER(INPUT_MATRIX_COLUMN_PORT, IN));
+
+         INPUT_REGISTER(INPUT_MATRIX_ROW_PORT, DIR) &= (Byte_t)~Row;
+
+         Pack(Columns, INPUT_MATRIX_COLUMN_MASK, &Index, Bitmap);
+      }
+   }
+
+#endif
+}
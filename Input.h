@@ -0,0 +1,80 @@
+/*****< input.h >**************************************************************/
+/*                                                                            */
+/*  INPUT - Multi-port and key matrix input scanning.                         */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __INPUT_H__
+#define __INPUT_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following list may be defined (project wide) to add direct    */
+   /* inputs on ports other than Port 2.  Each entry is of the form     */
+   /* _x(Port, Mask), for example _x(P3, 0xFF) _x(P4, 0x0F), and        */
+   /* configures the pins in Mask of the port as inputs with pull-ups.  */
+   /* The list is empty by default.                                     */
+   /* * NOTE * These pins do not wake the MSP430 (only the Port 2       */
+   /*          buttons do), they are sampled at the button poll period. */
+#ifndef INPUT_PORT_LIST
+#define INPUT_PORT_LIST(_x)
+#endif
+
+   /* The following may be defined (project wide) to add a scanned key  */
+   /* matrix.  The pins in INPUT_MATRIX_ROW_MASK of                     */
+   /* INPUT_MATRIX_ROW_PORT are the rows, which are driven low one at a */
+   /* time, and the pins in INPUT_MATRIX_COLUMN_MASK of                 */
+   /* INPUT_MATRIX_COLUMN_PORT are the columns, which are read with     */
+   /* pull-ups.  A row mask of zero (the default) disables the matrix.  */
+   /* * NOTE * The matrix keys need a diode per key to be recognized    */
+   /*          reliably when more than two keys are pressed at the same */
+   /*          time.                                                    */
+#ifndef INPUT_MATRIX_ROW_MASK
+#define INPUT_MATRIX_ROW_MASK                            (0)
+#endif
+
+#ifndef INPUT_MATRIX_ROW_PORT
+#define INPUT_MATRIX_ROW_PORT                            P4
+#endif
+
+#ifndef INPUT_MATRIX_COLUMN_MASK
+#define INPUT_MATRIX_COLUMN_MASK                         (0xFF)
+#endif
+
+#ifndef INPUT_MATRIX_COLUMN_PORT
+#define INPUT_MATRIX_COLUMN_PORT                         P5
+#endif
+
+   /* The following defines the maximum number of inputs and the length */
+   /* of the bitmap that holds the state of all inputs.                 */
+#define INPUT_MAXIMUM_INPUTS                             (64)
+#define INPUT_BITMAP_LENGTH                              (INPUT_MAXIMUM_INPUTS / 8)
+
+   /* The following structure holds the state of all inputs as a packed */
+   /* bitmap.  Input N is bit (N % 8) of Bits[N / 8], a set bit means   */
+   /* the input is active (the pin is low or the key is pressed).       */
+   /* Inputs 0 to 7 are the Port 2 button pins (by pin number), followed*/
+   /* by the pins of INPUT_PORT_LIST (in list and pin order) and the    */
+   /* keys of the matrix (row by row).                                  */
+typedef struct _tagInput_Bitmap_t
+{
+   Byte_t Bits[INPUT_BITMAP_LENGTH];
+} Input_Bitmap_t;
+
+#define INPUT_BITMAP_DATA_SIZE                           (sizeof(Input_Bitmap_t))
+
+   /* The following function configures the pins of INPUT_PORT_LIST and */
+   /* of the key matrix.  This function returns the number of inputs    */
+   /* (including the eight Port 2 button inputs).                       */
+   /* * NOTE * The Port 2 button inputs are configured separately (they */
+   /*          depend on the runtime configuration).                    */
+Byte_t Input_Initialize(void);
+
+   /* The following function returns the number of inputs.              */
+Byte_t Input_Get_Count(void);
+
+   /* The following function scans all inputs into the specified        */
+   /* bitmap.  The first parameter is the mask of the Port 2 button pins*/
+   /* that are currently active (Port 2 is already read by the caller). */
+void Input_Scan(Byte_t Buttons, Input_Bitmap_t *Bitmap);
+
+#endif
@@ -0,0 +1,185 @@
+/*****< latency.c >************************************************************/
+/*                                                                            */
+/*  LATENCY - Button wake-to-notify latency measurement.                      */
+/*                                                                            */
+/******************************************************************************/
+#include "Latency.h"             /* Latency Measurement Prototypes/Constants. */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+#define Display(_x)                                do { BTPS_OutputMessage _x; } while(0)
+
+   /* The following bit masks are used with the Marks variable to flag  */
+   /* which time stamps of the measurement in progress are valid.       */
+#define LATENCY_MARK_EDGE                                0x01
+#define LATENCY_MARK_DETECT                              0x02
+#define LATENCY_MARK_NOTIFY                              0x04
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the compiler*/
+   /* as part of standard C/C++).                                       */
+
+static volatile Boolean_t  EdgePending;             /* Edge marked by the ISR */
+static volatile DWord_t    EdgeTimeStamp;           /* (and its time stamp).  */
+
+static Byte_t              Marks;                   /* Valid time stamps of   */
+static DWord_t             StartTimeStamp;          /* the measurement in     */
+static DWord_t             DetectTimeStamp;         /* progress.              */
+static DWord_t             NotifyTimeStamp;
+
+static Boolean_t           Connected;               /* Connection (and the    */
+static Word_t              Handle;                  /* number of its ACL      */
+static Word_t              Outstanding;             /* packets that have not  */
+                                                    /* completed yet).        */
+
+static Word_t              Remaining;               /* ACL packets that must  */
+                                                    /* complete to end the    */
+                                                    /* measurement.           */
+
+static Latency_Histogram_t Histograms[LATENCY_NUMBER_OF_STAGES];
+
+static BTPSCONST char *StageNames[LATENCY_NUMBER_OF_STAGES] =
+{
+   "Edge->Detect",
+   "Detect->Notify",
+   "Notify->Complete",
+   "Edge->Complete"
+};
+
+   /* Internal Function Prototypes.                                     */
+static void AddSample(Latency_Stage_t Stage, DWord_t Latency);
+
+   /* The following function adds the specified latency (in             */
+   /* milliseconds) to the histogram of the specified stage.            */
+static void AddSample(Latency_Stage_t Stage, DWord_t Latency)
+{
+   unsigned int         Index;
+   DWord_t              Value;
+   Latency_Histogram_t *Histogram;
+
+   Histogram = &(Histograms[Stage]);
+
+   /* Determine the bucket, i.e. the number of significant bits.        */
+   for(Index = 0, Value = Latency; (Value) && (Index < (LATENCY_HISTOGRAM_BUCKETS - 1)); Index++)
+      Value >>= 1;
+
+   if(Histogram->Buckets[Index] != 0xFFFF)
+      Histogram->Buckets[Index]++;
+
+   if(Histogram->Count != 0xFFFF)
+      Histogram->Count++;
+
+   if(Latency > Histogram->Maximum)
+      Histogram->Maximum = Latency;
+}
+
+   /* The following function marks a button edge.                       */
+void Latency_Mark_Edge(void)
+{
+   if(!EdgePending)
+   {
+      EdgeTimeStamp = BTPS_GetTickCount();
+      EdgePending   = TRUE;
+   }
+}
+
+   /* The following function marks the detection of a button change.    */
+void Latency_Mark_Detect(void)
+{
+   /* A new measurement starts with every detected change (a measurement*/
+   /* that is still in progress is abandoned).                          */
+   DetectTimeStamp = BTPS_GetTickCount();
+   Marks           = LATENCY_MARK_DETECT;
+
+   if(EdgePending)
+   {
+      StartTimeStamp  = EdgeTimeStamp;
+      EdgePending     = FALSE;
+      Marks          |= LATENCY_MARK_EDGE;
+
+      AddSample(lsEdgeToDetect, (DetectTimeStamp - StartTimeStamp));
+   }
+}
+
+   /* The following function selects the connection of the              */
+   /* notifications.                                                    */
+void Latency_Set_Connection(Word_t Connection_Handle)
+{
+   Connected   = TRUE;
+   Handle      = Connection_Handle;
+   Outstanding = 0;
+   Marks       = 0;
+}
+
+   /* The following function marks an ACL packet that has been sent.    */
+void Latency_Mark_Sent(Word_t Connection_Handle)
+{
+   if((Connected) && (Connection_Handle == Handle) && (Outstanding != 0xFFFF))
+      Outstanding++;
+}
+
+   /* The following function marks that a notification is about to be   */
+   /* submitted.                                                        */
+void Latency_Mark_Submit(void)
+{
+   /* The notification itself is a single ACL packet.                   */
+   Remaining = (Word_t)(Outstanding + 1);
+}
+
+   /* The following function marks the submission of a notification.    */
+void Latency_Mark_Notify(void)
+{
+   if(Marks & LATENCY_MARK_DETECT)
+   {
+      NotifyTimeStamp = BTPS_GetTickCount();
+      Marks           = (Byte_t)((Marks & LATENCY_MARK_EDGE) | LATENCY_MARK_NOTIFY);
+
+      AddSample(lsDetectToNotify, (NotifyTimeStamp - DetectTimeStamp));
+   }
+}
+
+   /* The following function marks the completion of ACL packets.       */
+void Latency_Mark_Complete(Word_t Connection_Handle, Word_t Count)
+{
+   DWord_t TimeStamp;
+
+   if((!Connected) || (Connection_Handle != Handle))
+      Count = 0;
+
+   Outstanding = (Word_t)((Count < Outstanding)?(Outstanding - Count):0);
+   Remaining   = (Word_t)((Count < Remaining)?(Remaining - Count):0);
+
+   if((Count) && (!Remaining) && (Marks & LATENCY_MARK_NOTIFY))
+   {
+      TimeStamp = BTPS_GetTickCount();
+
+      AddSample(lsNotifyToComplete, (TimeStamp - NotifyTimeStamp));
+
+      if(Marks & LATENCY_MARK_EDGE)
+         AddSample(lsEdgeToComplete, (TimeStamp - StartTimeStamp));
+
+      Marks = 0;
+   }
+}
+
+   /* The following function returns the histogram of a stage.          */
+Latency_Histogram_t *Latency_Get_Histogram(Latency_Stage_t Stage)
+{
+   return(((unsigned int)Stage < LATENCY_NUMBER_OF_STAGES)?&(Histograms[Stage]):NULL);
+}
+
+   /* The following function displays the latency histograms.           */
+void Latency_Display(void)
+{
+   unsigned int Stage;
+   unsigned int Index;
+
+   for(Stage = 0; Stage < LATENCY_NUMBER_OF_STAGES; Stage++)
+   {
+      Display(("%-16s n=%u max=%lums:", StageNames[Stage], Histograms[Stage].Count, (unsigned long)Histograms[Stage].Maximum));
+
+      for(Index = 0; Index < LATENCY_HISTOGRAM_BUCKETS; Index++)
+         Display((" %u", Histograms[Stage].Buckets[Index]));
+
+      Display(("\r\n"));
+   }
+}
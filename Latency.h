@@ -0,0 +1,91 @@
+/*****< latency.h >************************************************************/
+/*                                                                            */
+/*  LATENCY - Button wake-to-notify latency measurement.                      */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __LATENCY_H__
+#define __LATENCY_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following enumerates the stages of the path from a button edge*/
+   /* to the notification leaving the controller that are measured.     */
+   /* Every stage is the time between two of the marks below,           */
+   /* lsEdgeToComplete is the total of the other three stages.          */
+typedef enum
+{
+   lsEdgeToDetect,
+   lsDetectToNotify,
+   lsNotifyToComplete,
+   lsEdgeToComplete
+} Latency_Stage_t;
+
+#define LATENCY_NUMBER_OF_STAGES                         (4)
+
+   /* The following defines the number of buckets of each latency       */
+   /* histogram.  Bucket zero counts latencies of zero milliseconds,    */
+   /* bucket N (N > 0) counts latencies of at least 2^(N-1) and less    */
+   /* than 2^N milliseconds and the last bucket counts all longer       */
+   /* latencies.                                                        */
+#define LATENCY_HISTOGRAM_BUCKETS                        (12)
+
+   /* The following structure represents the latency histogram of a     */
+   /* single stage.  The bucket counters saturate at 0xFFFF.            */
+typedef struct _tagLatency_Histogram_t
+{
+   Word_t  Count;
+   DWord_t Maximum;
+   Word_t  Buckets[LATENCY_HISTOGRAM_BUCKETS];
+} Latency_Histogram_t;
+
+#define LATENCY_HISTOGRAM_DATA_SIZE                      (sizeof(Latency_Histogram_t))
+
+   /* The following function marks a button edge.  This function is     */
+   /* called from the Port 2 Interrupt Service Routine, only the first  */
+   /* edge since the last detected button change is marked.             */
+void Latency_Mark_Edge(void);
+
+   /* The following function marks the detection of a button change by  */
+   /* the button poll.                                                  */
+void Latency_Mark_Detect(void);
+
+   /* The following function selects the LE connection (by its HCI      */
+   /* Connection Handle) that the notifications are sent on.  The ACL   */
+   /* packets of this connection are counted from now on (any           */
+   /* measurement in progress is abandoned).                            */
+void Latency_Set_Connection(Word_t Connection_Handle);
+
+   /* The following function marks an ACL packet that has been sent to  */
+   /* the controller on the specified connection.                       */
+void Latency_Mark_Sent(Word_t Connection_Handle);
+
+   /* The following function marks that the notification of a detected  */
+   /* button change is about to be submitted to GATT.  The ACL packets  */
+   /* of the connection that are still outstanding at this point are    */
+   /* completed before the notification.                                */
+   /* * NOTE * ACL packets that are still queued in the stack (because  */
+   /*          the controller has no free buffer) are not yet counted as*/
+   /*          outstanding.                                             */
+void Latency_Mark_Submit(void);
+
+   /* The following function marks the (successful) submission of the   */
+   /* notification of a detected button change to GATT.                 */
+void Latency_Mark_Notify(void);
+
+   /* The following function marks the completion of the transmission of*/
+   /* the specified number of ACL packets on the specified connection,  */
+   /* as reported by the controller with the Number of Completed Packets*/
+   /* event.  The measurement of a button change ends once the packets  */
+   /* that were outstanding when its notification was submitted and the */
+   /* notification itself have completed.                               */
+void Latency_Mark_Complete(Word_t Connection_Handle, Word_t Count);
+
+   /* The following function returns a pointer to the latency histogram */
+   /* of the specified stage (or NULL if the stage is invalid).         */
+Latency_Histogram_t *Latency_Get_Histogram(Latency_Stage_t Stage);
+
+   /* The following function displays the latency histograms of all     */
+   /* stages on the debug console.                                      */
+void Latency_Display(void);
+
+#endif
@@ -0,0 +1,234 @@
+/*****< myletyp.h >************************************************************/
+/*                                                                            */
+/*  MYLETYP - Button panel (MYLE) GATT Service Types File.                    */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __MYLETYP_H__
+#define __MYLETYP_H__
+
+   /* The following defines the MYLE Service UUID that is used when     */
+   /* building the MYLE Service Table.                                  */
+#define MYLE_SERVICE_UUID_CONSTANT                       { 0x39, 0x23, 0xCF, 0x40, 0x73, 0x16, 0x42, 0x9A, 0x5c, 0x41, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00 }
+
+   /* The following defines the MYLE Button Characteristic UUID that is */
+   /* used when building the MYLE Service Table.                        */
+#define MYLE_BUTTON_CHARACTERISTIC_UUID_CONSTANT         { 0x57, 0x9A, 0x05, 0x43, 0x52, 0xCD, 0xB1, 0xA6, 0x1a, 0x4b, 0xE7, 0x00, 0x00, 0x00, 0x00, 0x00 }
+
+   /* The following defines the MYLE Button History Characteristic UUID */
+   /* that is used when building the MYLE Service Table.                */
+#define MYLE_HISTORY_CHARACTERISTIC_UUID_CONSTANT        { 0x57, 0x9A, 0x05, 0x43, 0x52, 0xCD, 0xB1, 0xA6, 0x1a, 0x4b, 0xE7, 0x01, 0x00, 0x00, 0x00, 0x00 }
+
+   /* The following defines the MYLE Configuration Characteristic UUID  */
+   /* that is used when building the MYLE Service Table.                */
+#define MYLE_CONFIGURATION_CHARACTERISTIC_UUID_CONSTANT  { 0x57, 0x9A, 0x05, 0x43, 0x52, 0xCD, 0xB1, 0xA6, 0x1a, 0x4b, 0xE7, 0x02, 0x00, 0x00, 0x00, 0x00 }
+
+   /* The following defines the MYLE Telemetry Characteristic UUID that */
+   /* is used when building the MYLE Service Table.                     */
+#define MYLE_TELEMETRY_CHARACTERISTIC_UUID_CONSTANT      { 0x57, 0x9A, 0x05, 0x43, 0x52, 0xCD, 0xB1, 0xA6, 0x1a, 0x4b, 0xE7, 0x03, 0x00, 0x00, 0x00, 0x00 }
+
+   /* The following defines the MYLE Gesture Characteristic UUID that is*/
+   /* used when building the MYLE Service Table.                        */
+#define MYLE_GESTURE_CHARACTERISTIC_UUID_CONSTANT        { 0x57, 0x9A, 0x05, 0x43, 0x52, 0xCD, 0xB1, 0xA6, 0x1a, 0x4b, 0xE7, 0x04, 0x00, 0x00, 0x00, 0x00 }
+
+   /* The following defines the MYLE Inputs Characteristic UUID that is */
+   /* used when building the MYLE Service Table.                        */
+#define MYLE_INPUTS_CHARACTERISTIC_UUID_CONSTANT         { 0x57, 0x9A, 0x05, 0x43, 0x52, 0xCD, 0xB1, 0xA6, 0x1a, 0x4b, 0xE7, 0x05, 0x00, 0x00, 0x00, 0x00 }
+
+   /* The following defines the MYLE Control Characteristic UUID that is*/
+   /* used when building the MYLE Service Table.                        */
+#define MYLE_CONTROL_CHARACTERISTIC_UUID_CONSTANT        { 0x57, 0x9A, 0x05, 0x43, 0x52, 0xCD, 0xB1, 0xA6, 0x1a, 0x4b, 0xE7, 0x06, 0x00, 0x00, 0x00, 0x00 }
+
+   /* The following defines the structure that holds the information    */
+   /* that needs to be cached by a MYLE Server for EACH connected (and, */
+   /* if bonded, EACH paired) MYLE Client.                              */
+typedef struct _tagMYLE_Server_Info_t
+{
+   Word_t  Button_Client_Configuration_Descriptor;
+   Word_t  History_Client_Configuration_Descriptor;
+   DWord_t History_Read_Sequence;
+   Word_t  History_Read_Count;
+   DWord_t History_Read_TimeStamp;
+   Word_t  Gesture_Client_Configuration_Descriptor;
+   Word_t  Inputs_Client_Configuration_Descriptor;
+} MYLE_Server_Info_t;
+
+#define MYLE_SERVER_INFO_DATA_SIZE                       (sizeof(MYLE_Server_Info_t))
+
+   /* The following defines the length of the MYLE Button               */
+   /* characteristic value.                                             */
+#define MYLE_BUTTON_VALUE_LENGTH                         (WORD_SIZE)
+
+   /* The following define the format of the MYLE Button History        */
+   /* characteristic value.  The value consists of a header followed by */
+   /* the retained button transitions (oldest first) in the compact     */
+   /* encoding that is described in EventCodec.h.  The header holds the */
+   /* sequence number of the first transition (DWord), the number of    */
+   /* transitions (Word), the System Tick Count at which the history was*/
+   /* captured (DWord) and the base time stamp (DWord).  All header     */
+   /* fields are Little-Endian.  The base time stamp is the System Tick */
+   /* Count of the first transition itself, so the first transition is  */
+   /* encoded with a time of zero and every other transition relative to*/
+   /* the one before it.  The oldest transitions are left out of the    */
+   /* capture if the encoded value would not fit in an attribute value  */
+   /* (MYLE_HISTORY_MAXIMUM_LENGTH).                                    */
+   /* * NOTE * The history is captured when a client reads the value at */
+   /*          offset zero, subsequent (blob) reads by the same client  */
+   /*          return the remainder of that same capture.               */
+#define MYLE_HISTORY_HEADER_LENGTH                       (DWORD_SIZE + WORD_SIZE + DWORD_SIZE + DWORD_SIZE)
+#define MYLE_HISTORY_MAXIMUM_LENGTH                      (512)
+
+   /* The following define the format of the Offline Journal            */
+   /* notifications that are sent on the MYLE Button History            */
+   /* characteristic.  Each notification consists of a header followed  */
+   /* by as many transitions (in the compact encoding of the History    */
+   /* value) as fit in the connection MTU.  The header holds the        */
+   /* sequence number of the first transition (DWord), the number of    */
+   /* transitions that were lost (overwritten before they could be      */
+   /* delivered) since the previous notification (Word, saturating) and */
+   /* the base time stamp (DWord, as in the History value).             */
+#define MYLE_JOURNAL_HEADER_LENGTH                       (DWORD_SIZE + WORD_SIZE + DWORD_SIZE)
+
+   /* The following define the format of the Offline Journal            */
+   /* acknowledgement that a client writes (with or without response) to*/
+   /* the MYLE Button History characteristic value.  The acknowledgement*/
+   /* holds the sequence number of the next transition the client       */
+   /* expects (DWord, i.e. every earlier transition has been received), */
+   /* optionally followed by the number of transitions that are missing */
+   /* from that sequence number on (Word), which are then retransmitted */
+   /* ahead of any new transition.  All fields are Little-Endian.       */
+   /* * NOTE * The first acknowledgement of a connection enables        */
+   /*          reliable delivery for the rest of the connection, at     */
+   /*          most MYLE_JOURNAL_WINDOW_SIZE transitions are sent ahead */
+   /*          of the last acknowledgement, all unacknowledged          */
+   /*          transitions are sent again if no acknowledgement arrives */
+   /*          for MYLE_JOURNAL_RETRANSMIT_TIMEOUT ms and on the next   */
+   /*          connection.                                              */
+#define MYLE_JOURNAL_ACK_LENGTH                          (DWORD_SIZE)
+#define MYLE_JOURNAL_ACK_MISSING_LENGTH                  (DWORD_SIZE + WORD_SIZE)
+
+#define MYLE_JOURNAL_WINDOW_SIZE                         (32)
+#define MYLE_JOURNAL_RETRANSMIT_TIMEOUT                  (1000)
+
+   /* The following define the format of the Manufacturer Specific A/D  */
+   /* Field that is included in the LE Advertising Data in Broadcast    */
+   /* Mode.  The data consists of the Company Identifier (Word), a      */
+   /* rolling sequence number that is incremented on every button change*/
+   /* (Byte) and the button state (Word, in the format of the MYLE      */
+   /* Button characteristic).  All fields are Little-Endian.            */
+   /* * NOTE * The Company Identifier may be defined (project wide).    */
+   /*          The default 0xFFFF is reserved by the Bluetooth SIG for  */
+   /*          internal use and testing, an assigned identifier must be */
+   /*          used for production.                                     */
+#ifndef MYLE_BROADCAST_COMPANY_IDENTIFIER
+#define MYLE_BROADCAST_COMPANY_IDENTIFIER                (0xFFFF)
+#endif
+
+#define MYLE_BROADCAST_DATA_LENGTH                       (WORD_SIZE + BYTE_SIZE + MYLE_BUTTON_VALUE_LENGTH)
+
+   /* The following define the format of the MYLE Configuration         */
+   /* characteristic value.  The value holds the button poll period     */
+   /* (Word), the minimum and maximum LE Advertising Interval (Word,    */
+   /* Word), the minimum and maximum HCILL inactivity timeout (Word,    */
+   /* Word), all in milliseconds, followed by the button pin mask (Byte)*/
+   /* and the maximum number of records per Offline Journal notification*/
+   /* (Byte, zero for as many as fit in the MTU).  All fields are       */
+   /* Little-Endian.  A write must contain the complete value, the new  */
+   /* configuration is applied immediately and retained across resets.  */
+#define MYLE_CONFIGURATION_VALUE_LENGTH                  ((5 * WORD_SIZE) + (2 * BYTE_SIZE))
+
+   /* The following defines the format of the MYLE Telemetry            */
+   /* characteristic value.  The value holds, in bytes, the size,       */
+   /* current usage and peak usage of the system stack (Word, Word,     */
+   /* Word) followed by the size, current usage, peak usage and largest */
+   /* free block of the Bluetopia heap (Word, Word, Word, Word).  All   */
+   /* fields are Little-Endian.  The value is captured when it is read. */
+#define MYLE_TELEMETRY_VALUE_LENGTH                      (7 * WORD_SIZE)
+
+   /* The following defines the format of the MYLE Gesture              */
+   /* characteristic value.  The value holds the Port 2 pin number of   */
+   /* the button (Byte), the gesture (Byte, see Gesture_Type_t in       */
+   /* Gesture.h), the duration of the gesture in milliseconds (Word) and*/
+   /* the System Tick Count at which the gesture started (DWord).  All  */
+   /* fields are Little-Endian.  A notification is sent for every       */
+   /* recognized gesture, a read returns the last one (all zero if none */
+   /* has been recognized yet).                                         */
+#define MYLE_GESTURE_VALUE_LENGTH                        (BYTE_SIZE + BYTE_SIZE + WORD_SIZE + DWORD_SIZE)
+
+   /* The following defines the format of the MYLE Inputs characteristic*/
+   /* value.  The value holds the number of inputs (Byte) followed by   */
+   /* the state of all inputs and the mask of the inputs that changed,  */
+   /* both as packed bitmaps of (number of inputs + 7) / 8 bytes (input */
+   /* N is bit (N % 8) of byte N / 8, a set bit in the state means the  */
+   /* input is active).  A single notification is sent per button poll  */
+   /* in which any input changed, a read returns the current state with */
+   /* an empty change mask.  The first parameter of the MACRO is the    */
+   /* number of inputs.                                                 */
+   /* * NOTE * See Input.h for the numbering of the inputs, inputs 0 to */
+   /*          7 are the Port 2 buttons of the MYLE Button              */
+   /*          characteristic.                                          */
+#define MYLE_INPUTS_VALUE_LENGTH(_Count)                 (BYTE_SIZE + (2 * (((_Count) + 7) / 8)))
+
+   /* The following define the format of the MYLE Control characteristic*/
+   /* value.  The value holds one or more commands, each command is an  */
+   /* opcode (Byte) followed by its parameters.  Set LED takes the LED  */
+   /* number (Byte) and the new state (Byte, zero for off), Blink LED   */
+   /* takes the LED number (Byte) and the toggle period in milliseconds */
+   /* (Word, zero stops blinking) and Write Outputs takes a pin mask    */
+   /* (Byte) and the new pin values (Byte).  All fields are             */
+   /* Little-Endian.  The value may be written with or without response,*/
+   /* the commands are applied as soon as the write is received and only*/
+   /* if all of them are valid.                                         */
+   /* * NOTE * The value may only be written over an encrypted link.    */
+   /*          LED 0 shows the connection state and may not be          */
+   /*          controlled.  All LEDs and outputs are reset when the     */
+   /*          client disconnects.                                      */
+#define MYLE_CONTROL_OPCODE_SET_LED                      (0x01)
+#define MYLE_CONTROL_OPCODE_BLINK_LED                    (0x02)
+#define MYLE_CONTROL_OPCODE_WRITE_OUTPUTS                (0x03)
+
+#define MYLE_CONTROL_SET_LED_LENGTH                      (BYTE_SIZE + BYTE_SIZE + BYTE_SIZE)
+#define MYLE_CONTROL_BLINK_LED_LENGTH                    (BYTE_SIZE + BYTE_SIZE + WORD_SIZE)
+#define MYLE_CONTROL_WRITE_OUTPUTS_LENGTH                (BYTE_SIZE + BYTE_SIZE + BYTE_SIZE)
+
+   /* The following defines the Application ATT Error Code that is      */
+   /* returned when a blob read of the MYLE Button History can no longer*/
+   /* be served because the captured records have been overwritten.  The*/
+   /* client should restart the read at offset zero.                    */
+#define MYLE_ATT_ERROR_CODE_HISTORY_OVERWRITTEN          (0x80)
+
+   /* The following defines the Application ATT Error Code that is      */
+   /* returned when a write of the MYLE Configuration holds a parameter */
+   /* that is out of range.  The configuration in effect is left        */
+   /* unchanged.                                                        */
+#define MYLE_ATT_ERROR_CODE_CONFIGURATION_INVALID        (0x81)
+
+   /* The following defines the Application ATT Error Code that is      */
+   /* returned when a write of the MYLE Control characteristic holds an */
+   /* unknown or truncated command or an LED that may not be controlled.*/
+   /* None of the commands of the write are applied.                    */
+#define MYLE_ATT_ERROR_CODE_CONTROL_INVALID              (0x82)
+
+   /* The following defines the Application ATT Error Code that is      */
+   /* returned when an Offline Journal acknowledgement holds a sequence */
+   /* number of a transition that has not been sent yet.                */
+#define MYLE_ATT_ERROR_CODE_JOURNAL_ACK_INVALID          (0x83)
+
+   /* The following defines the length of the Client Characteristic     */
+   /* Configuration Descriptor.                                         */
+#define MYLE_CLIENT_CHARACTERISTIC_CONFIGURATION_VALUE_LENGTH (WORD_SIZE)
+
+   /* The following MACROs are used to generate the MYLE Service tables */
+   /* from a single attribute list (see MYLE_SERVICE_ATTRIBUTES).  Each */
+   /* MACRO is passed to the attribute list and expands every entry of  */
+   /* the list into, respectively, an Attribute Offset enumerator, a    */
+   /* GATT_Service_Attribute_Entry_t and a MYLE_Attribute_Handler_t.    */
+#define MYLE_ATTRIBUTE_OFFSET(_Name, _AttributeFlags, _EntryType, _Entry, _HandlerFlags, _Value, _ValueLength, _ReadFunction, _WriteFunction)  MYLE_##_Name##_ATTRIBUTE_OFFSET,
+#define MYLE_ATTRIBUTE_ENTRY(_Name, _AttributeFlags, _EntryType, _Entry, _HandlerFlags, _Value, _ValueLength, _ReadFunction, _WriteFunction)   {(_AttributeFlags), (_EntryType), (Byte_t *)&(_Entry)},
+#define MYLE_ATTRIBUTE_HANDLER(_Name, _AttributeFlags, _EntryType, _Entry, _HandlerFlags, _Value, _ValueLength, _ReadFunction, _WriteFunction) {(_HandlerFlags), (Byte_t *)(_Value), (_ValueLength), (_ReadFunction), (_WriteFunction)},
+
+   /* The following MACRO is a utility MACRO that fails compilation if  */
+   /* the specified constant expression is FALSE.  The second parameter */
+   /* is a unique name used for the generated type.                     */
+#define MYLE_STATIC_ASSERT(_Condition, _Name)            typedef char _Name[(_Condition)?1:-1]
+
+#endif
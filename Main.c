@@ -1,170 +1,486 @@
-/*****< main.c >***************************************************************/
-/*      Copyright 2001 - 2012 Stonestreet One.                                */
-/*      All Rights Reserved.                                                  */
-/*                                                                            */
-/*  MAIN - Main application implementation.                                   */
-/*                                                                            */
-/*  Author:  Tim Cook                                                         */
-/*                                                                            */
-/*** MODIFICATION HISTORY *****************************************************/
-/*                                                                            */
-/*   mm/dd/yy  F. Lastname    Description of Modification                     */
-/*   --------  -----------    ------------------------------------------------*/
-/*   10/28/11  T. Cook        Initial creation.                               */
-/******************************************************************************/
-#include "HAL.h"                 /* Function for Hardware Abstraction.        */
-#include "Main.h"                /* Main application header.                  */
-#include "EHCILL.h"              /* eHCILL Implementation Header.             */
-
-#define Display(_x)                                do { BTPS_OutputMessage _x; } while(0)
-
-#define MAX_COMMAND_LENGTH                         (64)  /* Denotes the max   */
-                                                         /* buffer size used  */
-                                                         /* for user commands */
-                                                         /* input via the     */
-                                                         /* User Interface.   */
-
-#define LED_TOGGLE_RATE_SUCCESS                    (500) /* The LED Toggle    */
-                                                         /* rate when the demo*/
-                                                         /* successfully      */
-                                                         /* starts up.        */
-
-   /* The following parameters are used when configuring HCILL Mode.    */
-#define HCILL_MODE_INACTIVITY_TIMEOUT              (500)
-#define HCILL_MODE_RETRANSMIT_TIMEOUT              (100)
-
-   /* Internal Variables to this Module (Remember that all variables    */
-   /* declared static are initialized to 0 automatically by the         */
-   /* compiler as part of standard C/C++).                              */
-static unsigned int BluetoothStackID;
-
-   /* Application Tasks.                                                */
-static void DisplayCallback(char Character);
-static unsigned long GetTickCallback(void);
-static void IdleFunction(void *UserParameter);
-static void MainThread(void);
-
-   /* The following function is registered with the application so that */
-   /* it can display strings to the debug UART.                         */
-static void DisplayCallback(char Character)
-{
-   HAL_ConsoleWrite(1, &Character);
-}
-
-   /* The following function is registered with the application so that */
-   /* it can get the current System Tick Count.                         */
-static unsigned long GetTickCallback(void)
-{
-   return(HAL_GetTickCount());
-}
-
-
-
-static void ButtonPollFunction(void *UserParameter)
-{
-	port2_poll();
-}
-
-   /* The following function is responsible for checking the idle state */
-   /* and possibly entering LPM3 mode.                                  */
-static void IdleFunction(void *UserParameter)
-{
-   HCILL_State_t HCILL_State;
-
-   /* Determine the HCILL State.                                        */
-   HCILL_State = HCILL_GetState();
-
-   /* If the stack is Idle and we are in HCILL Sleep, then we may enter */
-   /* LPM3 mode (with Timer Interrupts disabled).                       */
-   if((BSC_QueryStackIdle(BluetoothStackID)) && (HCILL_State == hsSleep) && (!HCILL_Get_Power_Lock_Count()))
-   {
-      /* Enter MSP430 LPM3 with Timer Interrupts disabled (we will      */
-      /* require an interrupt to wake us up from this state).           */
-
-	  // dont go to sleep
-      HAL_LowPowerMode((unsigned char)FALSE);
-   }
-}
-
-   /* The following function is the main user interface thread.  It     */
-   /* opens the Bluetooth Stack and then drives the main user interface.*/
-static void MainThread(void)
-{
-   int                     Result;
-   BTPS_Initialization_t   BTPS_Initialization;
-   HCI_DriverInformation_t HCI_DriverInformation;
-
-   /* Configure the UART Parameters.                                    */
-   HCI_DRIVER_SET_COMM_INFORMATION(&HCI_DriverInformation, 1, 115200, cpUART);
-   HCI_DriverInformation.DriverInformation.COMMDriverInformation.InitializationDelay = 100;
-
-   /* Set up the application callbacks.                                 */
-   BTPS_Initialization.GetTickCountCallback  = GetTickCallback;
-   BTPS_Initialization.MessageOutputCallback = DisplayCallback;
-
-   /* Initialize the application.                                       */
-   if((Result = InitializeApplication(&HCI_DriverInformation, &BTPS_Initialization)) > 0)
-   {
-      /* Save the Bluetooth Stack ID.                                   */
-      BluetoothStackID = (unsigned int)Result;
-
-      /* Go ahead an enable HCILL Mode.                                 */
-      HCILL_Init();
-      HCILL_Configure(BluetoothStackID, HCILL_MODE_INACTIVITY_TIMEOUT, HCILL_MODE_RETRANSMIT_TIMEOUT, TRUE);
-
-      // add our polling function to the scheduler
-	  // period = 50ms
-	  if(BTPS_AddFunctionToScheduler(ButtonPollFunction, NULL, 50))
-	  {
-        /* Add the idle function (which determines if LPM3 may be entered)*/
-		/* to the scheduler.                                              */
-		if(BTPS_AddFunctionToScheduler(IdleFunction, NULL, HCILL_MODE_INACTIVITY_TIMEOUT))
-		{
-		   /* Loop forever and execute the scheduler.                     */
-		   while(1)
-			  BTPS_ExecuteScheduler();
-		}
-	  }
-   }
-}
-
-   /* The following is the Main application entry point.  This function */
-   /* will configure the hardware and initialize the OS Abstraction     */
-   /* layer, create the Main application thread and start the scheduler.*/
-int main(void)
-{
-   /* Turn off the watchdog timer                                       */
-   WDTCTL = WDTPW | WDTHOLD;
-
-   /* Configure the hardware for its intended use.                      */
-   HAL_ConfigureHardware();
-
-
-   // init hardware inputs
-   P2DIR = 0;
-   	P2REN = BIT0 + BIT1 + BIT2 + BIT3;
-   	P2OUT = BIT0 + BIT1 + BIT2 + BIT3;
-
-   	// enable interrupts to wake MSP from low power mode if necessary
-   	P2IE = BIT0 + BIT1 + BIT2 + BIT3;
-   	P2IES = P2IN;
-
-   /* Enable interrupts and call the main application thread.           */
-   __enable_interrupt();
-   MainThread();
-
-   Display(("Something went wrong, initiating software POR\r\n"));
-
-   	/* MainThread should run continously, if it exits an error occured.  */
-   	int i;
-   	for(i = 0; i < 40; i++)
-   	{
-   		HAL_LedToggle(0);
-   		BTPS_Delay(100);
-   	}
-
-   	// do a software POR reset
-   	PMMCTL0 = PMMPW + PMMSWPOR + (PMMCTL0 & 0x0003);
-}
-
-
+/*****< main.c >***************************************************************/
+/*      Copyright 2001 - 2012 Stonestreet One.                                */
+/*      All Rights Reserved.                                                  */
+/*                                                                            */
+/*  MAIN - Main application implementation.                                   */
+/*                                                                            */
+/*  Author:  Tim Cook                                                         */
+/*                                                                            */
+/*** MODIFICATION HISTORY *****************************************************/
+/*                                                                            */
+/*   mm/dd/yy  F. Lastname    Description of Modification                     */
+/*   --------  -----------    ------------------------------------------------*/
+/*   10/28/11  T. Cook        Initial creation.                               */
+/******************************************************************************/
+#include "HAL.h"                 /* Function for Hardware Abstraction.        */
+#include "Main.h"                /* Main application header.                  */
+#include "EHCILL.h"              /* eHCILL Implementation Header.             */
+#include "Config.h"              /* Configuration Prototypes/Constants.       */
+#include "BootTime.h"            /* Boot Time Prototypes/Constants.           */
+#include "MemoryUsage.h"         /* Memory Usage Prototypes/Constants.        */
+#include "Input.h"               /* Input Prototypes/Constants.               */
+#include "Control.h"             /* Control Prototypes/Constants.             */
+
+#define Display(_x)                                do { BTPS_OutputMessage _x; } while(0)
+
+#define MAX_COMMAND_LENGTH                         (64)  /* Denotes the max   */
+                                                         /* buffer size used  */
+                                                         /* for user commands */
+                                                         /* input via the     */
+                                                         /* User Interface.   */
+
+#define LED_TOGGLE_RATE_SUCCESS                    (500) /* The LED Toggle    */
+                                                         /* rate when the demo*/
+                                                         /* successfully      */
+                                                         /* starts up.        */
+
+   /* The following parameters are used when configuring HCILL Mode.    */
+#define HCILL_MODE_INACTIVITY_TIMEOUT              (500)
+#define HCILL_MODE_RETRANSMIT_TIMEOUT              (100)
+
+   /* The following parameters are used by the adaptive HCILL policy.   */
+   /* The HCILL State is tracked every HCILL_POLICY_SAMPLE_PERIOD ms    */
+   /* while the MSP430 is awake and right before and after LPM3 (where  */
+   /* the controller wakes us up), and the inactivity timeout is        */
+   /* re-evaluated once HCILL_POLICY_WINDOW ms have elapsed.  If the    */
+   /* controller woke up at least HCILL_POLICY_BURST_WAKES times in a   */
+   /* window the timeout is doubled (traffic is bursty and every packet */
+   /* pays for a wake handshake), if it was awake for at most           */
+   /* HCILL_POLICY_IDLE_AWAKE_PERCENT of the window the timeout is      */
+   /* halved (so the UART goes back to sleep sooner after the next      */
+   /* isolated event).  The timeout is always kept within the bounds    */
+   /* that are set in the configuration (see Config_t).                 */
+#define HCILL_POLICY_SAMPLE_PERIOD                 (10)
+#define HCILL_POLICY_WINDOW                        (1000)
+#define HCILL_POLICY_BURST_WAKES                   (4)
+#define HCILL_POLICY_IDLE_AWAKE_PERCENT            (25)
+
+   /* The following parameters are used when the application fails.  The*/
+   /* stack is restarted in place (retaining bonds and configuration)   */
+   /* after RESTART_DELAY ms.  Only after MAX_RESTART_ATTEMPTS          */
+   /* consecutive restarts that did not keep the application running for*/
+   /* at least RESTART_STABLE_TIME ms is a software POR done instead.   */
+#define MAX_RESTART_ATTEMPTS                       (3)
+#define RESTART_DELAY                              (100)
+#define RESTART_STABLE_TIME                        (60000)
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the         */
+   /* compiler as part of standard C/C++).                              */
+static unsigned int BluetoothStackID;
+
+static unsigned int  HCILLInactivityTimeout;   /* Current HCILL inactivity    */
+                                               /* timeout (in ms).            */
+
+static HCILL_State_t HCILLLastState;           /* HCILL State when it was     */
+                                               /* last tracked.               */
+
+static DWord_t       HCILLAwakeSince;          /* Time the controller last    */
+                                               /* woke up.                    */
+
+static DWord_t       HCILLWindowStart;         /* Start, number of wakes and  */
+static unsigned int  HCILLWindowWakes;         /* time (in ms) awake of the   */
+static DWord_t       HCILLWindowAwakeTime;     /* current policy window.      */
+
+static DWord_t       HCILLSleepCount;          /* Total number of HCILL       */
+static DWord_t       HCILLWakeCount;           /* sleep and wake transitions. */
+
+static Word_t        ButtonPollPeriod;         /* Period and pin mask the     */
+static Byte_t        ButtonMask;               /* button inputs are currently */
+                                               /* polled with.                */
+
+   /* Application Tasks.                                                */
+static void DisplayCallback(char Character);
+static unsigned long GetTickCallback(void);
+static void ConfigureButtonInputs(Byte_t Mask);
+static void ButtonPollFunction(void *UserParameter);
+static void UpdateButtonPollPeriod(void);
+static void IdleFunction(void *UserParameter);
+static void HCILLTrackState(DWord_t TimeStamp);
+static void HCILLPolicyFunction(void *UserParameter);
+static Boolean_t StartApplication(HCI_DriverInformation_t *HCI_DriverInformation, BTPS_Initialization_t *BTPS_Initialization);
+static void StopApplication(void);
+static void MainThread(void);
+
+   /* The following function is registered with the application so that */
+   /* it can display strings to the debug UART.                         */
+static void DisplayCallback(char Character)
+{
+   HAL_ConsoleWrite(1, &Character);
+}
+
+   /* The following function is registered with the application so that */
+   /* it can get the current System Tick Count.                         */
+static unsigned long GetTickCallback(void)
+{
+   return(HAL_GetTickCount());
+}
+
+   /* The following function is responsible for configuring the         */
+   /* specified Port 2 pins as button inputs (with pull-ups) that wake  */
+   /* the MSP430 on every edge.  Only the button pins are modified, the */
+   /* pins that are no longer buttons have their pull-up and interrupt  */
+   /* removed and all other Port 2 pins keep their configuration.       */
+static void ConfigureButtonInputs(Byte_t Mask)
+{
+   Byte_t Pins;
+
+   Pins   = (Byte_t)(ButtonMask | Mask);
+
+   P2IE  &= (Byte_t)~Pins;
+
+   P2REN &= (Byte_t)~(ButtonMask & ~Mask);
+
+   P2DIR &= (Byte_t)~Mask;
+   P2OUT |= Mask;
+   P2REN |= Mask;
+
+   /* Enable interrupts to wake the MSP430 from low power mode if       */
+   /* necessary.                                                        */
+   P2IES  = (Byte_t)((P2IES & ~Mask) | (P2IN & Mask));
+   P2IFG &= (Byte_t)~Pins;
+   P2IE  |= Mask;
+
+   ButtonMask = Mask;
+}
+
+   /* The following function is the scheduler function that polls the   */
+   /* button inputs.  A change of the button pin mask is applied here,  */
+   /* so it takes effect without a restart.                             */
+   /* * NOTE * A change of the poll period is applied by                */
+   /*          UpdateButtonPollPeriod() from the main loop, since a     */
+   /*          scheduler function must not delete itself from the       */
+   /*          scheduler.                                               */
+static void ButtonPollFunction(void *UserParameter)
+{
+   BTPSCONST Config_t *Config;
+
+   Config = Config_Get();
+
+   if(Config->ButtonMask != ButtonMask)
+      ConfigureButtonInputs(Config->ButtonMask);
+
+   port2_poll();
+
+   /* Blinking LEDs are advanced at the button poll period.             */
+   Control_Process((DWord_t)HAL_GetTickCount());
+}
+
+   /* The following function is responsible for applying a change of the*/
+   /* configured button poll period.  The button poll function is added */
+   /* to the scheduler again with the new period.                       */
+   /* * NOTE * This function is called from the main loop (outside of   */
+   /*          the scheduler).  If the function cannot be added with the*/
+   /*          new period it is added back with the previous one, so the*/
+   /*          buttons are never left unpolled.                         */
+static void UpdateButtonPollPeriod(void)
+{
+   Word_t Period;
+
+   Period = Config_Get()->ButtonPollPeriod;
+
+   if(Period != ButtonPollPeriod)
+   {
+      BTPS_DeleteFunctionFromScheduler(ButtonPollFunction, NULL);
+
+      if(BTPS_AddFunctionToScheduler(ButtonPollFunction, NULL, Period))
+      {
+         ButtonPollPeriod = Period;
+
+         Display(("Button Poll Period: %u ms.\r\n", ButtonPollPeriod));
+      }
+      else
+         BTPS_AddFunctionToScheduler(ButtonPollFunction, NULL, ButtonPollPeriod);
+   }
+}
+
+   /* The following function is responsible for tracking the HCILL      */
+   /* State.  It counts the sleep and wake transitions and the time the */
+   /* controller is awake, the first parameter is the current System    */
+   /* Tick Count.                                                       */
+   /* * NOTE * This function is called wherever the state may have      */
+   /*          changed (on every policy sample and around LPM3), the    */
+   /*          scheduler does not run while the MSP430 is in LPM3 so    */
+   /*          sampling alone only sees the controller while we are     */
+   /*          awake.                                                   */
+static void HCILLTrackState(DWord_t TimeStamp)
+{
+   HCILL_State_t HCILL_State;
+
+   HCILL_State = HCILL_GetState();
+   if(HCILL_State != HCILLLastState)
+   {
+      if(HCILL_State == hsSleep)
+      {
+         HCILLSleepCount++;
+
+         /* Account the time the controller was awake (only the part    */
+         /* that falls into the current window).                        */
+         HCILLWindowAwakeTime += TimeStamp - (((long)(HCILLAwakeSince - HCILLWindowStart) > 0)?HCILLAwakeSince:HCILLWindowStart);
+      }
+      else
+      {
+         if(HCILLLastState == hsSleep)
+         {
+            HCILLWakeCount++;
+            HCILLWindowWakes++;
+
+            HCILLAwakeSince = TimeStamp;
+         }
+      }
+
+      HCILLLastState = HCILL_State;
+   }
+}
+
+   /* The following function is responsible for tracking the HCILL State*/
+   /* and adapting the HCILL inactivity timeout to the observed traffic */
+   /* (see HCILL_POLICY_WINDOW).                                        */
+static void HCILLPolicyFunction(void *UserParameter)
+{
+   DWord_t             TimeStamp;
+   DWord_t             Elapsed;
+   unsigned int        InactivityTimeout;
+   BTPSCONST Config_t *Config;
+
+   TimeStamp = (DWord_t)HAL_GetTickCount();
+
+   HCILLTrackState(TimeStamp);
+
+   /* Re-evaluate the inactivity timeout at the end of every window.    */
+   if((Elapsed = TimeStamp - HCILLWindowStart) >= HCILL_POLICY_WINDOW)
+   {
+      /* Account the time the controller has been awake so far if it is */
+      /* still awake.                                                   */
+      if(HCILLLastState != hsSleep)
+         HCILLWindowAwakeTime += TimeStamp - (((long)(HCILLAwakeSince - HCILLWindowStart) > 0)?HCILLAwakeSince:HCILLWindowStart);
+
+      InactivityTimeout = HCILLInactivityTimeout;
+
+      if(HCILLWindowWakes >= HCILL_POLICY_BURST_WAKES)
+      {
+         /* Bursty traffic, stay awake longer between packets.          */
+         InactivityTimeout <<= 1;
+      }
+      else
+      {
+         if((HCILLWindowAwakeTime * 100) <= (Elapsed * HCILL_POLICY_IDLE_AWAKE_PERCENT))
+         {
+            /* Idle, go back to sleep sooner after the next event.      */
+            InactivityTimeout >>= 1;
+         }
+      }
+
+      /* Keep the timeout within the configured bounds (which may have  */
+      /* changed since the previous window).                            */
+      Config = Config_Get();
+
+      if(InactivityTimeout > Config->HCILLTimeoutMax)
+         InactivityTimeout = Config->HCILLTimeoutMax;
+
+      if(InactivityTimeout < Config->HCILLTimeoutMin)
+         InactivityTimeout = Config->HCILLTimeoutMin;
+
+      /* Only reconfigure the controller if the timeout changed.        */
+      if(InactivityTimeout != HCILLInactivityTimeout)
+      {
+         if(!HCILL_Configure(BluetoothStackID, InactivityTimeout, HCILL_MODE_RETRANSMIT_TIMEOUT, TRUE))
+         {
+            HCILLInactivityTimeout = InactivityTimeout;
+
+            Display(("HCILL Inactivity Timeout: %u ms (Sleeps: %lu, Wakes: %lu).\r\n", HCILLInactivityTimeout, (unsigned long)HCILLSleepCount, (unsigned long)HCILLWakeCount));
+         }
+      }
+
+      HCILLWindowStart     = TimeStamp;
+      HCILLWindowWakes     = 0;
+      HCILLWindowAwakeTime = 0;
+   }
+}
+
+   /* The following function is responsible for checking the idle state */
+   /* and possibly entering LPM3 mode.                                  */
+static void IdleFunction(void *UserParameter)
+{
+   /* Determine the HCILL State.                                        */
+   HCILLTrackState((DWord_t)HAL_GetTickCount());
+
+   /* If the stack is Idle and we are in HCILL Sleep, then we may enter */
+   /* LPM3 mode (with Timer Interrupts disabled).                       */
+   if((BSC_QueryStackIdle(BluetoothStackID)) && (HCILLLastState == hsSleep) && (!HCILL_Get_Power_Lock_Count()))
+   {
+      /* Write a changed configuration to flash now that no HCI traffic */
+      /* is expected (see Config_Flush()).                              */
+      Config_Flush();
+
+      /* Enter MSP430 LPM3 with Timer Interrupts disabled (we will      */
+      /* require an interrupt to wake us up from this state).           */
+
+	  // dont go to sleep
+      HAL_LowPowerMode((unsigned char)FALSE);
+
+      /* Whatever woke us up, count the wake of the controller (if it   */
+      /* was one) when it happens rather than at the next sample.       */
+      HCILLTrackState((DWord_t)HAL_GetTickCount());
+   }
+}
+
+   /* The following function is responsible for initializing the        */
+   /* application and starting the functions that are scheduled by this */
+   /* module.  This function returns TRUE if the application is running */
+   /* or FALSE otherwise.                                               */
+static Boolean_t StartApplication(HCI_DriverInformation_t *HCI_DriverInformation, BTPS_Initialization_t *BTPS_Initialization)
+{
+   int       Result;
+   Boolean_t ret_val = FALSE;
+
+   /* Measure the time it takes until we are advertising.               */
+   BootTime_Start();
+
+   /* Initialize the application.                                       */
+   if((Result = InitializeApplication(HCI_DriverInformation, BTPS_Initialization)) > 0)
+   {
+      /* Save the Bluetooth Stack ID.                                   */
+      BluetoothStackID = (unsigned int)Result;
+
+      /* Go ahead an enable HCILL Mode.                                 */
+      HCILL_Init();
+      HCILL_Configure(BluetoothStackID, HCILL_MODE_INACTIVITY_TIMEOUT, HCILL_MODE_RETRANSMIT_TIMEOUT, TRUE);
+
+      /* Start the adaptive HCILL policy from the default timeout.      */
+      HCILLInactivityTimeout  = HCILL_MODE_INACTIVITY_TIMEOUT;
+      HCILLLastState          = HCILL_GetState();
+      HCILLAwakeSince         = (DWord_t)HAL_GetTickCount();
+      HCILLWindowStart        = HCILLAwakeSince;
+      HCILLWindowWakes        = 0;
+      HCILLWindowAwakeTime    = 0;
+
+      if(!BTPS_AddFunctionToScheduler(HCILLPolicyFunction, NULL, HCILL_POLICY_SAMPLE_PERIOD))
+         Display(("Unable to start the adaptive HCILL policy.\r\n"));
+
+      // add our polling function to the scheduler
+	  // period = configured button poll period
+	  ButtonPollPeriod = Config_Get()->ButtonPollPeriod;
+
+	  if(BTPS_AddFunctionToScheduler(ButtonPollFunction, NULL, ButtonPollPeriod))
+	  {
+        /* Add the idle function (which determines if LPM3 may be entered)*/
+		/* to the scheduler.                                              */
+		if(BTPS_AddFunctionToScheduler(IdleFunction, NULL, HCILL_MODE_INACTIVITY_TIMEOUT))
+		   ret_val = TRUE;
+	  }
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for stopping the functions  */
+   /* that are scheduled by this module and shutting down the           */
+   /* application, so that it can be started again in place.            */
+static void StopApplication(void)
+{
+   BTPS_DeleteFunctionFromScheduler(IdleFunction, NULL);
+   BTPS_DeleteFunctionFromScheduler(ButtonPollFunction, NULL);
+   BTPS_DeleteFunctionFromScheduler(HCILLPolicyFunction, NULL);
+
+   ShutdownApplication();
+
+   BluetoothStackID = 0;
+}
+
+   /* The following function is the main user interface thread.  It     */
+   /* opens the Bluetooth Stack and then drives the main user           */
+   /* interface.  If the application fails it is restarted in place,    */
+   /* this function only returns after repeated failures (see           */
+   /* MAX_RESTART_ATTEMPTS).                                            */
+static void MainThread(void)
+{
+   unsigned int            Attempts;
+   unsigned long           StartTime;
+   BTPS_Initialization_t   BTPS_Initialization;
+   HCI_DriverInformation_t HCI_DriverInformation;
+
+   /* Configure the UART Parameters.                                    */
+   HCI_DRIVER_SET_COMM_INFORMATION(&HCI_DriverInformation, 1, 115200, cpUART);
+   HCI_DriverInformation.DriverInformation.COMMDriverInformation.InitializationDelay = 100;
+
+   /* Set up the application callbacks.                                 */
+   BTPS_Initialization.GetTickCountCallback  = GetTickCallback;
+   BTPS_Initialization.MessageOutputCallback = DisplayCallback;
+
+   Attempts = 0;
+
+   while(Attempts < MAX_RESTART_ATTEMPTS)
+   {
+      StartTime = HAL_GetTickCount();
+
+      if(StartApplication(&HCI_DriverInformation, &BTPS_Initialization))
+      {
+         /* Execute the scheduler until the application fails.          */
+         while(!QueryApplicationFailed())
+         {
+            BTPS_ExecuteScheduler();
+
+            UpdateButtonPollPeriod();
+         }
+      }
+
+      /* Only failures that follow each other quickly count towards the */
+      /* software POR.                                                  */
+      if((HAL_GetTickCount() - StartTime) >= RESTART_STABLE_TIME)
+         Attempts = 0;
+
+      Attempts++;
+
+      Display(("Application failed (%u/%u).\r\n", Attempts, MAX_RESTART_ATTEMPTS));
+
+      StopApplication();
+
+      BTPS_Delay(RESTART_DELAY);
+   }
+}
+
+   /* The following is the Main application entry point.  This function */
+   /* will configure the hardware and initialize the OS Abstraction     */
+   /* layer, create the Main application thread and start the scheduler.*/
+int main(void)
+{
+   /* Turn off the watchdog timer                                       */
+   WDTCTL = WDTPW | WDTHOLD;
+
+   /* Paint the unused stack (interrupts are still disabled) so that the*/
+   /* peak stack usage can be monitored.                                */
+   MemoryUsage_Paint_Stack();
+
+   /* Configure the hardware for its intended use.                      */
+   HAL_ConfigureHardware();
+
+   /* Load the configuration that is stored in flash.                   */
+   Config_Initialize();
+
+   // init hardware inputs
+   ConfigureButtonInputs(Config_Get()->ButtonMask);
+
+   Input_Initialize();
+
+   Control_Initialize();
+
+   /* Enable interrupts and call the main application thread.           */
+   __enable_interrupt();
+   MainThread();
+
+   Display(("Something went wrong, initiating software POR\r\n"));
+
+   	/* MainThread should run continously, if it exits an error occured.  */
+   	int i;
+   	for(i = 0; i < 40; i++)
+   	{
+   		HAL_LedToggle(0);
+   		BTPS_Delay(100);
+   	}
+
+   	// do a software POR reset
+   	PMMCTL0 = PMMPW + PMMSWPOR + (PMMCTL0 & 0x0003);
+}
+
+
@@ -1,39 +1,51 @@
-/*****< main.c >***************************************************************/
-/*      Copyright 2001 - 2012 Stonestreet One.                                */
-/*      All Rights Reserved.                                                  */
-/*                                                                            */
-/*  MAIN - Stonestreet One main sample application header.                    */
-/*                                                                            */
-/*  Author:  Tim Cook                                                         */
-/*                                                                            */
-/*** MODIFICATION HISTORY *****************************************************/
-/*                                                                            */
-/*   mm/dd/yy  F. Lastname    Description of Modification                     */
-/*   --------  -----------    ------------------------------------------------*/
-/*   10/28/11  T. Cook        Initial creation.                               */
-/******************************************************************************/
-#ifndef __MAIN_H__
-#define __MAIN_H__
-
-#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
-#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
-
-   /* Error Return Codes.                                               */
-
-   /* Error Codes that are smaller than these (less than -1000) are     */
-   /* related to the Bluetooth Protocol Stack itself (see BTERRORS.H).  */
-#define APPLICATION_ERROR_INVALID_PARAMETERS             (-1000)
-#define APPLICATION_ERROR_UNABLE_TO_OPEN_STACK           (-1001)
-
-   /* The following function is used to initialize the application      */
-   /* instance.  This function should open the stack and prepare to     */
-   /* execute commands based on user input.  The first parameter passed */
-   /* to this function is the HCI Driver Information that will be used  */
-   /* when opening the stack and the second parameter is used to pass   */
-   /* parameters to BTPS_Init.  This function returns the               */
-   /* BluetoothStackID returned from BSC_Initialize on success or a     */
-   /* negative error code (of the form APPLICATION_ERROR_XXX).          */
-int InitializeApplication(HCI_DriverInformation_t *HCI_DriverInformation, BTPS_Initialization_t *BTPS_Initialization);
-
-#endif
-
+/*****< main.c >***************************************************************/
+/*      Copyright 2001 - 2012 Stonestreet One.                                */
+/*      All Rights Reserved.                                                  */
+/*                                                                            */
+/*  MAIN - Stonestreet One main sample application header.                    */
+/*                                                                            */
+/*  Author:  Tim Cook                                                         */
+/*                                                                            */
+/*** MODIFICATION HISTORY *****************************************************/
+/*                                                                            */
+/*   mm/dd/yy  F. Lastname    Description of Modification                     */
+/*   --------  -----------    ------------------------------------------------*/
+/*   10/28/11  T. Cook        Initial creation.                               */
+/******************************************************************************/
+#ifndef __MAIN_H__
+#define __MAIN_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+   /* Error Return Codes.                                               */
+
+   /* Error Codes that are smaller than these (less than -1000) are     */
+   /* related to the Bluetooth Protocol Stack itself (see BTERRORS.H).  */
+#define APPLICATION_ERROR_INVALID_PARAMETERS             (-1000)
+#define APPLICATION_ERROR_UNABLE_TO_OPEN_STACK           (-1001)
+
+   /* The following function is used to initialize the application      */
+   /* instance.  This function should open the stack and prepare to     */
+   /* execute commands based on user input.  The first parameter passed */
+   /* to this function is the HCI Driver Information that will be used  */
+   /* when opening the stack and the second parameter is used to pass   */
+   /* parameters to BTPS_Init.  This function returns the               */
+   /* BluetoothStackID returned from BSC_Initialize on success or a     */
+   /* negative error code (of the form APPLICATION_ERROR_XXX).          */
+int InitializeApplication(HCI_DriverInformation_t *HCI_DriverInformation, BTPS_Initialization_t *BTPS_Initialization);
+
+   /* The following function is used to shut down the application       */
+   /* instance (closing the stack), so that it can be initialized again */
+   /* in place with InitializeApplication().  The bonds and the         */
+   /* configuration of the application are retained.                    */
+void ShutdownApplication(void);
+
+   /* The following function is used to determine whether the           */
+   /* application instance has failed in a way that it cannot recover   */
+   /* from on its own.  This function returns TRUE if the application   */
+   /* should be shut down and initialized again.                        */
+Boolean_t QueryApplicationFailed(void);
+
+#endif
+
@@ -0,0 +1,74 @@
+/*****< memoryusage.c >********************************************************/
+/*                                                                            */
+/*  MEMORYUSAGE - Stack and Bluetopia heap usage monitoring.                  */
+/*                                                                            */
+/******************************************************************************/
+#include "HAL.h"                 /* Function for Hardware Abstraction.        */
+#include "MemoryUsage.h"         /* Memory Usage Prototypes/Constants.        */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+#define Display(_x)                                do { BTPS_OutputMessage _x; } while(0)
+
+#define STACK_PAINT_PATTERN                     (0xA5)   /* Denotes the byte  */
+                                                         /* that unused stack*/
+                                                         /* is painted with. */
+
+   /* The following symbols delimit the system stack.  _stack is the    */
+   /* (lowest) address of the .stack section (allocated by the run-time */
+   /* boot code) and __STACK_END is the address following it (defined by*/
+   /* the linker).                                                      */
+extern char _stack;
+extern char __STACK_END;
+
+   /* The following function paints the unused part of the stack.       */
+   /* * NOTE * The stack grows downwards, everything below the current  */
+   /*          stack pointer is unused.  Interrupts are disabled so     */
+   /*          nothing is pushed while painting.                        */
+void MemoryUsage_Paint_Stack(void)
+{
+   volatile Byte_t *Address;
+
+   for(Address = (volatile Byte_t *)&_stack; Address < (volatile Byte_t *)__get_SP_register(); Address++)
+      *Address = STACK_PAINT_PATTERN;
+}
+
+   /* The following function determines the memory usage.  The stack    */
+   /* peak is the part of the stack above the lowest byte that no longer*/
+   /* holds the paint pattern.                                          */
+void MemoryUsage_Query(MemoryUsage_t *MemoryUsage)
+{
+   Byte_t                  *Address;
+   BTPS_MemoryStatistics_t  MemoryStatistics;
+
+   if(MemoryUsage)
+   {
+      BTPS_MemInitialize(MemoryUsage, 0, MEMORY_USAGE_DATA_SIZE);
+
+      MemoryUsage->StackSize = (Word_t)(&__STACK_END - &_stack);
+      MemoryUsage->StackUsed = (Word_t)(&__STACK_END - (char *)__get_SP_register());
+
+      for(Address = (Byte_t *)&_stack; (Address < (Byte_t *)&__STACK_END) && (*Address == STACK_PAINT_PATTERN); Address++)
+         ;
+
+      MemoryUsage->StackPeak = (Word_t)((Byte_t *)&__STACK_END - Address);
+
+      if(!BTPS_QueryMemoryUsage(&MemoryStatistics, TRUE))
+      {
+         MemoryUsage->HeapSize        = (Word_t)MemoryStatistics.HeapSize;
+         MemoryUsage->HeapUsed        = (Word_t)MemoryStatistics.CurrentHeapUsed;
+         MemoryUsage->HeapPeak        = (Word_t)MemoryStatistics.MaximumHeapUsed;
+         MemoryUsage->HeapLargestFree = (Word_t)MemoryStatistics.LargestFreeFragment;
+      }
+   }
+}
+
+   /* The following function displays the memory usage.                 */
+void MemoryUsage_Display(void)
+{
+   MemoryUsage_t MemoryUsage;
+
+   MemoryUsage_Query(&MemoryUsage);
+
+   Display(("Stack: %u/%u bytes (peak %u)\r\n", MemoryUsage.StackUsed, MemoryUsage.StackSize, MemoryUsage.StackPeak));
+   Display(("Heap:  %u/%u bytes (peak %u, largest free %u)\r\n", MemoryUsage.HeapUsed, MemoryUsage.HeapSize, MemoryUsage.HeapPeak, MemoryUsage.HeapLargestFree));
+}
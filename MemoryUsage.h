@@ -0,0 +1,44 @@
+/*****< memoryusage.h >********************************************************/
+/*                                                                            */
+/*  MEMORYUSAGE - Stack and Bluetopia heap usage monitoring.                  */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __MEMORYUSAGE_H__
+#define __MEMORYUSAGE_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following structure holds the current and peak (high-water    */
+   /* mark) usage, in bytes, of the system stack and of the Bluetopia   */
+   /* heap (the memory pool of BTPSKRNL).  The stack peak is only       */
+   /* tracked from the moment the stack was painted (see                */
+   /* MemoryUsage_Paint_Stack()).                                       */
+typedef struct _tagMemoryUsage_t
+{
+   Word_t StackSize;
+   Word_t StackUsed;
+   Word_t StackPeak;
+   Word_t HeapSize;
+   Word_t HeapUsed;
+   Word_t HeapPeak;
+   Word_t HeapLargestFree;
+} MemoryUsage_t;
+
+#define MEMORY_USAGE_DATA_SIZE                           (sizeof(MemoryUsage_t))
+
+   /* The following function paints the unused part of the system stack */
+   /* with a known pattern so that the peak stack usage can be          */
+   /* determined later.  This function must be called with interrupts   */
+   /* disabled, as early as possible after reset.                       */
+void MemoryUsage_Paint_Stack(void);
+
+   /* The following function determines the current and peak usage of   */
+   /* the system stack and of the Bluetopia heap.  The parameter is a   */
+   /* pointer to the structure that receives the usage.                 */
+void MemoryUsage_Query(MemoryUsage_t *MemoryUsage);
+
+   /* The following function displays the current and peak usage of the */
+   /* system stack and of the Bluetopia heap on the debug console.      */
+void MemoryUsage_Display(void);
+
+#endif
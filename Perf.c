@@ -0,0 +1,137 @@
+/*****< perf.c >***************************************************************/
+/*                                                                            */
+/*  PERF - GATT server load and throughput counters.                          */
+/*                                                                            */
+/******************************************************************************/
+#include "HAL.h"                 /* Function for Hardware Abstraction.        */
+#include "Perf.h"                /* Performance Counter Prototypes/Constants. */
+#include "BTPSKRNL.h"            /* BTPS Kernel Prototypes/Constants.         */
+
+#define Display(_x)                                do { BTPS_OutputMessage _x; } while(0)
+
+   /* The following MACROs are used to name the registers of the        */
+   /* PERF_TIMER (e.g. PERF_TIMER_REGISTER(TB0, R) is TB0R).  The extra */
+   /* level of indirection expands a timer that is itself a MACRO first.*/
+#define PERF_TIMER_REGISTER(_Timer, _Register)     PERF_TIMER_REGISTER_(_Timer, _Register)
+#define PERF_TIMER_REGISTER_(_Timer, _Register)    _Timer##_Register
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the compiler*/
+   /* as part of standard C/C++).                                       */
+
+static Perf_Statistics_t Statistics;                /* Counters of the current*/
+                                                    /* measurement period.    */
+
+static BTPSCONST char *RequestNames[PERF_NUMBER_OF_REQUESTS] =
+{
+   "Read",
+   "Write"
+};
+
+   /* Internal Function Prototypes.                                     */
+static unsigned long Rate(DWord_t Count, DWord_t Elapsed);
+static unsigned long Microseconds(DWord_t Time);
+
+   /* The following function calculates the rate (per second) of the    */
+   /* specified count over the specified elapsed time (in milliseconds).*/
+static unsigned long Rate(DWord_t Count, DWord_t Elapsed)
+{
+   unsigned long ret_val;
+
+   if(Elapsed)
+   {
+      /* Avoid overflowing the multiplication for large counts.         */
+      if(Count < 0x00400000)
+         ret_val = (unsigned long)((Count * 1000) / Elapsed);
+      else
+         ret_val = (unsigned long)(Count / ((Elapsed + 999) / 1000));
+   }
+   else
+      ret_val = 0;
+
+   return(ret_val);
+}
+
+   /* The following function converts the specified time (in PERF_TIMER */
+   /* counts) to microseconds.                                          */
+static unsigned long Microseconds(DWord_t Time)
+{
+   /* Split the conversion so that the multiplication cannot overflow   */
+   /* (1000000 / PERF_TIMER_FREQUENCY is 15625 / 512).                  */
+   return((unsigned long)(((Time / PERF_TIMER_FREQUENCY) * 1000000) + (((Time % PERF_TIMER_FREQUENCY) * 15625) / (PERF_TIMER_FREQUENCY / 64))));
+}
+
+   /* The following function starts a new measurement period (and starts*/
+   /* the PERF_TIMER).                                                  */
+void Perf_Reset(void)
+{
+   BTPS_MemInitialize(&Statistics, 0, PERF_STATISTICS_DATA_SIZE);
+
+   Statistics.StartTimeStamp = BTPS_GetTickCount();
+
+   /* ACLK, continuous mode, no interrupts.                             */
+   PERF_TIMER_REGISTER(PERF_TIMER, CTL) = (TBSSEL_1 | MC_2);
+}
+
+   /* The following function returns the current PERF_TIMER count.      */
+Word_t Perf_Get_Time(void)
+{
+   return((Word_t)PERF_TIMER_REGISTER(PERF_TIMER, R));
+}
+
+   /* The following function counts a GATT server request.              */
+void Perf_Count_Request(Perf_Request_t Request)
+{
+   if((unsigned int)Request < PERF_NUMBER_OF_REQUESTS)
+      Statistics.Requests[Request]++;
+}
+
+   /* The following function counts a submitted notification.           */
+void Perf_Count_Notification(Word_t Length, Boolean_t Sent)
+{
+   if(Sent)
+   {
+      Statistics.Notifications++;
+      Statistics.NotificationBytes += Length;
+   }
+   else
+      Statistics.NotificationFailures++;
+}
+
+   /* The following function counts the execution of a callback.        */
+void Perf_Count_Callback(Word_t StartTime)
+{
+   Word_t Time;
+
+   /* The 16 bit difference is correct across a wrap of the timer.      */
+   Time = (Word_t)(Perf_Get_Time() - StartTime);
+
+   Statistics.CallbackCount++;
+   Statistics.CallbackTime += Time;
+
+   if(Time > Statistics.CallbackMaximum)
+      Statistics.CallbackMaximum = Time;
+}
+
+   /* The following function returns the counters.                      */
+Perf_Statistics_t *Perf_Get_Statistics(void)
+{
+   return(&Statistics);
+}
+
+   /* The following function displays the counters.                     */
+void Perf_Display(void)
+{
+   unsigned int Index;
+   DWord_t      Elapsed;
+
+   Elapsed = BTPS_GetTickCount() - Statistics.StartTimeStamp;
+
+   Display(("Period:        %lu ms\r\n", (unsigned long)Elapsed));
+
+   for(Index = 0; Index < PERF_NUMBER_OF_REQUESTS; Index++)
+      Display(("%-5s Requests: %lu (%lu/s)\r\n", RequestNames[Index], (unsigned long)Statistics.Requests[Index], Rate(Statistics.Requests[Index], Elapsed)));
+
+   Display(("Notifications: %lu (%lu/s, %lu bytes/s), %lu refused\r\n", (unsigned long)Statistics.Notifications, Rate(Statistics.Notifications, Elapsed), Rate(Statistics.NotificationBytes, Elapsed), (unsigned long)Statistics.NotificationFailures));
+   Display(("Callbacks:     %lu, total=%luus max=%luus\r\n", (unsigned long)Statistics.CallbackCount, Microseconds(Statistics.CallbackTime), Microseconds(Statistics.CallbackMaximum)));
+}
@@ -0,0 +1,84 @@
+/*****< perf.h >***************************************************************/
+/*                                                                            */
+/*  PERF - GATT server load and throughput counters.                          */
+/*                                                                            */
+/******************************************************************************/
+#ifndef __PERF_H__
+#define __PERF_H__
+
+#include "SS1BTPS.h"             /* Main SS1 Bluetooth Stack Header.          */
+
+   /* The following enumerates the GATT server requests that are        */
+   /* counted.                                                          */
+typedef enum
+{
+   prReadRequest,
+   prWriteRequest
+} Perf_Request_t;
+
+#define PERF_NUMBER_OF_REQUESTS                          (2)
+
+   /* The following may be defined (project wide) to select the timer   */
+   /* that measures the callback time.  The timer is run from ACLK      */
+   /* (PERF_TIMER_FREQUENCY Hz) in continuous mode without interrupts,  */
+   /* so it keeps counting in LPM3 and never wakes the MSP430.          */
+#ifndef PERF_TIMER
+#define PERF_TIMER                                       TB0
+#endif
+
+#define PERF_TIMER_FREQUENCY                             (32768)
+
+   /* The following structure holds the counters of the current         */
+   /* measurement period (which starts at the last call to              */
+   /* Perf_Reset()).  The callback time is measured in counts of the    */
+   /* PERF_TIMER (1/PERF_TIMER_FREQUENCY seconds).                      */
+typedef struct _tagPerf_Statistics_t
+{
+   DWord_t StartTimeStamp;
+   DWord_t Requests[PERF_NUMBER_OF_REQUESTS];
+   DWord_t Notifications;
+   DWord_t NotificationBytes;
+   DWord_t NotificationFailures;
+   DWord_t CallbackCount;
+   DWord_t CallbackTime;
+   DWord_t CallbackMaximum;
+} Perf_Statistics_t;
+
+#define PERF_STATISTICS_DATA_SIZE                        (sizeof(Perf_Statistics_t))
+
+   /* The following function clears all counters and starts a new       */
+   /* measurement period.                                               */
+void Perf_Reset(void);
+
+   /* The following function counts a GATT server request of the        */
+   /* specified type.                                                   */
+void Perf_Count_Request(Perf_Request_t Request);
+
+   /* The following function counts a notification that was submitted to*/
+   /* GATT.  The first parameter is the length of the notification value*/
+   /* and the second specifies whether GATT accepted the notification.  */
+void Perf_Count_Notification(Word_t Length, Boolean_t Sent);
+
+   /* The following function returns the current count of the           */
+   /* PERF_TIMER, which is used to mark the entry of a callback (see    */
+   /* Perf_Count_Callback()).                                           */
+Word_t Perf_Get_Time(void);
+
+   /* The following function counts the execution of a Bluetooth        */
+   /* callback.  The parameter is the PERF_TIMER count at which the     */
+   /* callback was entered (see Perf_Get_Time()), the callback time is  */
+   /* the difference to the current count.                              */
+   /* * NOTE * A callback must not take longer than one period of the 16*/
+   /*          bit timer (two seconds) to be measured correctly.        */
+void Perf_Count_Callback(Word_t StartTime);
+
+   /* The following function returns a pointer to the counters of the   */
+   /* current measurement period.                                       */
+Perf_Statistics_t *Perf_Get_Statistics(void);
+
+   /* The following function displays the counters of the current       */
+   /* measurement period, together with the request and notification    */
+   /* rates, on the debug console.                                      */
+void Perf_Display(void);
+
+#endif
@@ -1,2081 +1,4395 @@
-/*****< sppledemo.c >**********************************************************/
-/*      Copyright 2001 - 2012 Stonestreet One.                                */
-/*      All Rights Reserved.                                                  */
-/*                                                                            */
-/*  SPPLEDEMO - Embedded Bluetooth SPP Emulation using GATT (LE) application. */
-/*                                                                            */
-/*  Author:  Tim Cook                                                         */
-/*                                                                            */
-/*** MODIFICATION HISTORY *****************************************************/
-/*                                                                            */
-/*   mm/dd/yy  F. Lastname    Description of Modification                     */
-/*   --------  -----------    ------------------------------------------------*/
-/*   04/16/12  Tim Cook       Initial creation.                               */
-/******************************************************************************/
-#include <stdio.h>               /* Included for sscanf.                      */
-#include "Main.h"                /* Application Interface Abstraction.        */
-#include "SPPLEDemo.h"           /* Application Header.                       */
-#include "SS1BTPS.h"             /* Main SS1 BT Stack Header.                 */
-#include "SS1BTGAT.h"            /* Main SS1 GATT Header.                     */
-#include "SS1BTGAP.h"            /* Main SS1 GAP Service Header.              */
-#include "BTPSKRNL.h"            /* BTPS Kernel Header.                       */
-#include "HAL.h"                 /* Function for Hardware Abstraction.        */
-
-#define MAX_SUPPORTED_COMMANDS                     (64)  /* Denotes the       */
-                                                         /* maximum number of */
-                                                         /* User Commands that*/
-                                                         /* are supported by  */
-                                                         /* this application. */
-
-#define MAX_NUM_OF_PARAMETERS                       (5)  /* Denotes the max   */
-                                                         /* number of         */
-                                                         /* parameters a      */
-                                                         /* command can have. */
-
-#define MAX_INQUIRY_RESULTS                         (5)  /* Denotes the max   */
-                                                         /* number of inquiry */
-                                                         /* results.          */
-
-#define MAX_SUPPORTED_LINK_KEYS                    (1)   /* Max supported Link*/
-                                                         /* keys.             */
-
-#define SPPLE_DATA_BUFFER_LENGTH  (BTPS_CONFIGURATION_GATT_MAXIMUM_SUPPORTED_MTU_SIZE)
-                                                         /* Defines the length*/
-                                                         /* of a SPPLE Data   */
-                                                         /* Buffer.           */
-
-#define SPPLE_DATA_CREDITS        (SPPLE_DATA_BUFFER_LENGTH*1) /* Defines the */
-                                                         /* number of credits */
-                                                         /* in an SPPLE Buffer*/
-
-#define DEFAULT_PIN_CODE                         "0000"  /* Default PIN Code  */
-                                                         /* used by this app. */
-   
-
-#define NO_COMMAND_ERROR                           (-1)  /* Denotes that no   */
-                                                         /* command was       */
-                                                         /* specified to the  */
-                                                         /* parser.           */
-
-#define INVALID_COMMAND_ERROR                      (-2)  /* Denotes that the  */
-                                                         /* Command does not  */
-                                                         /* exist for         */
-                                                         /* processing.       */
-
-#define EXIT_CODE                                  (-3)  /* Denotes that the  */
-                                                         /* Command specified */
-                                                         /* was the Exit      */
-                                                         /* Command.          */
-
-#define FUNCTION_ERROR                             (-4)  /* Denotes that an   */
-                                                         /* error occurred in */
-                                                         /* execution of the  */
-                                                         /* Command Function. */
-
-#define TO_MANY_PARAMS                             (-5)  /* Denotes that there*/
-                                                         /* are more          */
-                                                         /* parameters then   */
-                                                         /* will fit in the   */
-                                                         /* UserCommand.      */
-
-#define INVALID_PARAMETERS_ERROR                   (-6)  /* Denotes that an   */
-                                                         /* error occurred due*/
-                                                         /* to the fact that  */
-                                                         /* one or more of the*/
-                                                         /* required          */
-                                                         /* parameters were   */
-                                                         /* invalid.          */
-
-#define UNABLE_TO_INITIALIZE_STACK                 (-7)  /* Denotes that an   */
-                                                         /* error occurred    */
-                                                         /* while Initializing*/
-                                                         /* the Bluetooth     */
-                                                         /* Protocol Stack.   */
-
-#define INVALID_STACK_ID_ERROR                     (-8)  /* Denotes that an   */
-                                                         /* occurred due to   */
-                                                         /* attempted         */
-                                                         /* execution of a    */
-                                                         /* Command when a    */
-                                                         /* Bluetooth Protocol*/
-                                                         /* Stack has not been*/
-                                                         /* opened.           */
-
-#define UNABLE_TO_REGISTER_SERVER                  (-9)  /* Denotes that an   */
-                                                         /* error occurred    */
-                                                         /* when trying to    */
-                                                         /* create a Serial   */
-                                                         /* Port Server.      */
-
-#define EXIT_TEST_MODE                             (-10) /* Flags exit from   */
-                                                         /* Test Mode.        */
-
-#define EXIT_MODE                                  (-11) /* Flags exit from   */
-                                                         /* any Mode.         */
-
-   /* Determine the Name we will use for this compilation.              */
-#define LE_DEMO_DEVICE_NAME                        "SPPLEDemo"
-
-   /* Following converts a Sniff Parameter in Milliseconds to frames.   */
-#define MILLISECONDS_TO_BASEBAND_SLOTS(_x)         ((_x) / (0.625))
-
-
-#define Display(_x)                                do { BTPS_OutputMessage _x; } while(0)
-#define LOG_ERROR(_x)	Display(_x)
-#define LOG_DEBUG(_x)	Display(_x)
-#define LOG_INFO(_x)	Display(_x)
-
-   /* The following represent the possible values of UI_Mode variable.  */
-#define UI_MODE_IS_CLIENT      (2)
-#define UI_MODE_IS_SERVER      (1)
-#define UI_MODE_SELECT         (0)
-#define UI_MODE_IS_INVALID     (-1)
-
-   /* The following type definition represents the container type which */
-   /* holds the mapping between Bluetooth devices (based on the BD_ADDR)*/
-   /* and the Link Key (BD_ADDR <-> Link Key Mapping).                  */
-typedef struct _tagLinkKeyInfo_t
-{
-   BD_ADDR_t  BD_ADDR;
-   Link_Key_t LinkKey;
-} LinkKeyInfo_t;
-
-   /* The following type definition represents the structure which holds*/
-   /* all information about the parameter, in particular the parameter  */
-   /* as a string and the parameter as an unsigned int.                 */
-typedef struct _tagParameter_t
-{
-   char         *strParam;
-   SDWord_t      intParam;
-} Parameter_t;
-
-   /* The following type definition represents the structure which holds*/
-   /* a list of parameters that are to be associated with a command The */
-   /* NumberofParameters variable holds the value of the number of      */
-   /* parameters in the list.                                           */
-typedef struct _tagParameterList_t
-{
-   int         NumberofParameters;
-   Parameter_t Params[MAX_NUM_OF_PARAMETERS];
-} ParameterList_t;
-
-   /* The following type definition represents the structure which holds*/
-   /* the command and parameters to be executed.                        */
-typedef struct _tagUserCommand_t
-{
-   char            *Command;
-   ParameterList_t  Parameters;
-} UserCommand_t;
-
-   /* The following type definition represents the generic function     */
-   /* pointer to be used by all commands that can be executed by the    */
-   /* test program.                                                     */
-typedef int (*CommandFunction_t)(ParameterList_t *TempParam);
-
-   /* The following type definition represents the structure which holds*/
-   /* information used in the interpretation and execution of Commands. */
-typedef struct _tagCommandTable_t
-{
-   char              *CommandName;
-   CommandFunction_t  CommandFunction;
-} CommandTable_t;
-
-   /* Structure used to hold all of the GAP LE Parameters.              */
-typedef struct _tagGAPLE_Parameters_t
-{
-   GAP_LE_Connectability_Mode_t ConnectableMode;
-   GAP_Discoverability_Mode_t   DiscoverabilityMode;
-   GAP_LE_IO_Capability_t       IOCapability;
-   Boolean_t                    MITMProtection;
-   Boolean_t                    OOBDataPresent;
-} GAPLE_Parameters_t;
-
-#define GAPLE_PARAMETERS_DATA_SIZE                       (sizeof(GAPLE_Parameters_t))
-
-   /* The following structure holds status information about a send     */
-   /* process.                                                          */
-typedef struct _tagSend_Info_t
-{
-   DWord_t BytesToSend;
-   DWord_t BytesSent;
-} Send_Info_t;
-
-   /* The following defines the format of a SPPLE Data Buffer.          */
-typedef struct __tagSPPLE_Data_Buffer_t
-{
-   unsigned int  InIndex;
-   unsigned int  OutIndex;
-   unsigned int  BytesFree;
-   unsigned int  BufferSize;
-   Byte_t        Buffer[SPPLE_DATA_CREDITS];
-} SPPLE_Data_Buffer_t;
-
-   /* The following structure represents the information we will store  */
-   /* on a Discovered GAP Service.                                      */
-typedef struct _tagGAPS_Client_Info_t
-{
-   Word_t DeviceNameHandle;
-   Word_t DeviceAppearanceHandle;
-} GAPS_Client_Info_t;
-
-   /* The following structure holds information on known Device         */
-   /* Appearance Values.                                                */
-typedef struct _tagGAPS_Device_Appearance_Mapping_t
-{
-   Word_t  Appearance;
-   char   *String;
-} GAPS_Device_Appearance_Mapping_t;
-
-   /* The following structure for a Master is used to hold a list of    */
-   /* information on all paired devices. For slave we will not use this */
-   /* structure.                                                        */
-typedef struct _tagDeviceInfoInfo_t
-{
-   Byte_t                       Flags;
-   Byte_t                       EncryptionKeySize;
-   GAP_LE_Address_Type_t        ConnectionAddressType;
-   BD_ADDR_t                    ConnectionBD_ADDR;
-   Long_Term_Key_t              LTK;
-   Random_Number_t              Rand;
-   Word_t                       EDIV;
-   unsigned int                 TransmitCredits;
-   SPPLE_Data_Buffer_t          ReceiveBuffer;
-   SPPLE_Data_Buffer_t          TransmitBuffer;
-   GAPS_Client_Info_t           GAPSClientInfo;
-   SPPLE_Client_Info_t          ClientInfo;
-   SPPLE_Server_Info_t          ServerInfo;
-   struct _tagDeviceInfoInfo_t *NextDeviceInfoInfoPtr;
-} DeviceInfo_t;
-
-#define DEVICE_INFO_DATA_SIZE                            (sizeof(DeviceInfo_t))
-
-   /* Defines the bit mask flags that may be set in the DeviceInfo_t    */
-   /* structure.                                                        */
-#define DEVICE_INFO_FLAGS_LTK_VALID                         0x01
-#define DEVICE_INFO_FLAGS_SERVICE_DISCOVERY_OUTSTANDING     0x02
-
-   /* User to represent a structure to hold a BD_ADDR return from       */
-   /* BD_ADDRToStr.                                                     */
-typedef char BoardStr_t[16];
-
-                        /* The Encryption Root Key should be generated  */
-                        /* in such a way as to guarantee 128 bits of    */
-                        /* entropy.                                     */
-static BTPSCONST Encryption_Key_t ER = {0x28, 0xBA, 0xE1, 0x37, 0x13, 0xB2, 0x20, 0x45, 0x16, 0xB2, 0x19, 0xD0, 0x80, 0xEE, 0x4A, 0x51};
-
-                        /* The Identity Root Key should be generated    */
-                        /* in such a way as to guarantee 128 bits of    */
-                        /* entropy.                                     */
-static BTPSCONST Encryption_Key_t IR = {0x41, 0x09, 0xA0, 0x88, 0x09, 0x6B, 0x70, 0xC0, 0x95, 0x23, 0x3C, 0x8C, 0x48, 0xFC, 0xC9, 0xFE};
-
-                        /* The following keys can be regerenated on the */
-                        /* fly using the constant IR and ER keys and    */
-                        /* are used globally, for all devices.          */
-static Encryption_Key_t DHK;
-static Encryption_Key_t IRK;
-
-   /* Internal Variables to this Module (Remember that all variables    */
-   /* declared static are initialized to 0 automatically by the         */
-   /* compiler as part of standard C/C++).                              */
-
-static unsigned int        GAPSInstanceID;          /* Holds the Instance ID for the   */
-                                                    /* GAP Service.                    */
-
-static GAPLE_Parameters_t  LE_Parameters;           /* Holds GAP Parameters like       */
-                                                    /* Discoverability, Connectability */
-                                                    /* Modes.                          */
-
-static DeviceInfo_t       *DeviceInfoList;          /* Holds the list head for the     */
-                                                    /* device info list.               */
-
-static unsigned int        BluetoothStackID;        /* Variable which holds the Handle */
-                                                    /* of the opened Bluetooth Protocol*/
-                                                    /* Stack.                          */
-
-static BD_ADDR_t           ConnectionBD_ADDR;       /* Holds the BD_ADDR of the        */
-                                                    /* currently connected device.     */
-
-static unsigned int        ConnectionID;            /* Holds the Connection ID of the  */
-                                                    /* currently connected device.     */
-
-static BD_ADDR_t           CurrentCBRemoteBD_ADDR;  /* Variable which holds the        */
-                                                    /* current CB BD_ADDR of the device*/
-                                                    /* which is currently pairing or   */
-                                                    /* authenticating.                 */
-
-
-static LinkKeyInfo_t       LinkKeyInfo[MAX_SUPPORTED_LINK_KEYS]; /* Variable holds     */
-                                                    /* BD_ADDR <-> Link Keys for       */
-                                                    /* pairing.                        */
-
-static GAP_IO_Capability_t IOCapability;            /* Variable which holds the        */
-                                                    /* current I/O Capabilities that   */
-                                                    /* are to be used for Secure Simple*/
-                                                    /* Pairing.                        */
-
-static Boolean_t           MITMProtection;          /* Variable which flags whether or */
-                                                    /* not Man in the Middle (MITM)    */
-                                                    /* protection is to be requested   */
-                                                    /* during a Secure Simple Pairing  */
-                                                    /* procedure.                      */
-
-unsigned int ServiceID;
-
-   /* The following string table is used to map HCI Version information */
-   /* to an easily displayable version string.                          */
-static BTPSCONST char *HCIVersionStrings[] =
-{
-   "1.0b",
-   "1.1",
-   "1.2",
-   "2.0",
-   "2.1",
-   "3.0",
-   "4.0",
-   "Unknown (greater 4.0)"
-} ;
-
-#define NUM_SUPPORTED_HCI_VERSIONS              (sizeof(HCIVersionStrings)/sizeof(char *) - 1)
-
-static Boolean_t CreateNewDeviceInfoEntry(DeviceInfo_t **ListHead, GAP_LE_Address_Type_t ConnectionAddressType, BD_ADDR_t ConnectionBD_ADDR);
-static DeviceInfo_t *SearchDeviceInfoEntryByBD_ADDR(DeviceInfo_t **ListHead, BD_ADDR_t BD_ADDR);
-static DeviceInfo_t *DeleteDeviceInfoEntry(DeviceInfo_t **ListHead, BD_ADDR_t BD_ADDR);
-static void FreeDeviceInfoEntryMemory(DeviceInfo_t *EntryToFree);
-static void FreeDeviceInfoList(DeviceInfo_t **ListHead);
-
-static void BD_ADDRToStr(BD_ADDR_t Board_Address, BoardStr_t BoardStr);
-
-static void DisplayFunctionError(char *Function,int Status);
-static void DisplayFunctionSuccess(char *Function);
-
-static int OpenStack(HCI_DriverInformation_t *HCI_DriverInformation, BTPS_Initialization_t *BTPS_Initialization);
-static int CloseStack(void);
-
-static int SetDisc(void);
-static int SetConnect(void);
-static int SetPairable(void);
-
-static void ConfigureCapabilities(GAP_LE_Pairing_Capabilities_t *Capabilities);
-static int SlavePairingRequestResponse(BD_ADDR_t BD_ADDR);
-static int EncryptionInformationRequestResponse(BD_ADDR_t BD_ADDR, Byte_t KeySize, GAP_LE_Authentication_Response_Information_t *GAP_LE_Authentication_Response_Information);
-static int DeleteLinkKey(BD_ADDR_t BD_ADDR);
-
-static int PINCodeResponse(ParameterList_t *TempParam);
-static int AdvertiseLE(ParameterList_t *TempParam);
-
-   /* BTPS Callback function prototypes.                                */
-static void BTPSAPI GAP_LE_Event_Callback(unsigned int BluetoothStackID,GAP_LE_Event_Data_t *GAP_LE_Event_Data, unsigned long CallbackParameter);
-static void BTPSAPI GATT_ServerEventCallback(unsigned int BluetoothStackID, GATT_Server_Event_Data_t *GATT_ServerEventData, unsigned long CallbackParameter);
-static void BTPSAPI GATT_Connection_Event_Callback(unsigned int BluetoothStackID, GATT_Connection_Event_Data_t *GATT_Connection_Event_Data, unsigned long CallbackParameter);
-static void BTPSAPI GAP_Event_Callback(unsigned int BluetoothStackID, GAP_Event_Data_t *GAP_Event_Data, unsigned long CallbackParameter);
-
-   /* The following function adds the specified Entry to the specified  */
-   /* List.  This function allocates and adds an entry to the list that */
-   /* has the same attributes as parameters to this function.  This     */
-   /* function will return FALSE if NO Entry was added.  This can occur */
-   /* if the element passed in was deemed invalid or the actual List    */
-   /* Head was invalid.                                                 */
-   /* ** NOTE ** This function does not insert duplicate entries into   */
-   /*            the list.  An element is considered a duplicate if the */
-   /*            Connection BD_ADDR.  When this occurs, this function   */
-   /*            returns NULL.                                          */
-static Boolean_t CreateNewDeviceInfoEntry(DeviceInfo_t **ListHead, GAP_LE_Address_Type_t ConnectionAddressType, BD_ADDR_t ConnectionBD_ADDR)
-{
-   Boolean_t     ret_val = FALSE;
-   DeviceInfo_t *DeviceInfoPtr;
-
-   /* Verify that the passed in parameters seem semi-valid.             */
-   if((ListHead) && (!COMPARE_NULL_BD_ADDR(ConnectionBD_ADDR)))
-   {
-      /* Allocate the memory for the entry.                             */
-      if((DeviceInfoPtr = BTPS_AllocateMemory(sizeof(DeviceInfo_t))) != NULL)
-      {
-         /* Initialize the entry.                                       */
-         BTPS_MemInitialize(DeviceInfoPtr, 0, sizeof(DeviceInfo_t));
-         DeviceInfoPtr->ConnectionAddressType = ConnectionAddressType;
-         DeviceInfoPtr->ConnectionBD_ADDR     = ConnectionBD_ADDR;
-
-         ret_val = BSC_AddGenericListEntry_Actual(ekBD_ADDR_t, BTPS_STRUCTURE_OFFSET(DeviceInfo_t, ConnectionBD_ADDR), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, NextDeviceInfoInfoPtr), (void **)(ListHead), (void *)(DeviceInfoPtr));
-         if(!ret_val)
-         {
-            /* Failed to add to list so we should free the memory that  */
-            /* we allocated for the entry.                              */
-            BTPS_FreeMemory(DeviceInfoPtr);
-         }
-      }
-   }
-
-   return(ret_val);
-}
-
-   /* The following function searches the specified List for the        */
-   /* specified Connection BD_ADDR.  This function returns NULL if      */
-   /* either the List Head is invalid, the BD_ADDR is invalid, or the   */
-   /* Connection BD_ADDR was NOT found.                                 */
-static DeviceInfo_t *SearchDeviceInfoEntryByBD_ADDR(DeviceInfo_t **ListHead, BD_ADDR_t BD_ADDR)
-{
-   return(BSC_SearchGenericListEntry(ekBD_ADDR_t, (void *)(&BD_ADDR), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, ConnectionBD_ADDR), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, NextDeviceInfoInfoPtr), (void **)(ListHead)));
-}
-
-   /* The following function searches the specified Key Info List for   */
-   /* the specified BD_ADDR and removes it from the List.  This function*/
-   /* returns NULL if either the List Head is invalid, the BD_ADDR is   */
-   /* invalid, or the specified Entry was NOT present in the list.  The */
-   /* entry returned will have the Next Entry field set to NULL, and    */
-   /* the caller is responsible for deleting the memory associated with */
-   /* this entry by calling the FreeKeyEntryMemory() function.          */
-static DeviceInfo_t *DeleteDeviceInfoEntry(DeviceInfo_t **ListHead, BD_ADDR_t BD_ADDR)
-{
-   return(BSC_DeleteGenericListEntry(ekBD_ADDR_t, (void *)(&BD_ADDR), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, ConnectionBD_ADDR), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, NextDeviceInfoInfoPtr), (void **)(ListHead)));
-}
-
-   /* This function frees the specified Key Info Information member     */
-   /* memory.                                                           */
-static void FreeDeviceInfoEntryMemory(DeviceInfo_t *EntryToFree)
-{
-   BSC_FreeGenericListEntryMemory((void *)(EntryToFree));
-}
-
-   /* The following function deletes (and free's all memory) every      */
-   /* element of the specified Key Info List. Upon return of this       */
-   /* function, the Head Pointer is set to NULL.                        */
-static void FreeDeviceInfoList(DeviceInfo_t **ListHead)
-{
-   BSC_FreeGenericListEntryList((void **)(ListHead), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, NextDeviceInfoInfoPtr));
-}
-
-   /* The following function is responsible for converting data of type */
-   /* BD_ADDR to a string.  The first parameter of this function is the */
-   /* BD_ADDR to be converted to a string.  The second parameter of this*/
-   /* function is a pointer to the string in which the converted BD_ADDR*/
-   /* is to be stored.                                                  */
-static void BD_ADDRToStr(BD_ADDR_t Board_Address, BoardStr_t BoardStr)
-{
-   BTPS_SprintF((char *)BoardStr, "0x%02X%02X%02X%02X%02X%02X", Board_Address.BD_ADDR5, Board_Address.BD_ADDR4, Board_Address.BD_ADDR3, Board_Address.BD_ADDR2, Board_Address.BD_ADDR1, Board_Address.BD_ADDR0);
-}
-
-   /* Displays a function error message.                                */
-static void DisplayFunctionError(char *Function,int Status)
-{
-   Display(("%s Failed: %d.\r\n", Function, Status));
-}
-
-   /* Displays a function success message.                              */
-static void DisplayFunctionSuccess(char *Function)
-{
-   Display(("%s success.\r\n",Function));
-}
-
-   /* The following function is responsible for opening the SS1         */
-   /* Bluetooth Protocol Stack.  This function accepts a pre-populated  */
-   /* HCI Driver Information structure that contains the HCI Driver     */
-   /* Transport Information.  This function returns zero on successful  */
-   /* execution and a negative value on all errors.                     */
-static int OpenStack(HCI_DriverInformation_t *HCI_DriverInformation, BTPS_Initialization_t *BTPS_Initialization)
-{
-   int                           Result;
-   int                           ret_val = 0;
-   char                          BluetoothAddress[16];
-   Byte_t                        Status;
-   BD_ADDR_t                     BD_ADDR;
-   unsigned int                  ServiceID;
-   HCI_Version_t                 HCIVersion;
-   L2CA_Link_Connect_Params_t    L2CA_Link_Connect_Params;
-
-   /* First check to see if the Stack has already been opened.          */
-   if(!BluetoothStackID)
-   {
-      /* Next, makes sure that the Driver Information passed appears to */
-      /* be semi-valid.                                                 */
-      if(HCI_DriverInformation)
-      {
-         /* Initialize BTPSKNRl.                                        */
-         BTPS_Init((void *)BTPS_Initialization);
-
-         Display(("OpenStack().\r\n"));
-
-         /* Initialize the Stack                                        */
-         Result = BSC_Initialize(HCI_DriverInformation, 0);
-
-         /* Next, check the return value of the initialization to see   */
-         /* if it was successful.                                       */
-         if(Result > 0)
-         {
-            /* The Stack was initialized successfully, inform the user  */
-            /* and set the return value of the initialization function  */
-            /* to the Bluetooth Stack ID.                               */
-            BluetoothStackID = Result;
-            Display(("Bluetooth Stack ID: %d.\r\n", BluetoothStackID));
-
-            /* Initialize the Default Pairing Parameters.               */
-            LE_Parameters.IOCapability   = licNoInputNoOutput;
-            LE_Parameters.MITMProtection = FALSE;
-            LE_Parameters.OOBDataPresent = FALSE;
-
-            /* Initialize the default Secure Simple Pairing parameters. */
-            IOCapability                 = icNoInputNoOutput;
-            MITMProtection               = FALSE;
-
-            if(!HCI_Version_Supported(BluetoothStackID, &HCIVersion))
-               Display(("Device Chipset: %s.\r\n", (HCIVersion <= NUM_SUPPORTED_HCI_VERSIONS)?HCIVersionStrings[HCIVersion]:HCIVersionStrings[NUM_SUPPORTED_HCI_VERSIONS]));
-
-            /* Let's output the Bluetooth Device Address so that the    */
-            /* user knows what the Device Address is.                   */
-            if(!GAP_Query_Local_BD_ADDR(BluetoothStackID, &BD_ADDR))
-            {
-               BD_ADDRToStr(BD_ADDR, BluetoothAddress);
-
-               Display(("BD_ADDR: %s\r\n", BluetoothAddress));
-            }
-
-            /* Go ahead and allow Master/Slave Role Switch.             */
-            L2CA_Link_Connect_Params.L2CA_Link_Connect_Request_Config  = cqAllowRoleSwitch;
-            L2CA_Link_Connect_Params.L2CA_Link_Connect_Response_Config = csMaintainCurrentRole;
-
-            L2CA_Set_Link_Connection_Configuration(BluetoothStackID, &L2CA_Link_Connect_Params);
-
-            if(HCI_Command_Supported(BluetoothStackID, HCI_SUPPORTED_COMMAND_WRITE_DEFAULT_LINK_POLICY_BIT_NUMBER) > 0)
-               HCI_Write_Default_Link_Policy_Settings(BluetoothStackID, (HCI_LINK_POLICY_SETTINGS_ENABLE_MASTER_SLAVE_SWITCH|HCI_LINK_POLICY_SETTINGS_ENABLE_SNIFF_MODE), &Status);
-
-            /* Delete all Stored Link Keys.                             */
-            ASSIGN_BD_ADDR(BD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
-
-            DeleteLinkKey(BD_ADDR);
-
-            /* Flag that no connection is currently active.             */
-            ASSIGN_BD_ADDR(ConnectionBD_ADDR, 0, 0, 0, 0, 0, 0);
-            ASSIGN_BD_ADDR(CurrentCBRemoteBD_ADDR, 0, 0, 0, 0, 0, 0);
-
-            /* Regenerate IRK and DHK from the constant Identity Root   */
-            /* Key.                                                     */
-            GAP_LE_Diversify_Function(BluetoothStackID, (Encryption_Key_t *)(&IR), 1,0, &IRK);
-            GAP_LE_Diversify_Function(BluetoothStackID, (Encryption_Key_t *)(&IR), 3, 0, &DHK);
-
-            /* Flag that we have no Key Information in the Key List.    */
-            DeviceInfoList = NULL;
-
-            /* Initialize the GATT Service.                             */
-            if(!(Result = GATT_Initialize(BluetoothStackID, GATT_INITIALIZATION_FLAGS_SUPPORT_LE, GATT_Connection_Event_Callback, 0)))
-            {
-               /* Initialize the GAPS Service.                          */
-               Result = GAPS_Initialize_Service(BluetoothStackID, &ServiceID);
-               if(Result > 0)
-               {
-                  /* Save the Instance ID of the GAP Service.           */
-                  GAPSInstanceID = (unsigned int)Result;
-
-                  /* Set the GAP Device Name and Device Appearance.     */
-                  GAPS_Set_Device_Name(BluetoothStackID, GAPSInstanceID, LE_DEMO_DEVICE_NAME);
-                  GAPS_Set_Device_Appearance(BluetoothStackID, GAPSInstanceID, GAP_DEVICE_APPEARENCE_VALUE_GENERIC_COMPUTER);
-                  GAP_Set_Local_Device_Name(BluetoothStackID, LE_DEMO_DEVICE_NAME);
-
-                  /* Return success to the caller.                      */
-                  ret_val        = 0;
-               }
-               else
-               {
-                  /* The Stack was NOT initialized successfully, inform */
-                  /* the user and set the return value of the           */
-                  /* initialization function to an error.               */
-                  DisplayFunctionError("GAPS_Initialize_Service", Result);
-
-                  /* Cleanup GATT Module.                               */
-                  GATT_Cleanup(BluetoothStackID);
-
-                  BluetoothStackID = 0;
-
-                  ret_val          = UNABLE_TO_INITIALIZE_STACK;
-               }
-            }
-            else
-            {
-               /* The Stack was NOT initialized successfully, inform the*/
-               /* user and set the return value of the initialization   */
-               /* function to an error.                                 */
-               DisplayFunctionError("GATT_Initialize", Result);
-
-               BluetoothStackID = 0;
-
-               ret_val          = UNABLE_TO_INITIALIZE_STACK;
-            }
-         }
-         else
-         {
-            /* The Stack was NOT initialized successfully, inform the   */
-            /* user and set the return value of the initialization      */
-            /* function to an error.                                    */
-            DisplayFunctionError("BSC_Initialize", Result);
-
-            BluetoothStackID = 0;
-
-            ret_val          = UNABLE_TO_INITIALIZE_STACK;
-         }
-      }
-      else
-      {
-         /* One or more of the necessary parameters are invalid.        */
-         ret_val = INVALID_PARAMETERS_ERROR;
-      }
-   }
-
-   return(ret_val);
-}
-
-   /* The following function is responsible for closing the SS1         */
-   /* Bluetooth Protocol Stack.  This function requires that the        */
-   /* Bluetooth Protocol stack previously have been initialized via the */
-   /* OpenStack() function.  This function returns zero on successful   */
-   /* execution and a negative value on all errors.                     */
-static int CloseStack(void)
-{
-   int ret_val = 0;
-
-   /* First check to see if the Stack has been opened.                  */
-   if(BluetoothStackID)
-   {
-      /* Cleanup GAP Service Module.                                    */
-      if(GAPSInstanceID)
-         GAPS_Cleanup_Service(BluetoothStackID, GAPSInstanceID);
-
-      /* Un-registered SPP LE Service.                                  */
-      if(ServiceID)
-         GATT_Un_Register_Service(BluetoothStackID, ServiceID);
-
-      /* Cleanup GATT Module.                                           */
-      GATT_Cleanup(BluetoothStackID);
-
-      /* Simply close the Stack                                         */
-      BSC_Shutdown(BluetoothStackID);
-
-      /* Free BTPSKRNL allocated memory.                                */
-      BTPS_DeInit();
-
-      Display(("Stack Shutdown.\r\n"));
-
-      /* Free the Key List.                                             */
-      FreeDeviceInfoList(&DeviceInfoList);
-
-      /* Flag that the Stack is no longer initialized.                  */
-      BluetoothStackID = 0;
-
-      /* Flag success to the caller.                                    */
-      ret_val          = 0;
-   }
-   else
-   {
-      /* A valid Stack ID does not exist, inform to user.               */
-      ret_val = UNABLE_TO_INITIALIZE_STACK;
-   }
-
-   return(ret_val);
-}
-
-   /* The following function is responsible for placing the Local       */
-   /* Bluetooth Device into General Discoverablity Mode.  Once in this  */
-   /* mode the Device will respond to Inquiry Scans from other Bluetooth*/
-   /* Devices.  This function requires that a valid Bluetooth Stack ID  */
-   /* exists before running.  This function returns zero on successful  */
-   /* execution and a negative value if an error occurred.              */
-static int SetDisc(void)
-{
-   int ret_val = 0;
-
-   /* First, check that a valid Bluetooth Stack ID exists.              */
-   if(BluetoothStackID)
-   {
-      /* A semi-valid Bluetooth Stack ID exists, now attempt to set the */
-      /* attached Devices Discoverablity Mode to General.               */
-      ret_val = GAP_Set_Discoverability_Mode(BluetoothStackID, dmGeneralDiscoverableMode, 0);
-
-      /* Next, check the return value of the GAP Set Discoverability    */
-      /* Mode command for successful execution.                         */
-      if(!ret_val)
-      {
-         /* * NOTE * Discoverability is only applicable when we are     */
-         /*          advertising so save the default Discoverability    */
-         /*          Mode for later.                                    */
-         LE_Parameters.DiscoverabilityMode = dmGeneralDiscoverableMode;
-      }
-      else
-      {
-         /* An error occurred while trying to set the Discoverability   */
-         /* Mode of the Device.                                         */
-         DisplayFunctionError("Set Discoverable Mode", ret_val);
-      }
-   }
-   else
-   {
-      /* No valid Bluetooth Stack ID exists.                            */
-      ret_val = INVALID_STACK_ID_ERROR;
-   }
-
-   return(ret_val);
-}
-
-   /* The following function is responsible for placing the Local       */
-   /* Bluetooth Device into Connectable Mode.  Once in this mode the    */
-   /* Device will respond to Page Scans from other Bluetooth Devices.   */
-   /* This function requires that a valid Bluetooth Stack ID exists     */
-   /* before running.  This function returns zero on success and a      */
-   /* negative value if an error occurred.                              */
-static int SetConnect(void)
-{
-   int ret_val = 0;
-
-   /* First, check that a valid Bluetooth Stack ID exists.              */
-   if(BluetoothStackID)
-   {
-      /* Attempt to set the attached Device to be Connectable.          */
-      ret_val = GAP_Set_Connectability_Mode(BluetoothStackID, cmConnectableMode);
-
-      /* Next, check the return value of the                            */
-      /* GAP_Set_Connectability_Mode() function for successful          */
-      /* execution.                                                     */
-      if(!ret_val)
-      {
-         /* * NOTE * Connectability is only an applicable when          */
-         /*          advertising so we will just save the default       */
-         /*          connectability for the next time we enable         */
-         /*          advertising.                                       */
-         LE_Parameters.ConnectableMode = lcmConnectable;
-      }
-      else
-      {
-         /* An error occurred while trying to make the Device           */
-         /* Connectable.                                                */
-         DisplayFunctionError("Set Connectability Mode", ret_val);
-      }
-   }
-   else
-   {
-      /* No valid Bluetooth Stack ID exists.                            */
-      ret_val = INVALID_STACK_ID_ERROR;
-   }
-
-   return(ret_val);
-}
-
-   /* The following function is responsible for placing the local       */
-   /* Bluetooth device into Pairable mode.  Once in this mode the device*/
-   /* will response to pairing requests from other Bluetooth devices.   */
-   /* This function returns zero on successful execution and a negative */
-   /* value on all errors.                                              */
-static int SetPairable(void)
-{
-   int Result;
-   int ret_val = 0;
-
-   /* First, check that a valid Bluetooth Stack ID exists.              */
-   if(BluetoothStackID)
-   {
-      /* Attempt to set the attached device to be pairable.             */
-      Result = GAP_Set_Pairability_Mode(BluetoothStackID, pmPairableMode);
-
-      /* Next, check the return value of the GAP Set Pairability mode   */
-      /* command for successful execution.                              */
-      if(!Result)
-      {
-         /* The device has been set to pairable mode, now register an   */
-         /* Authentication Callback to handle the Authentication events */
-         /* if required.                                                */
-         Result = GAP_Register_Remote_Authentication(BluetoothStackID, GAP_Event_Callback, (unsigned long)0);
-
-         /* Next, check the return value of the GAP Register Remote     */
-         /* Authentication command for successful execution.            */
-         if(!Result)
-         {
-            /* Now Set the LE Pairability.                              */
-
-            /* Attempt to set the attached device to be pairable.       */
-            Result = GAP_LE_Set_Pairability_Mode(BluetoothStackID, lpmPairableMode);
-
-            /* Next, check the return value of the GAP Set Pairability  */
-            /* mode command for successful execution.                   */
-            if(!Result)
-            {
-               /* The device has been set to pairable mode, now register*/
-               /* an Authentication Callback to handle the              */
-               /* Authentication events if required.                    */
-               Result = GAP_LE_Register_Remote_Authentication(BluetoothStackID, GAP_LE_Event_Callback, (unsigned long)0);
-
-               /* Next, check the return value of the GAP Register      */
-               /* Remote Authentication command for successful          */
-               /* execution.                                            */
-               if(Result)
-               {
-                  /* An error occurred while trying to execute this     */
-                  /* function.                                          */
-                  DisplayFunctionError("GAP_LE_Register_Remote_Authentication", Result);
-
-                  ret_val = Result;
-               }
-            }
-            else
-            {
-               /* An error occurred while trying to make the device     */
-               /* pairable.                                             */
-               DisplayFunctionError("GAP_LE_Set_Pairability_Mode", Result);
-
-               ret_val = Result;
-            }
-         }
-         else
-         {
-            /* An error occurred while trying to execute this function. */
-            DisplayFunctionError("GAP_Register_Remote_Authentication", Result);
-
-            ret_val = Result;
-         }
-      }
-      else
-      {
-         /* An error occurred while trying to make the device pairable. */
-         DisplayFunctionError("GAP_Set_Pairability_Mode", Result);
-
-         ret_val = Result;
-      }
-   }
-   else
-   {
-      /* No valid Bluetooth Stack ID exists.                            */
-      ret_val = INVALID_STACK_ID_ERROR;
-   }
-
-   return(ret_val);
-}
-
-   /* The following function provides a mechanism to configure a        */
-   /* Pairing Capabilities structure with the application's pairing     */
-   /* parameters.                                                       */
-static void ConfigureCapabilities(GAP_LE_Pairing_Capabilities_t *Capabilities)
-{
-   /* Make sure the Capabilities pointer is semi-valid.                 */
-   if(Capabilities)
-   {
-      /* Configure the Pairing Cabilities structure.                    */
-      Capabilities->Bonding_Type                    = lbtBonding;
-      Capabilities->IO_Capability                   = LE_Parameters.IOCapability;
-      Capabilities->MITM                            = LE_Parameters.MITMProtection;
-      Capabilities->OOB_Present                     = LE_Parameters.OOBDataPresent;
-
-      /* ** NOTE ** This application always requests that we use the    */
-      /*            maximum encryption because this feature is not a    */
-      /*            very good one, if we set less than the maximum we   */
-      /*            will internally in GAP generate a key of the        */
-      /*            maximum size (we have to do it this way) and then   */
-      /*            we will zero out how ever many of the MSBs          */
-      /*            necessary to get the maximum size.  Also as a slave */
-      /*            we will have to use Non-Volatile Memory (per device */
-      /*            we are paired to) to store the negotiated Key Size. */
-      /*            By requesting the maximum (and by not storing the   */
-      /*            negotiated key size if less than the maximum) we    */
-      /*            allow the slave to power cycle and regenerate the   */
-      /*            LTK for each device it is paired to WITHOUT storing */
-      /*            any information on the individual devices we are    */
-      /*            paired to.                                          */
-      Capabilities->Maximum_Encryption_Key_Size        = GAP_LE_MAXIMUM_ENCRYPTION_KEY_SIZE;
-
-      /* This application only demostrates using Long Term Key's (LTK)  */
-      /* for encryption of a LE Link, however we could request and send */
-      /* all possible keys here if we wanted to.                        */
-      Capabilities->Receiving_Keys.Encryption_Key     = FALSE;
-      Capabilities->Receiving_Keys.Identification_Key = FALSE;
-      Capabilities->Receiving_Keys.Signing_Key        = FALSE;
-
-      Capabilities->Sending_Keys.Encryption_Key       = TRUE;
-      Capabilities->Sending_Keys.Identification_Key   = FALSE;
-      Capabilities->Sending_Keys.Signing_Key          = FALSE;
-   }
-}
-
-   /* The following function provides a mechanism of sending a Slave    */
-   /* Pairing Response to a Master's Pairing Request.                   */
-static int SlavePairingRequestResponse(BD_ADDR_t BD_ADDR)
-{
-   int                                          ret_val;
-   BoardStr_t                                   BoardStr;
-   GAP_LE_Authentication_Response_Information_t AuthenticationResponseData;
-
-   /* Make sure a Bluetooth Stack is open.                              */
-   if(BluetoothStackID)
-   {
-      BD_ADDRToStr(BD_ADDR, BoardStr);
-      Display(("Sending Pairing Response to %s.\r\n", BoardStr));
-
-      /* We must be the slave if we have received a Pairing Request     */
-      /* thus we will respond with our capabilities.                    */
-      AuthenticationResponseData.GAP_LE_Authentication_Type = larPairingCapabilities;
-      AuthenticationResponseData.Authentication_Data_Length = GAP_LE_PAIRING_CAPABILITIES_SIZE;
-
-      /* Configure the Application Pairing Parameters.                  */
-      ConfigureCapabilities(&(AuthenticationResponseData.Authentication_Data.Pairing_Capabilities));
-
-      /* Attempt to pair to the remote device.                          */
-      ret_val = GAP_LE_Authentication_Response(BluetoothStackID, BD_ADDR, &AuthenticationResponseData);
-
-      Display(("GAP_LE_Authentication_Response returned %d.\r\n", ret_val));
-   }
-   else
-   {
-      Display(("Stack ID Invalid.\r\n"));
-
-      ret_val = INVALID_STACK_ID_ERROR;
-   }
-
-   return(ret_val);
-}
-
-   /* The following function is provided to allow a mechanism of        */
-   /* responding to a request for Encryption Information to send to a   */
-   /* remote device.                                                    */
-static int EncryptionInformationRequestResponse(BD_ADDR_t BD_ADDR, Byte_t KeySize, GAP_LE_Authentication_Response_Information_t *GAP_LE_Authentication_Response_Information)
-{
-   int    ret_val;
-   Word_t LocalDiv;
-
-   /* Make sure a Bluetooth Stack is open.                              */
-   if(BluetoothStackID)
-   {
-      /* Make sure the input parameters are semi-valid.                 */
-      if((!COMPARE_NULL_BD_ADDR(BD_ADDR)) && (GAP_LE_Authentication_Response_Information))
-      {
-         Display(("   Calling GAP_LE_Generate_Long_Term_Key.\r\n"));
-
-         /* Generate a new LTK, EDIV and Rand tuple.                    */
-         ret_val = GAP_LE_Generate_Long_Term_Key(BluetoothStackID, (Encryption_Key_t *)(&DHK), (Encryption_Key_t *)(&ER), &(GAP_LE_Authentication_Response_Information->Authentication_Data.Encryption_Information.LTK), &LocalDiv, &(GAP_LE_Authentication_Response_Information->Authentication_Data.Encryption_Information.EDIV), &(GAP_LE_Authentication_Response_Information->Authentication_Data.Encryption_Information.Rand));
-         if(!ret_val)
-         {
-            Display(("   Encryption Information Request Response.\r\n"));
-
-            /* Response to the request with the LTK, EDIV and Rand      */
-            /* values.                                                  */
-            GAP_LE_Authentication_Response_Information->GAP_LE_Authentication_Type                                     = larEncryptionInformation;
-            GAP_LE_Authentication_Response_Information->Authentication_Data_Length                                     = GAP_LE_ENCRYPTION_INFORMATION_DATA_SIZE;
-            GAP_LE_Authentication_Response_Information->Authentication_Data.Encryption_Information.Encryption_Key_Size = KeySize;
-
-            ret_val = GAP_LE_Authentication_Response(BluetoothStackID, BD_ADDR, GAP_LE_Authentication_Response_Information);
-            if(!ret_val)
-            {
-               Display(("   GAP_LE_Authentication_Response (larEncryptionInformation) success.\r\n", ret_val));
-            }
-            else
-            {
-               Display(("   Error - SM_Generate_Long_Term_Key returned %d.\r\n", ret_val));
-            }
-         }
-         else
-         {
-            Display(("   Error - SM_Generate_Long_Term_Key returned %d.\r\n", ret_val));
-         }
-      }
-      else
-      {
-         Display(("Invalid Parameters.\r\n"));
-
-         ret_val = INVALID_PARAMETERS_ERROR;
-      }
-   }
-   else
-   {
-      Display(("Stack ID Invalid.\r\n"));
-
-      ret_val = INVALID_STACK_ID_ERROR;
-   }
-
-   return(ret_val);
-}
-
-   /* The following function is a utility function that exists to delete*/
-   /* the specified Link Key from the Local Bluetooth Device.  If a NULL*/
-   /* Bluetooth Device Address is specified, then all Link Keys will be */
-   /* deleted.                                                          */
-static int DeleteLinkKey(BD_ADDR_t BD_ADDR)
-{
-   int       Result;
-   Byte_t    Status_Result;
-   Word_t    Num_Keys_Deleted = 0;
-   BD_ADDR_t NULL_BD_ADDR;
-
-   Result = HCI_Delete_Stored_Link_Key(BluetoothStackID, BD_ADDR, TRUE, &Status_Result, &Num_Keys_Deleted);
-
-   /* Any stored link keys for the specified address (or all) have been */
-   /* deleted from the chip.  Now, let's make sure that our stored Link */
-   /* Key Array is in sync with these changes.                          */
-
-   /* First check to see all Link Keys were deleted.                    */
-   ASSIGN_BD_ADDR(NULL_BD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
-
-   if(COMPARE_BD_ADDR(BD_ADDR, NULL_BD_ADDR))
-      BTPS_MemInitialize(LinkKeyInfo, 0, sizeof(LinkKeyInfo));
-   else
-   {
-      /* Individual Link Key.  Go ahead and see if know about the entry */
-      /* in the list.                                                   */
-      for(Result=0;(Result<sizeof(LinkKeyInfo)/sizeof(LinkKeyInfo_t));Result++)
-      {
-         if(COMPARE_BD_ADDR(BD_ADDR, LinkKeyInfo[Result].BD_ADDR))
-         {
-            LinkKeyInfo[Result].BD_ADDR = NULL_BD_ADDR;
-
-            break;
-         }
-      }
-   }
-
-   return(Result);
-}
-
-   /* The following function is responsible for issuing a GAP           */
-   /* Authentication Response with a PIN Code value specified via the   */
-   /* input parameter.  This function returns zero on successful        */
-   /* execution and a negative value on all errors.                     */
-static int PINCodeResponse(ParameterList_t *TempParam)
-{
-   int                              Result;
-   int                              ret_val;
-   PIN_Code_t                       PINCode;
-   GAP_Authentication_Information_t GAP_Authentication_Information;
-
-   /* First, check that valid Bluetooth Stack ID exists.                */
-   if(BluetoothStackID)
-   {
-      /* First, check to see if there is an on-going Pairing operation  */
-      /* active.                                                        */
-      if(!COMPARE_NULL_BD_ADDR(CurrentCBRemoteBD_ADDR))
-      {
-         /* Make sure that all of the parameters required for this      */
-         /* function appear to be at least semi-valid.                  */
-         if((TempParam) && (TempParam->NumberofParameters > 0) && (TempParam->Params[0].strParam) && (BTPS_StringLength(TempParam->Params[0].strParam) > 0) && (BTPS_StringLength(TempParam->Params[0].strParam) <= sizeof(PIN_Code_t)))
-         {
-            /* Parameters appear to be valid, go ahead and convert the  */
-            /* input parameter into a PIN Code.                         */
-
-            /* Initialize the PIN code.                                 */
-            ASSIGN_PIN_CODE(PINCode, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
-
-            BTPS_MemCopy(&PINCode, TempParam->Params[0].strParam, BTPS_StringLength(TempParam->Params[0].strParam));
-
-            /* Populate the response structure.                         */
-            GAP_Authentication_Information.GAP_Authentication_Type      = atPINCode;
-            GAP_Authentication_Information.Authentication_Data_Length   = (Byte_t)(BTPS_StringLength(TempParam->Params[0].strParam));
-            GAP_Authentication_Information.Authentication_Data.PIN_Code = PINCode;
-
-            /* Submit the Authentication Response.                      */
-            Result = GAP_Authentication_Response(BluetoothStackID, CurrentCBRemoteBD_ADDR, &GAP_Authentication_Information);
-
-            /* Check the return value for the submitted command for     */
-            /* success.                                                 */
-            if(!Result)
-            {
-               /* Operation was successful, inform the user.            */
-               Display(("GAP_Authentication_Response(), Pin Code Response Success.\r\n"));
-
-               /* Flag success to the caller.                           */
-               ret_val = 0;
-            }
-            else
-            {
-               /* Inform the user that the Authentication Response was  */
-               /* not successful.                                       */
-               Display(("GAP_Authentication_Response() Failure: %d.\r\n", Result));
-
-               ret_val = FUNCTION_ERROR;
-            }
-
-            /* Flag that there is no longer a current Authentication    */
-            /* procedure in progress.                                   */
-            ASSIGN_BD_ADDR(CurrentCBRemoteBD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
-         }
-         else
-            ret_val = INVALID_PARAMETERS_ERROR;
-      }
-      else
-      {
-         /* There is not currently an on-going authentication operation,*/
-         /* inform the user of this error condition.                    */
-         Display(("PIN Code Authentication Response: Authentication not in progress.\r\n"));
-
-         ret_val = FUNCTION_ERROR;
-      }
-   }
-   else
-   {
-      /* No valid Bluetooth Stack ID exists.                            */
-      ret_val = INVALID_STACK_ID_ERROR;
-   }
-
-   return(ret_val);
-}
-
-   /* The following function is responsible for enabling LE             */
-   /* Advertisements.  This function returns zero on successful         */
-   /* execution and a negative value on all errors.                     */
-static int AdvertiseLE(ParameterList_t *TempParam)
-{
-   int                                 ret_val;
-   int                                 Length;
-   GAP_LE_Advertising_Parameters_t     AdvertisingParameters;
-   GAP_LE_Connectability_Parameters_t  ConnectabilityParameters;
-   union
-   {
-      Advertising_Data_t               AdvertisingData;
-      Scan_Response_Data_t             ScanResponseData;
-   } Advertisement_Data_Buffer;
-
-   /* First, check that valid Bluetooth Stack ID exists.                */
-   if(BluetoothStackID)
-   {
-      /* Enable Advertising.  Set the Advertising Data.                 */
-      BTPS_MemInitialize(&(Advertisement_Data_Buffer.AdvertisingData), 0, sizeof(Advertising_Data_t));
-
-      /* Set the Flags A/D Field (1 byte type and 1 byte Flags.         */
-      Advertisement_Data_Buffer.AdvertisingData.Advertising_Data[0] = 2;
-      Advertisement_Data_Buffer.AdvertisingData.Advertising_Data[1] = HCI_LE_ADVERTISING_REPORT_DATA_TYPE_FLAGS;
-      Advertisement_Data_Buffer.AdvertisingData.Advertising_Data[2] = 0;
-
-      /* Configure the flags field based on the Discoverability Mode.   */
-      if(LE_Parameters.DiscoverabilityMode == dmGeneralDiscoverableMode)
-         Advertisement_Data_Buffer.AdvertisingData.Advertising_Data[2] = HCI_LE_ADVERTISING_FLAGS_GENERAL_DISCOVERABLE_MODE_FLAGS_BIT_MASK;
-      else
-      {
-         if(LE_Parameters.DiscoverabilityMode == dmLimitedDiscoverableMode)
-            Advertisement_Data_Buffer.AdvertisingData.Advertising_Data[2] = HCI_LE_ADVERTISING_FLAGS_LIMITED_DISCOVERABLE_MODE_FLAGS_BIT_MASK;
-      }
-
-      /* Write thee advertising data to the chip.                       */
-      ret_val = GAP_LE_Set_Advertising_Data(BluetoothStackID, (Advertisement_Data_Buffer.AdvertisingData.Advertising_Data[0] + 1), &(Advertisement_Data_Buffer.AdvertisingData));
-      if(!ret_val)
-      {
-         BTPS_MemInitialize(&(Advertisement_Data_Buffer.ScanResponseData), 0, sizeof(Scan_Response_Data_t));
-
-         /* Set the Scan Response Data.                                 */
-         Length = BTPS_StringLength(LE_DEMO_DEVICE_NAME);
-         if(Length < (ADVERTISING_DATA_MAXIMUM_SIZE - 2))
-         {
-            Advertisement_Data_Buffer.ScanResponseData.Scan_Response_Data[1] = HCI_LE_ADVERTISING_REPORT_DATA_TYPE_LOCAL_NAME_COMPLETE;
-         }
-         else
-         {
-            Advertisement_Data_Buffer.ScanResponseData.Scan_Response_Data[1] = HCI_LE_ADVERTISING_REPORT_DATA_TYPE_LOCAL_NAME_SHORTENED;
-            Length = (ADVERTISING_DATA_MAXIMUM_SIZE - 2);
-         }
-
-         Advertisement_Data_Buffer.ScanResponseData.Scan_Response_Data[0] = (Byte_t)(1 + Length);
-         BTPS_MemCopy(&(Advertisement_Data_Buffer.ScanResponseData.Scan_Response_Data[2]),LE_DEMO_DEVICE_NAME,Length);
-
-         ret_val = GAP_LE_Set_Scan_Response_Data(BluetoothStackID, (Advertisement_Data_Buffer.ScanResponseData.Scan_Response_Data[0] + 1), &(Advertisement_Data_Buffer.ScanResponseData));
-         if(!ret_val)
-         {
-            /* Set up the advertising parameters.                       */
-            AdvertisingParameters.Advertising_Channel_Map   = HCI_LE_ADVERTISING_CHANNEL_MAP_DEFAULT;
-            AdvertisingParameters.Scan_Request_Filter       = fpNoFilter;
-            AdvertisingParameters.Connect_Request_Filter    = fpNoFilter;
-            AdvertisingParameters.Advertising_Interval_Min  = 100;
-            AdvertisingParameters.Advertising_Interval_Max  = 200;
-
-            /* Configure the Connectability Parameters.                 */
-            /* * NOTE * Since we do not ever put ourselves to be direct */
-            /*          connectable then we will set the DirectAddress  */
-            /*          to all 0s.                                      */
-            ConnectabilityParameters.Connectability_Mode   = LE_Parameters.ConnectableMode;
-            ConnectabilityParameters.Own_Address_Type      = latPublic;
-            ConnectabilityParameters.Direct_Address_Type   = latPublic;
-            ASSIGN_BD_ADDR(ConnectabilityParameters.Direct_Address, 0, 0, 0, 0, 0, 0);
-
-            /* Now enable advertising.                                  */
-            ret_val = GAP_LE_Advertising_Enable(BluetoothStackID, TRUE, &AdvertisingParameters, &ConnectabilityParameters, GAP_LE_Event_Callback, 0);
-            if(!ret_val)
-            {
-               Display(("GAP_LE_Advertising_Enable success.\r\n"));
-            }
-            else
-            {
-               Display(("GAP_LE_Advertising_Enable returned %d.\r\n", ret_val));
-
-               ret_val = FUNCTION_ERROR;
-            }
-         }
-         else
-         {
-            Display(("GAP_LE_Set_Advertising_Data(dtScanResponse) returned %d.\r\n", ret_val));
-
-            ret_val = FUNCTION_ERROR;
-         }
-
-      }
-      else
-      {
-         Display(("GAP_LE_Set_Advertising_Data(dtAdvertising) returned %d.\r\n", ret_val));
-
-         ret_val = FUNCTION_ERROR;
-      }
-   }
-   else
-   {
-      /* No valid Bluetooth Stack ID exists.                            */
-      ret_val = INVALID_STACK_ID_ERROR;
-   }
-
-   return(0);
-}
-
-/*********************************************************************/
-/**                           Service Table                         **/
-/*********************************************************************/
-#define MYLE_SERVICE_UUID_CONSTANT                      { 0x39, 0x23, 0xCF, 0x40, 0x73, 0x16, 0x42, 0x9A, 0x5c, 0x41, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00 }
-#define MYLE_BUTTON_CHARACTERISTIC_UUID_CONSTANT        { 0x57, 0x9A, 0x05, 0x43, 0x52, 0xCD, 0xB1, 0xA6, 0x1a, 0x4b, 0xE7, 0x00, 0x00, 0x00, 0x00, 0x00 }
-
-
-/* The SPPLE Service Declaration UUID.                               */
-static BTPSCONST GATT_Primary_Service_128_Entry_t MYLE_Service_UUID =
-{
-	MYLE_SERVICE_UUID_CONSTANT
-};
-
-/* The Tx Characteristic Declaration.                                */
-static BTPSCONST GATT_Characteristic_Declaration_128_Entry_t MYLE_Button_Declaration =
-{
-	GATT_CHARACTERISTIC_PROPERTIES_NOTIFY,
-	MYLE_BUTTON_CHARACTERISTIC_UUID_CONSTANT
-};
-
-/* The Tx Characteristic Value.                                      */
-static BTPSCONST GATT_Characteristic_Value_128_Entry_t  MYLE_Button_Value =
-{
-	MYLE_BUTTON_CHARACTERISTIC_UUID_CONSTANT,
-	0,
-	NULL
-};
-
-/* The following defines the MYLE service that is registered with   */
-/* the GATT_Register_Service function call.                          */
-/* * NOTE * This array will be registered with GATT in the call to   */
-/*          GATT_Register_Service.                                   */
-BTPSCONST GATT_Service_Attribute_Entry_t MYLE_Service[] =
-{
-	{GATT_ATTRIBUTE_FLAGS_READABLE,          aetPrimaryService128,            (Byte_t *)&MYLE_Service_UUID},                  //0
-	{GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicDeclaration128, (Byte_t *)&MYLE_Button_Declaration},            //1
-	{GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicValue128,       (Byte_t *)&MYLE_Button_Value},                  //2
-};
-
-#define MYLE_SERVICE_ATTRIBUTE_COUNT               (sizeof(MYLE_Service)/sizeof(GATT_Service_Attribute_Entry_t))
-
-#define MYLE_BUTTON_CHARACTERISTIC_ATTRIBUTE_OFFSET               2
-
-/* This function will return zero on successful execution  */
-/* and a negative value on errors.                                   */
-static int RegisterService(ParameterList_t *TempParam)
-{
-	int                           ret_val;
-	GATT_Attribute_Handle_Group_t ServiceHandleGroup;
-
-	/* Verify that there is no active connection.                        */
-	if(!ConnectionID)
-	{
-		/* Verify that the Service is not already registered.             */
-		if(!ServiceID)
-		{
-			/* Initialize the handle group to 0 .                          */
-			ServiceHandleGroup.Starting_Handle = 0;
-			ServiceHandleGroup.Ending_Handle   = 0;
-
-			/* Register the SPPLE Service.                                 */
-			ret_val = GATT_Register_Service(BluetoothStackID,
-											GATT_SERVICE_FLAGS_LE_SERVICE,
-											MYLE_SERVICE_ATTRIBUTE_COUNT,
-											(GATT_Service_Attribute_Entry_t *)MYLE_Service,
-											&ServiceHandleGroup,
-											GATT_ServerEventCallback, 0);
-			if(ret_val > 0)
-			{
-				/* Display success message.                                 */
-				Display(("Sucessfully registered MYLE Service.\r\n"));
-
-				/* Save the ServiceID of the registered service.            */
-				ServiceID = (unsigned int)ret_val;
-
-				/* Return success to the caller.                            */
-				ret_val        = 0;
-			}
-		}
-		else
-		{
-			Display(("MYLE Service already registered.\r\n"));
-
-			ret_val = -1;
-		}
-	}
-	else
-	{
-		Display(("Connection current active.\r\n"));
-
-		ret_val = -1;
-	}
-
-	return(ret_val);
-}
-
-   /* ***************************************************************** */
-   /*                         Event Callbacks                           */
-   /* ***************************************************************** */
-
-   /* The following function is for the GAP LE Event Receive Data       */
-   /* Callback.  This function will be called whenever a Callback has   */
-   /* been registered for the specified GAP LE Action that is associated*/
-   /* with the Bluetooth Stack.  This function passes to the caller the */
-   /* GAP LE Event Data of the specified Event and the GAP LE Event     */
-   /* Callback Parameter that was specified when this Callback was      */
-   /* installed.  The caller is free to use the contents of the GAP LE  */
-   /* Event Data ONLY in the context of this callback.  If the caller   */
-   /* requires the Data for a longer period of time, then the callback  */
-   /* function MUST copy the data into another Data Buffer.  This       */
-   /* function is guaranteed NOT to be invoked more than once           */
-   /* simultaneously for the specified installed callback (i.e.  this   */
-   /* function DOES NOT have be reentrant).  It Needs to be noted       */
-   /* however, that if the same Callback is installed more than once,   */
-   /* then the callbacks will be called serially.  Because of this, the */
-   /* processing in this function should be as efficient as possible.   */
-   /* It should also be noted that this function is called in the Thread*/
-   /* Context of a Thread that the User does NOT own.  Therefore,       */
-   /* processing in this function should be as efficient as possible    */
-   /* (this argument holds anyway because other GAP Events will not be  */
-   /* processed while this function call is outstanding).               */
-   /* * NOTE * This function MUST NOT Block and wait for Events that can*/
-   /*          only be satisfied by Receiving a Bluetooth Event         */
-   /*          Callback.  A Deadlock WILL occur because NO Bluetooth    */
-   /*          Callbacks will be issued while this function is currently*/
-   /*          outstanding.                                             */
-static void BTPSAPI GAP_LE_Event_Callback(unsigned int BluetoothStackID, GAP_LE_Event_Data_t *GAP_LE_Event_Data, unsigned long CallbackParameter)
-{
-   int                                           Result;
-   BoardStr_t                                    BoardStr;
-   DeviceInfo_t                                 *DeviceInfo;
-   Long_Term_Key_t                               GeneratedLTK;
-   GAP_LE_Authentication_Event_Data_t           *Authentication_Event_Data;
-   GAP_LE_Authentication_Response_Information_t  GAP_LE_Authentication_Response_Information;
-
-   /* Verify that all parameters to this callback are Semi-Valid.       */
-   if((BluetoothStackID) && (GAP_LE_Event_Data))
-   {
-      switch(GAP_LE_Event_Data->Event_Data_Type)
-      {
-         case etLE_Connection_Complete:
-            Display(("etLE_Connection_Complete with size %d.\r\n",(int)GAP_LE_Event_Data->Event_Data_Size));
-
-            if(GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data)
-            {
-               BD_ADDRToStr(GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Peer_Address, BoardStr);
-
-               Display(("Status:       0x%02X.\r\n", GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Status));
-               Display(("Role:         %s.\r\n", (GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Master)?"Master":"Slave"));
-               Display(("Address Type: %s.\r\n", (GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Peer_Address_Type == latPublic)?"Public":"Random"));
-               Display(("BD_ADDR:      %s.\r\n", BoardStr));
-
-               if(GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Status == HCI_ERROR_CODE_NO_ERROR)
-               {
-                  ConnectionBD_ADDR   = GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Peer_Address;
-
-                  /* Make sure that no entry already exists.            */
-                  if((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, ConnectionBD_ADDR)) == NULL)
-                  {
-                     /* No entry exists so create one.                  */
-                     if(!CreateNewDeviceInfoEntry(&DeviceInfoList, GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Peer_Address_Type, ConnectionBD_ADDR))
-                        Display(("Failed to add device to Device Info List.\r\n"));
-                  }
-
-                  /* Set the LED.                                       */
-                  HAL_SetLED(0, 1);
-               }
-            }
-            break;
-         case etLE_Disconnection_Complete:
-            Display(("etLE_Disconnection_Complete with size %d.\r\n", (int)GAP_LE_Event_Data->Event_Data_Size));
-
-            if(GAP_LE_Event_Data->Event_Data.GAP_LE_Disconnection_Complete_Event_Data)
-            {
-               Display(("Status: 0x%02X.\r\n", GAP_LE_Event_Data->Event_Data.GAP_LE_Disconnection_Complete_Event_Data->Status));
-               Display(("Reason: 0x%02X.\r\n", GAP_LE_Event_Data->Event_Data.GAP_LE_Disconnection_Complete_Event_Data->Reason));
-
-               BD_ADDRToStr(GAP_LE_Event_Data->Event_Data.GAP_LE_Disconnection_Complete_Event_Data->Peer_Address, BoardStr);
-               Display(("BD_ADDR: %s.\r\n", BoardStr));
-
-               /* Advertise again.                                      */
-               AdvertiseLE(NULL);
-
-               /* Check to see if the device info is present in the     */
-               /* list.                                                 */
-               if((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, ConnectionBD_ADDR)) != NULL)
-               {
-                  /* Flag that no service discovery operation is        */
-                  /* outstanding for this device.                       */
-                  DeviceInfo->Flags &= ~DEVICE_INFO_FLAGS_SERVICE_DISCOVERY_OUTSTANDING;
-
-                  /* Clear the CCCDs stored for this device.            */
-                  DeviceInfo->ServerInfo.Rx_Credit_Client_Configuration_Descriptor = 0;
-                  DeviceInfo->ServerInfo.Tx_Client_Configuration_Descriptor        = 0;
-
-                  /* Clear the Transmit Credits count.                  */
-                  DeviceInfo->TransmitCredits = 0;
-               }
-
-               /* Clear the saved Connection BD_ADDR.                   */
-               ASSIGN_BD_ADDR(ConnectionBD_ADDR, 0, 0, 0, 0, 0, 0);
-
-               /* Clear the LED.                                        */
-               HAL_SetLED(0, 0);
-            }
-            break;
-         case etLE_Authentication:
-            Display(("etLE_Authentication with size %d.\r\n", (int)GAP_LE_Event_Data->Event_Data_Size));
-
-            /* Make sure the authentication event data is valid before  */
-            /* continueing.                                             */
-            if((Authentication_Event_Data = GAP_LE_Event_Data->Event_Data.GAP_LE_Authentication_Event_Data) != NULL)
-            {
-               BD_ADDRToStr(Authentication_Event_Data->BD_ADDR, BoardStr);
-
-               switch(Authentication_Event_Data->GAP_LE_Authentication_Event_Type)
-               {
-                  case latLongTermKeyRequest:
-                     Display(("latKeyRequest(BD_ADDR = %s).\r\n", BoardStr));
-
-                     /* The other side of a connection is requesting    */
-                     /* that we start encryption. Thus we should        */
-                     /* regenerate LTK for this connection and send it  */
-                     /* to the chip.                                    */
-                     Result = GAP_LE_Regenerate_Long_Term_Key(BluetoothStackID, (Encryption_Key_t *)(&DHK), (Encryption_Key_t *)(&ER), Authentication_Event_Data->Authentication_Event_Data.Long_Term_Key_Request.EDIV, &(Authentication_Event_Data->Authentication_Event_Data.Long_Term_Key_Request.Rand), &GeneratedLTK);
-                     if(!Result)
-                     {
-                        Display(("GAP_LE_Regenerate_Long_Term_Key Success.\r\n"));
-
-                        /* Respond with the Re-Generated Long Term Key. */
-                        GAP_LE_Authentication_Response_Information.GAP_LE_Authentication_Type                                        = larLongTermKey;
-                        GAP_LE_Authentication_Response_Information.Authentication_Data_Length                                        = GAP_LE_LONG_TERM_KEY_INFORMATION_DATA_SIZE;
-                        GAP_LE_Authentication_Response_Information.Authentication_Data.Long_Term_Key_Information.Encryption_Key_Size = GAP_LE_MAXIMUM_ENCRYPTION_KEY_SIZE;
-                        GAP_LE_Authentication_Response_Information.Authentication_Data.Long_Term_Key_Information.Long_Term_Key       = GeneratedLTK;
-                     }
-                     else
-                     {
-                        Display(("GAP_LE_Regenerate_Long_Term_Key returned %d.\r\n",Result));
-
-                        /* Since we failed to generate the requested key*/
-                        /* we should respond with a negative response.  */
-                        GAP_LE_Authentication_Response_Information.GAP_LE_Authentication_Type = larLongTermKey;
-                        GAP_LE_Authentication_Response_Information.Authentication_Data_Length = 0;
-                     }
-                     /* Send the Authentication Response.               */
-                     Result = GAP_LE_Authentication_Response(BluetoothStackID, Authentication_Event_Data->BD_ADDR, &GAP_LE_Authentication_Response_Information);
-                     if(Result)
-                     {
-                        Display(("GAP_LE_Authentication_Response returned %d.\r\n",Result));
-                     }
-                     break;
-                  case latPairingRequest:
-                     Display(("Pairing Request: %s.\r\n",BoardStr));
-
-                     /* This is a pairing request. Respond with a       */
-                     /* Pairing Response.                               */
-                     /* * NOTE * This is only sent from Master to Slave.*/
-                     /*          Thus we must be the Slave in this      */
-                     /*          connection.                            */
-
-                     /* Send the Pairing Response.                      */
-                     SlavePairingRequestResponse(Authentication_Event_Data->BD_ADDR);
-                     break;
-                  case latConfirmationRequest:
-                     Display(("latConfirmationRequest.\r\n"));
-
-                     if(Authentication_Event_Data->Authentication_Event_Data.Confirmation_Request.Request_Type == crtNone)
-                     {
-                        Display(("Invoking Just Works.\r\n"));
-
-                        /* Just Accept Just Works Pairing.              */
-                        GAP_LE_Authentication_Response_Information.GAP_LE_Authentication_Type = larConfirmation;
-
-                        /* By setting the Authentication_Data_Length to */
-                        /* any NON-ZERO value we are informing the GAP  */
-                        /* LE Layer that we are accepting Just Works    */
-                        /* Pairing.                                     */
-                        GAP_LE_Authentication_Response_Information.Authentication_Data_Length = DWORD_SIZE;
-
-                        Result = GAP_LE_Authentication_Response(BluetoothStackID, Authentication_Event_Data->BD_ADDR, &GAP_LE_Authentication_Response_Information);
-                        if(Result)
-                        {
-                           Display(("GAP_LE_Authentication_Response returned %d.\r\n",Result));
-                        }
-                     }
-                     break;
-                  case latSecurityEstablishmentComplete:
-                     Display(("Security Re-Establishment Complete: %s.\r\n", BoardStr));
-                     Display(("                            Status: 0x%02X.\r\n", Authentication_Event_Data->Authentication_Event_Data.Security_Establishment_Complete.Status));
-                     break;
-                  case latPairingStatus:
-                     Display(("Pairing Status: %s.\r\n", BoardStr));
-                     Display(("        Status: 0x%02X.\r\n", Authentication_Event_Data->Authentication_Event_Data.Pairing_Status.Status));
-
-                     if(Authentication_Event_Data->Authentication_Event_Data.Pairing_Status.Status == GAP_LE_PAIRING_STATUS_NO_ERROR)
-                     {
-                        Display(("Key Size: %d.\r\n", Authentication_Event_Data->Authentication_Event_Data.Pairing_Status.Negotiated_Encryption_Key_Size));
-                     }
-                     else
-                     {
-                        /* Failed to pair so delete the key entry for   */
-                        /* this device and disconnect the link.         */
-                        if((DeviceInfo = DeleteDeviceInfoEntry(&DeviceInfoList, Authentication_Event_Data->BD_ADDR)) != NULL)
-                           FreeDeviceInfoEntryMemory(DeviceInfo);
-
-                        /* Disconnect the Link.                         */
-                        GAP_LE_Disconnect(BluetoothStackID, Authentication_Event_Data->BD_ADDR);
-                     }
-                     break;
-                  case latEncryptionInformationRequest:
-                     Display(("Encryption Information Request %s.\r\n", BoardStr));
-
-                     /* Generate new LTK,EDIV and Rand and respond with */
-                     /* them.                                           */
-                     EncryptionInformationRequestResponse(Authentication_Event_Data->BD_ADDR, Authentication_Event_Data->Authentication_Event_Data.Encryption_Request_Information.Encryption_Key_Size, &GAP_LE_Authentication_Response_Information);
-                     break;
-               }
-            }
-            break;
-      }
-   }
-}
-
-
-int g_button_state = 0;
-
-   /* The following function is for an GATT Server Event Callback.  This*/
-   /* function will be called whenever a GATT Request is made to the    */
-   /* server who registers this function that cannot be handled         */
-   /* internally by GATT.  This function passes to the caller the GATT  */
-   /* Server Event Data that occurred and the GATT Server Event Callback*/
-   /* Parameter that was specified when this Callback was installed.    */
-   /* The caller is free to use the contents of the GATT Server Event   */
-   /* Data ONLY in the context of this callback.  If the caller requires*/
-   /* the Data for a longer period of time, then the callback function  */
-   /* MUST copy the data into another Data Buffer.  This function is    */
-   /* guaranteed NOT to be invoked more than once simultaneously for the*/
-   /* specified installed callback (i.e.  this function DOES NOT have be*/
-   /* reentrant).  It Needs to be noted however, that if the same       */
-   /* Callback is installed more than once, then the callbacks will be  */
-   /* called serially.  Because of this, the processing in this function*/
-   /* should be as efficient as possible.  It should also be noted that */
-   /* this function is called in the Thread Context of a Thread that the*/
-   /* User does NOT own.  Therefore, processing in this function should */
-   /* be as efficient as possible (this argument holds anyway because   */
-   /* another GATT Event (Server/Client or Connection) will not be      */
-   /* processed while this function call is outstanding).               */
-   /* * NOTE * This function MUST NOT Block and wait for Events that can*/
-   /*          only be satisfied by Receiving a Bluetooth Event         */
-   /*          Callback.  A Deadlock WILL occur because NO Bluetooth    */
-   /*          Callbacks will be issued while this function is currently*/
-   /*          outstanding.                                             */
-static void BTPSAPI GATT_ServerEventCallback(unsigned int BluetoothStackID, GATT_Server_Event_Data_t *GATT_ServerEventData, unsigned long CallbackParameter)
-{
-   Byte_t        Temp[2];
-
-   /* Verify that all parameters to this callback are Semi-Valid.       */
-   if((BluetoothStackID) && (GATT_ServerEventData))
-   {
-	 switch(GATT_ServerEventData->Event_Data_Type)
-	 {
-		case etGATT_Server_Read_Request:
-			Display(("etGATT_Server_Read_Request\r\n"));
-		   /* Verify that the Event Data is valid.                  */
-		   if(GATT_ServerEventData->Event_Data.GATT_Read_Request_Data)
-		   {
-			  if(GATT_ServerEventData->Event_Data.GATT_Read_Request_Data->AttributeValueOffset == 0)
-			  {
-				 /* Determine which request this read is coming for.*/
-				 switch(GATT_ServerEventData->Event_Data.GATT_Read_Request_Data->AttributeOffset)
-				 {
-					case MYLE_BUTTON_CHARACTERISTIC_ATTRIBUTE_OFFSET:
-						Display(("MYLE_BUTTON_CHARACTERISTIC_ATTRIBUTE_OFFSET\r\n"));
-					   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(Temp, g_button_state);
-					   break;
-					default:
-						Display(("Unkown attribute offset\r\n"));
-						break;
-				 }
-
-				 GATT_Read_Response(BluetoothStackID, GATT_ServerEventData->Event_Data.GATT_Read_Request_Data->TransactionID, WORD_SIZE, Temp);
-			  }
-			  else
-				 GATT_Error_Response(BluetoothStackID, GATT_ServerEventData->Event_Data.GATT_Read_Request_Data->TransactionID, GATT_ServerEventData->Event_Data.GATT_Read_Request_Data->AttributeOffset, ATT_PROTOCOL_ERROR_CODE_ATTRIBUTE_NOT_LONG);
-		   }
-		   else
-			  Display(("Invalid Read Request Event Data.\r\n"));
-		   break;
-	 }
-   }
-}
-
-   /* The following function is for an GATT Connection Event Callback.  */
-   /* This function is called for GATT Connection Events that occur on  */
-   /* the specified Bluetooth Stack.  This function passes to the caller*/
-   /* the GATT Connection Event Data that occurred and the GATT         */
-   /* Connection Event Callback Parameter that was specified when this  */
-   /* Callback was installed.  The caller is free to use the contents of*/
-   /* the GATT Client Event Data ONLY in the context of this callback.  */
-   /* If the caller requires the Data for a longer period of time, then */
-   /* the callback function MUST copy the data into another Data Buffer.*/
-   /* This function is guaranteed NOT to be invoked more than once      */
-   /* simultaneously for the specified installed callback (i.e.  this   */
-   /* function DOES NOT have be reentrant).  It Needs to be noted       */
-   /* however, that if the same Callback is installed more than once,   */
-   /* then the callbacks will be called serially.  Because of this, the */
-   /* processing in this function should be as efficient as possible.   */
-   /* It should also be noted that this function is called in the Thread*/
-   /* Context of a Thread that the User does NOT own.  Therefore,       */
-   /* processing in this function should be as efficient as possible    */
-   /* (this argument holds anyway because another GATT Event            */
-   /* (Server/Client or Connection) will not be processed while this    */
-   /* function call is outstanding).                                    */
-   /* * NOTE * This function MUST NOT Block and wait for Events that can*/
-   /*          only be satisfied by Receiving a Bluetooth Event         */
-   /*          Callback.  A Deadlock WILL occur because NO Bluetooth    */
-   /*          Callbacks will be issued while this function is currently*/
-   /*          outstanding.                                             */
-static void BTPSAPI GATT_Connection_Event_Callback(unsigned int BluetoothStackID, GATT_Connection_Event_Data_t *GATT_Connection_Event_Data, unsigned long CallbackParameter)
-{
-   BoardStr_t    BoardStr;
-
-   /* Verify that all parameters to this callback are Semi-Valid.       */
-   if((BluetoothStackID) && (GATT_Connection_Event_Data))
-   {
-      /* Determine the Connection Event that occurred.                  */
-      switch(GATT_Connection_Event_Data->Event_Data_Type)
-      {
-         case etGATT_Connection_Device_Connection:
-            if(GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data)
-            {
-               /* Save the Connection ID for later use.                 */
-               ConnectionID = GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->ConnectionID;
-
-               Display(("\r\netGATT_Connection_Device_Connection with size %u: \r\n", GATT_Connection_Event_Data->Event_Data_Size));
-               BD_ADDRToStr(GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->RemoteDevice, BoardStr);
-               Display(("Connection ID:   %u.\r\n", GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->ConnectionID));
-               Display(("Connection Type: %s.\r\n", ((GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->ConnectionType == gctLE)?"LE":"BR/EDR")));
-               Display(("Remote Device:   %s.\r\n", BoardStr));
-               Display(("Connection MTU:  %u.\r\n", GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->MTU));
-            }
-            else
-               Display(("Error - Null Connection Data.\r\n"));
-            break;
-         case etGATT_Connection_Device_Disconnection:
-            if(GATT_Connection_Event_Data->Event_Data.GATT_Device_Disconnection_Data)
-            {
-               /* Clear the Connection ID.                              */
-               ConnectionID = 0;
-
-               Display(("\r\netGATT_Connection_Device_Disconnection with size %u: \r\n", GATT_Connection_Event_Data->Event_Data_Size));
-               BD_ADDRToStr(GATT_Connection_Event_Data->Event_Data.GATT_Device_Disconnection_Data->RemoteDevice, BoardStr);
-               Display(("Connection ID:   %u.\r\n", GATT_Connection_Event_Data->Event_Data.GATT_Device_Disconnection_Data->ConnectionID));
-               Display(("Connection Type: %s.\r\n", ((GATT_Connection_Event_Data->Event_Data.GATT_Device_Disconnection_Data->ConnectionType == gctLE)?"LE":"BR/EDR")));
-               Display(("Remote Device:   %s.\r\n", BoardStr));
-            }
-            else
-               Display(("Error - Null Disconnection Data.\r\n"));
-            break;
-      }
-   }
-}
-
-   /* The following function is for the GAP Event Receive Data Callback.*/
-   /* This function will be called whenever a Callback has been         */
-   /* registered for the specified GAP Action that is associated with   */
-   /* the Bluetooth Stack.  This function passes to the caller the GAP  */
-   /* Event Data of the specified Event and the GAP Event Callback      */
-   /* Parameter that was specified when this Callback was installed.    */
-   /* The caller is free to use the contents of the GAP Event Data ONLY */
-   /* in the context of this callback.  If the caller requires the Data */
-   /* for a longer period of time, then the callback function MUST copy */
-   /* the data into another Data Buffer.  This function is guaranteed   */
-   /* NOT to be invoked more than once simultaneously for the specified */
-   /* installed callback (i.e.  this function DOES NOT have be          */
-   /* reentrant).  It Needs to be noted however, that if the same       */
-   /* Callback is installed more than once, then the callbacks will be  */
-   /* called serially.  Because of this, the processing in this function*/
-   /* should be as efficient as possible.  It should also be noted that */
-   /* this function is called in the Thread Context of a Thread that the*/
-   /* User does NOT own.  Therefore, processing in this function should */
-   /* be as efficient as possible (this argument holds anyway because   */
-   /* other GAP Events will not be processed while this function call is*/
-   /* outstanding).                                                     */
-   /* * NOTE * This function MUST NOT Block and wait for events that    */
-   /*          can only be satisfied by Receiving other GAP Events.  A  */
-   /*          Deadlock WILL occur because NO GAP Event Callbacks will  */
-   /*          be issued while this function is currently outstanding.  */
-static void BTPSAPI GAP_Event_Callback(unsigned int BluetoothStackID, GAP_Event_Data_t *GAP_Event_Data, unsigned long CallbackParameter)
-{
-   int                               Result;
-   int                               Index;
-   BD_ADDR_t                         NULL_BD_ADDR;
-   BoardStr_t                        Callback_BoardStr;
-   ParameterList_t                   Params;
-   GAP_Remote_Name_Event_Data_t     *GAP_Remote_Name_Event_Data;
-   GAP_Authentication_Information_t  GAP_Authentication_Information;
-
-   /* First, check to see if the required parameters appear to be       */
-   /* semi-valid.                                                       */
-   if((BluetoothStackID) && (GAP_Event_Data))
-   {
-      /* The parameters appear to be semi-valid, now check to see what  */
-      /* type the incoming event is.                                    */
-      switch(GAP_Event_Data->Event_Data_Type)
-      {
-         case etAuthentication:
-            /* An authentication event occurred, determine which type of*/
-            /* authentication event occurred.                           */
-            switch(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->GAP_Authentication_Event_Type)
-            {
-               case atLinkKeyRequest:
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atLinkKeyRequest: %s\r\n", Callback_BoardStr));
-
-                  /* Setup the authentication information response      */
-                  /* structure.                                         */
-                  GAP_Authentication_Information.GAP_Authentication_Type    = atLinkKey;
-                  GAP_Authentication_Information.Authentication_Data_Length = 0;
-
-                  /* See if we have stored a Link Key for the specified */
-                  /* device.                                            */
-                  for(Index=0;Index<(sizeof(LinkKeyInfo)/sizeof(LinkKeyInfo_t));Index++)
-                  {
-                     if(COMPARE_BD_ADDR(LinkKeyInfo[Index].BD_ADDR, GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device))
-                     {
-                        /* Link Key information stored, go ahead and    */
-                        /* respond with the stored Link Key.            */
-                        GAP_Authentication_Information.Authentication_Data_Length   = sizeof(Link_Key_t);
-                        GAP_Authentication_Information.Authentication_Data.Link_Key = LinkKeyInfo[Index].LinkKey;
-
-                        break;
-                     }
-                  }
-
-                  /* Submit the authentication response.                */
-                  Result = GAP_Authentication_Response(BluetoothStackID, GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, &GAP_Authentication_Information);
-
-                  /* Check the result of the submitted command.         */
-                  if(!Result)
-                     DisplayFunctionSuccess("GAP_Authentication_Response");
-                  else
-                     DisplayFunctionError("GAP_Authentication_Response", Result);
-                  break;
-               case atPINCodeRequest:
-                  /* A pin code request event occurred, first display   */
-                  /* the BD_ADD of the remote device requesting the pin.*/
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atPINCodeRequest: %s\r\n", Callback_BoardStr));
-
-                  /* Note the current Remote BD_ADDR that is requesting */
-                  /* the PIN Code.                                      */
-                  CurrentCBRemoteBD_ADDR = GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device;
-
-                  Params.NumberofParameters = 1;
-                  Params.Params[0].strParam = DEFAULT_PIN_CODE;
-
-                  PINCodeResponse(&Params);
-                  break;
-               case atAuthenticationStatus:
-                  /* An authentication status event occurred, display   */
-                  /* all relevant information.                          */
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atAuthenticationStatus: %d for %s\r\n", GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Authentication_Event_Data.Authentication_Status, Callback_BoardStr));
-
-                  /* Flag that there is no longer a current             */
-                  /* Authentication procedure in progress.              */
-                  ASSIGN_BD_ADDR(CurrentCBRemoteBD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
-                  break;
-               case atLinkKeyCreation:
-                  /* A link key creation event occurred, first display  */
-                  /* the remote device that caused this event.          */
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atLinkKeyCreation: %s\r\n", Callback_BoardStr));
-
-                  /* Now store the link Key in either a free location OR*/
-                  /* over the old key location.                         */
-                  ASSIGN_BD_ADDR(NULL_BD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
-
-                  for(Index=0,Result=-1;Index<(sizeof(LinkKeyInfo)/sizeof(LinkKeyInfo_t));Index++)
-                  {
-                     if(COMPARE_BD_ADDR(LinkKeyInfo[Index].BD_ADDR, GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device))
-                        break;
-                     else
-                     {
-                        if((Result == (-1)) && (COMPARE_BD_ADDR(LinkKeyInfo[Index].BD_ADDR, NULL_BD_ADDR)))
-                           Result = Index;
-                     }
-                  }
-
-                  /* If we didn't find a match, see if we found an empty*/
-                  /* location.                                          */
-                  if(Index == (sizeof(LinkKeyInfo)/sizeof(LinkKeyInfo_t)))
-                     Index = Result;
-
-                  /* Check to see if we found a location to store the   */
-                  /* Link Key information into.                         */
-                  if(Index != (-1))
-                  {
-                     LinkKeyInfo[Index].BD_ADDR = GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device;
-                     LinkKeyInfo[Index].LinkKey = GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Authentication_Event_Data.Link_Key_Info.Link_Key;
-
-                     Display(("Link Key Stored.\r\n"));
-                  }
-                  else
-                     Display(("Link Key array full.\r\n"));
-                  break;
-               case atIOCapabilityRequest:
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atIOCapabilityRequest: %s\r\n", Callback_BoardStr));
-
-                  /* Setup the Authentication Information Response      */
-                  /* structure.                                         */
-                  GAP_Authentication_Information.GAP_Authentication_Type                                      = atIOCapabilities;
-                  GAP_Authentication_Information.Authentication_Data_Length                                   = sizeof(GAP_IO_Capabilities_t);
-                  GAP_Authentication_Information.Authentication_Data.IO_Capabilities.IO_Capability            = (GAP_IO_Capability_t)IOCapability;
-                  GAP_Authentication_Information.Authentication_Data.IO_Capabilities.MITM_Protection_Required = MITMProtection;
-                  GAP_Authentication_Information.Authentication_Data.IO_Capabilities.OOB_Data_Present         = FALSE;
-
-                  /* Submit the Authentication Response.                */
-                  Result = GAP_Authentication_Response(BluetoothStackID, GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, &GAP_Authentication_Information);
-
-                  /* Check the result of the submitted command.         */
-                  /* Check the result of the submitted command.         */
-                  if(!Result)
-                     DisplayFunctionSuccess("Auth");
-                  else
-                     DisplayFunctionError("Auth", Result);
-                  break;
-               case atIOCapabilityResponse:
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atIOCapabilityResponse: %s\r\n", Callback_BoardStr));
-                  break;
-               case atUserConfirmationRequest:
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atUserConfirmationRequest: %s\r\n", Callback_BoardStr));
-
-                  CurrentCBRemoteBD_ADDR = GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device;
-
-                  /* Invoke JUST Works Process...                       */
-                  GAP_Authentication_Information.GAP_Authentication_Type          = atUserConfirmation;
-                  GAP_Authentication_Information.Authentication_Data_Length       = (Byte_t)sizeof(Byte_t);
-                  GAP_Authentication_Information.Authentication_Data.Confirmation = TRUE;
-
-                  /* Submit the Authentication Response.                */
-                  Display(("\r\nAuto Accepting: %l\r\n", GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Authentication_Event_Data.Numeric_Value));
-
-                  Result = GAP_Authentication_Response(BluetoothStackID, GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, &GAP_Authentication_Information);
-
-                  if(!Result)
-                     DisplayFunctionSuccess("GAP_Authentication_Response");
-                  else
-                     DisplayFunctionError("GAP_Authentication_Response", Result);
-
-                  /* Flag that there is no longer a current             */
-                  /* Authentication procedure in progress.              */
-                  ASSIGN_BD_ADDR(CurrentCBRemoteBD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
-                  break;
-               case atPasskeyRequest:
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atPasskeyRequest: %s\r\n", Callback_BoardStr));
-
-                  /* Note the current Remote BD_ADDR that is requesting */
-                  /* the Passkey.                                       */
-                  CurrentCBRemoteBD_ADDR = GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device;
-
-                  /* Inform the user that they will need to respond with*/
-                  /* a Passkey Response.                                */
-                  Display(("Respond with: PassKeyResponse\r\n"));
-                  break;
-               case atRemoteOutOfBandDataRequest:
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atRemoteOutOfBandDataRequest: %s\r\n", Callback_BoardStr));
-
-                  /* This application does not support OOB data so      */
-                  /* respond with a data length of Zero to force a      */
-                  /* negative reply.                                    */
-                  GAP_Authentication_Information.GAP_Authentication_Type    = atOutOfBandData;
-                  GAP_Authentication_Information.Authentication_Data_Length = 0;
-
-                  Result = GAP_Authentication_Response(BluetoothStackID, GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, &GAP_Authentication_Information);
-
-                  if(!Result)
-                     DisplayFunctionSuccess("GAP_Authentication_Response");
-                  else
-                     DisplayFunctionError("GAP_Authentication_Response", Result);
-                  break;
-               case atPasskeyNotification:
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atPasskeyNotification: %s\r\n", Callback_BoardStr));
-
-                  Display(("Passkey Value: %lu\r\n", GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Authentication_Event_Data.Numeric_Value));
-                  break;
-               case atKeypressNotification:
-                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
-                  Display(("atKeypressNotification: %s\r\n", Callback_BoardStr));
-
-                  Display(("Keypress: %d\r\n", (int)GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Authentication_Event_Data.Keypress_Type));
-                  break;
-               default:
-                  Display(("Un-handled Auth. Event.\r\n"));
-                  break;
-            }
-            break;
-         case etRemote_Name_Result:
-            /* Bluetooth Stack has responded to a previously issued     */
-            /* Remote Name Request that was issued.                     */
-            GAP_Remote_Name_Event_Data = GAP_Event_Data->Event_Data.GAP_Remote_Name_Event_Data;
-            if(GAP_Remote_Name_Event_Data)
-            {
-               /* Inform the user of the Result.                        */
-               BD_ADDRToStr(GAP_Remote_Name_Event_Data->Remote_Device, Callback_BoardStr);
-
-               Display(("BD_ADDR: %s.\r\n", Callback_BoardStr));
-
-               if(GAP_Remote_Name_Event_Data->Remote_Name)
-                  Display(("Name: %s.\r\n", GAP_Remote_Name_Event_Data->Remote_Name));
-               else
-                  Display(("Name: NULL.\r\n"));
-            }
-            break;
-         case etEncryption_Change_Result:
-            BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Encryption_Mode_Event_Data->Remote_Device, Callback_BoardStr);
-            Display(("\r\netEncryption_Change_Result for %s, Status: 0x%02X, Mode: %s.\r\n", Callback_BoardStr,
-                                                                                             GAP_Event_Data->Event_Data.GAP_Encryption_Mode_Event_Data->Encryption_Change_Status,
-                                                                                             ((GAP_Event_Data->Event_Data.GAP_Encryption_Mode_Event_Data->Encryption_Mode == emDisabled)?"Disabled": "Enabled")));
-            break;
-         default:
-            /* An unknown/unexpected GAP event was received.            */
-            Display(("\r\nUnknown Event: %d.\r\n", GAP_Event_Data->Event_Data_Type));
-            break;
-      }
-   }
-}
-
-   /* ***************************************************************** */
-   /*                    End of Event Callbacks.                        */
-   /* ***************************************************************** */
-
-   /* The following function is used to initialize the application      */
-   /* instance.  This function should open the stack and prepare to     */
-   /* execute commands based on user input.  The first parameter passed */
-   /* to this function is the HCI Driver Information that will be used  */
-   /* when opening the stack and the second parameter is used to pass   */
-   /* parameters to BTPS_Init.  This function returns the               */
-   /* BluetoothStackID returned from BSC_Initialize on success or a     */
-   /* negative error code (of the form APPLICATION_ERROR_XXX).          */
-int InitializeApplication(HCI_DriverInformation_t *HCI_DriverInformation, BTPS_Initialization_t *BTPS_Initialization)
-{
-   int ret_val = APPLICATION_ERROR_UNABLE_TO_OPEN_STACK;
-
-   /* Next, makes sure that the Driver Information passed appears to be */
-   /* semi-valid.                                                       */
-   if((HCI_DriverInformation) && (BTPS_Initialization))
-   {
-      /* Try to Open the stack and check if it was successful.          */
-      if(!OpenStack(HCI_DriverInformation, BTPS_Initialization))
-      {
-         /* First, attempt to set the Device to be Connectable.         */
-         ret_val = SetConnect();
-
-         /* Next, check to see if the Device was successfully made      */
-         /* Connectable.                                                */
-         if(!ret_val)
-         {
-            /* Now that the device is Connectable attempt to make it    */
-            /* Discoverable.                                            */
-            ret_val = SetDisc();
-
-            /* Next, check to see if the Device was successfully made   */
-            /* Discoverable.                                            */
-            if(!ret_val)
-            {
-               /* Now that the device is discoverable attempt to make it*/
-               /* pairable.                                             */
-               ret_val = SetPairable();
-               if(!ret_val)
-               {
-                  /* Register an SPPLE Server and open an SPP Server.   */
-                  RegisterService(NULL);
-
-                  /* Advertise for connections.                         */
-                  AdvertiseLE(NULL);
-
-                  /* Return success to the caller.                      */
-                  ret_val = (int)BluetoothStackID;
-               }
-               else
-                  DisplayFunctionError("SetPairable", ret_val);
-            }
-            else
-               DisplayFunctionError("SetDisc", ret_val);
-         }
-         else
-            DisplayFunctionError("SetDisc", ret_val);
-
-         /* In some error occurred then close the stack.                */
-         if(ret_val < 0)
-         {
-            /* Close the Bluetooth Stack.                               */
-            CloseStack();
-         }
-      }
-      else
-      {
-         /* There was an error while attempting to open the Stack.      */
-         Display(("Unable to open the stack.\r\n"));
-      }
-   }
-   else
-      ret_val = APPLICATION_ERROR_INVALID_PARAMETERS;
-
-   return(ret_val);
-}
-
-
-void send_notification()
-{
-	Display(("Try to send notification\r\n"));
-
-	if(ConnectionID != 0)
-	{
-		Byte_t Temp[2];
-
-		ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(Temp, g_button_state);
-
-		int ret_val = GATT_Handle_Value_Notification(BluetoothStackID, ServiceID, ConnectionID, MYLE_BUTTON_CHARACTERISTIC_ATTRIBUTE_OFFSET, WORD_SIZE, (Byte_t *)Temp);
-		if(ret_val < 0)
-		{
-			Display(("GATT_Handle_Value_Notification failed: %d\r\n", ret_val));
-		}
-	}
-	else
-		Display(("Not connected\r\n"));
-}
-
-void port2_poll()
-{
-	if((P2IN & 0x0F) != g_button_state)
-	{
-		// only check first 4 bits, ignore rest
-		g_button_state = P2IN & 0x0F;
-
-		if(ConnectionID != 0)
-		{
-			send_notification();
-		}
-	}
-}
-
-#pragma vector = PORT2_VECTOR
-__interrupt void PORT2_ISR(void)
-{
-	// this is used to wake MSP from low power mode if necessary
-	LPM3_EXIT;
-
-	P2IES = P2IN;
-
-	P2IFG = 0;
-}
+/*****< sppledemo.c >**********************************************************/
+/*      Copyright 2001 - 2012 Stonestreet One.                                */
+/*      All Rights Reserved.                                                  */
+/*                                                                            */
+/*  SPPLEDEMO - Embedded Bluetooth SPP Emulation using GATT (LE) application. */
+/*                                                                            */
+/*  Author:  Tim Cook                                                         */
+/*                                                                            */
+/*** MODIFICATION HISTORY *****************************************************/
+/*                                                                            */
+/*   mm/dd/yy  F. Lastname    Description of Modification                     */
+/*   --------  -----------    ------------------------------------------------*/
+/*   04/16/12  Tim Cook       Initial creation.                               */
+/******************************************************************************/
+#include <stdio.h>               /* Included for sscanf.                      */
+#include "Main.h"                /* Application Interface Abstraction.        */
+#include "SPPLEDemo.h"           /* Application Header.                       */
+#include "SS1BTPS.h"             /* Main SS1 BT Stack Header.                 */
+#include "SS1BTGAT.h"            /* Main SS1 GATT Header.                     */
+#include "SS1BTGAP.h"            /* Main SS1 GAP Service Header.              */
+#include "BTPSKRNL.h"            /* BTPS Kernel Header.                       */
+#include "HAL.h"                 /* Function for Hardware Abstraction.        */
+#include "EventLog.h"            /* Button Event Log Prototypes/Constants.    */
+#include "EventCodec.h"          /* Event Codec Prototypes/Constants.         */
+#include "Latency.h"             /* Latency Measurement Prototypes/Constants. */
+#include "BondTable.h"           /* Bond Table Prototypes/Constants.          */
+#include "Config.h"              /* Configuration Prototypes/Constants.       */
+#include "Perf.h"                /* Performance Counter Prototypes/Constants. */
+#include "HCICapture.h"          /* HCI Capture Prototypes/Constants.         */
+#include "BootTime.h"            /* Boot Time Prototypes/Constants.           */
+#include "MemoryUsage.h"         /* Memory Usage Prototypes/Constants.        */
+#include "Gesture.h"             /* Gesture Prototypes/Constants.             */
+#include "Input.h"               /* Input Prototypes/Constants.               */
+#include "Control.h"             /* Control Prototypes/Constants.             */
+
+#define MAX_SUPPORTED_COMMANDS                     (64)  /* Denotes the       */
+                                                         /* maximum number of */
+                                                         /* User Commands that*/
+                                                         /* are supported by  */
+                                                         /* this application. */
+
+#define MAX_NUM_OF_PARAMETERS                       (5)  /* Denotes the max   */
+                                                         /* number of         */
+                                                         /* parameters a      */
+                                                         /* command can have. */
+
+#define MAX_INQUIRY_RESULTS                         (5)  /* Denotes the max   */
+                                                         /* number of inquiry */
+                                                         /* results.          */
+
+#define SPPLE_DATA_BUFFER_LENGTH  (BTPS_CONFIGURATION_GATT_MAXIMUM_SUPPORTED_MTU_SIZE)
+                                                         /* Defines the length*/
+                                                         /* of a SPPLE Data   */
+                                                         /* Buffer.           */
+
+#define SPPLE_DATA_CREDITS        (SPPLE_DATA_BUFFER_LENGTH*1) /* Defines the */
+                                                         /* number of credits */
+                                                         /* in an SPPLE Buffer*/
+
+   /* The following flag may be defined (project wide) to build an LE   */
+   /* only image.  All BR/EDR (classic) setup is skipped at stack       */
+   /* initialization (Discoverability, Connectability and Pairability   */
+   /* modes, L2CAP role switch, link policy and stored link keys) and   */
+   /* the classic GAP callback and PIN code handling are not built.     */
+#ifndef LE_ONLY_BUILD
+
+#define DEFAULT_PIN_CODE                         "0000"  /* Default PIN Code  */
+                                                         /* used by this app. */
+
+#endif
+
+   /* The following may be defined (project wide) to broadcast the      */
+   /* button state in the advertising data.  Broadcast Mode is off by   */
+   /* default, MYLE_BROADCAST_COMPANY_IDENTIFIER (see MYLETyp.h) should */
+   /* be set to an assigned Company Identifier when it is enabled.      */
+#ifndef DEFAULT_BROADCAST_MODE
+#define DEFAULT_BROADCAST_MODE                   (FALSE) /* Denotes whether   */
+                                                         /* the button state  */
+                                                         /* is broadcast in   */
+                                                         /* the advertising   */
+                                                         /* data by default.  */
+#endif
+
+#define WORK_QUEUE_SIZE                            (8)   /* Denotes the number*/
+                                                         /* of deferred work  */
+                                                         /* items (MUST be a  */
+                                                         /* power of two).    */
+
+#define WORK_QUEUE_PERIOD                          (1)   /* Denotes the period*/
+                                                         /* (in ms) at which  */
+                                                         /* the Work Queue is */
+                                                         /* executed.         */
+
+#ifndef NOTIFICATION_STORM_PERIOD
+#define NOTIFICATION_STORM_PERIOD                  (0)   /* Denotes the period*/
+                                                         /* (in ms) of the    */
+                                                         /* notification storm*/
+                                                         /* generator (zero   */
+                                                         /* disables it).     */
+#endif
+
+#define NOTIFICATION_STORM_BURST                   (8)   /* Denotes the max   */
+                                                         /* number of         */
+                                                         /* notifications sent*/
+                                                         /* per storm period. */
+
+   /* The following may be defined (project wide) to filter advertising */
+   /* through the White List of bonded devices.  By default only Scan   */
+   /* Requests are filtered (so any device may still connect and pair), */
+   /* WHITE_LIST_CONNECT_FILTER also filters Connect Requests.  Either  */
+   /* way the filter is lifted for WHITE_LIST_PAIRING_WINDOW ms after   */
+   /* start-up, so new devices can always be paired.                    */
+#ifndef DEFAULT_WHITE_LIST_MODE
+#define DEFAULT_WHITE_LIST_MODE                  (FALSE) /* Denotes whether   */
+                                                         /* advertising is    */
+                                                         /* filtered by the   */
+                                                         /* White List by     */
+                                                         /* default.          */
+#endif
+
+#ifndef WHITE_LIST_CONNECT_FILTER
+#define WHITE_LIST_CONNECT_FILTER                (FALSE) /* Denotes whether   */
+                                                         /* Connect Requests  */
+                                                         /* are filtered in   */
+                                                         /* White List Mode.  */
+#endif
+
+#define WHITE_LIST_PAIRING_WINDOW                (60000) /* Denotes the time  */
+                                                         /* (in ms) after     */
+                                                         /* start-up during   */
+                                                         /* which the White   */
+                                                         /* List is not used. */
+   
+
+#define NO_COMMAND_ERROR                           (-1)  /* Denotes that no   */
+                                                         /* command was       */
+                                                         /* specified to the  */
+                                                         /* parser.           */
+
+#define INVALID_COMMAND_ERROR                      (-2)  /* Denotes that the  */
+                                                         /* Command does not  */
+                                                         /* exist for         */
+                                                         /* processing.       */
+
+#define EXIT_CODE                                  (-3)  /* Denotes that the  */
+                                                         /* Command specified */
+                                                         /* was the Exit      */
+                                                         /* Command.          */
+
+#define FUNCTION_ERROR                             (-4)  /* Denotes that an   */
+                                                         /* error occurred in */
+                                                         /* execution of the  */
+                                                         /* Command Function. */
+
+#define TO_MANY_PARAMS                             (-5)  /* Denotes that there*/
+                                                         /* are more          */
+                                                         /* parameters then   */
+                                                         /* will fit in the   */
+                                                         /* UserCommand.      */
+
+#define INVALID_PARAMETERS_ERROR                   (-6)  /* Denotes that an   */
+                                                         /* error occurred due*/
+                                                         /* to the fact that  */
+                                                         /* one or more of the*/
+                                                         /* required          */
+                                                         /* parameters were   */
+                                                         /* invalid.          */
+
+#define UNABLE_TO_INITIALIZE_STACK                 (-7)  /* Denotes that an   */
+                                                         /* error occurred    */
+                                                         /* while Initializing*/
+                                                         /* the Bluetooth     */
+                                                         /* Protocol Stack.   */
+
+#define INVALID_STACK_ID_ERROR                     (-8)  /* Denotes that an   */
+                                                         /* occurred due to   */
+                                                         /* attempted         */
+                                                         /* execution of a    */
+                                                         /* Command when a    */
+                                                         /* Bluetooth Protocol*/
+                                                         /* Stack has not been*/
+                                                         /* opened.           */
+
+#define UNABLE_TO_REGISTER_SERVER                  (-9)  /* Denotes that an   */
+                                                         /* error occurred    */
+                                                         /* when trying to    */
+                                                         /* create a Serial   */
+                                                         /* Port Server.      */
+
+#define EXIT_TEST_MODE                             (-10) /* Flags exit from   */
+                                                         /* Test Mode.        */
+
+#define EXIT_MODE                                  (-11) /* Flags exit from   */
+                                                         /* any Mode.         */
+
+   /* Determine the Name we will use for this compilation.              */
+#define LE_DEMO_DEVICE_NAME                        "SPPLEDemo"
+
+   /* Following converts a Sniff Parameter in Milliseconds to frames.   */
+#define MILLISECONDS_TO_BASEBAND_SLOTS(_x)         ((_x) / (0.625))
+
+
+#define Display(_x)                                do { BTPS_OutputMessage _x; } while(0)
+#define LOG_ERROR(_x)	Display(_x)
+#define LOG_DEBUG(_x)	Display(_x)
+#define LOG_INFO(_x)	Display(_x)
+
+   /* The following represent the possible values of UI_Mode variable.  */
+#define UI_MODE_IS_CLIENT      (2)
+#define UI_MODE_IS_SERVER      (1)
+#define UI_MODE_SELECT         (0)
+#define UI_MODE_IS_INVALID     (-1)
+
+   /* The following type definition represents the structure which holds*/
+   /* all information about the parameter, in particular the parameter  */
+   /* as a string and the parameter as an unsigned int.                 */
+typedef struct _tagParameter_t
+{
+   char         *strParam;
+   SDWord_t      intParam;
+} Parameter_t;
+
+   /* The following type definition represents the structure which holds*/
+   /* a list of parameters that are to be associated with a command The */
+   /* NumberofParameters variable holds the value of the number of      */
+   /* parameters in the list.                                           */
+typedef struct _tagParameterList_t
+{
+   int         NumberofParameters;
+   Parameter_t Params[MAX_NUM_OF_PARAMETERS];
+} ParameterList_t;
+
+   /* The following type definition represents the structure which holds*/
+   /* the command and parameters to be executed.                        */
+typedef struct _tagUserCommand_t
+{
+   char            *Command;
+   ParameterList_t  Parameters;
+} UserCommand_t;
+
+   /* The following type definition represents the generic function     */
+   /* pointer to be used by all commands that can be executed by the    */
+   /* test program.                                                     */
+typedef int (*CommandFunction_t)(ParameterList_t *TempParam);
+
+   /* The following type definition represents the structure which holds*/
+   /* information used in the interpretation and execution of Commands. */
+typedef struct _tagCommandTable_t
+{
+   char              *CommandName;
+   CommandFunction_t  CommandFunction;
+} CommandTable_t;
+
+   /* Structure used to hold all of the GAP LE Parameters.              */
+typedef struct _tagGAPLE_Parameters_t
+{
+   GAP_LE_Connectability_Mode_t ConnectableMode;
+   GAP_Discoverability_Mode_t   DiscoverabilityMode;
+   GAP_LE_IO_Capability_t       IOCapability;
+   Boolean_t                    MITMProtection;
+   Boolean_t                    OOBDataPresent;
+   Boolean_t                    BroadcastMode;
+   Boolean_t                    WhiteListMode;
+} GAPLE_Parameters_t;
+
+#define GAPLE_PARAMETERS_DATA_SIZE                       (sizeof(GAPLE_Parameters_t))
+
+   /* The following enumerates the work that is deferred from the       */
+   /* Bluetooth callbacks to the main loop (see ScheduleWork()).        */
+typedef enum
+{
+   wtReconnect,
+   wtAdvertise,
+   wtLongTermKeyRequest,
+   wtEncryptionInformationRequest,
+   wtBootReport
+} Work_Type_t;
+
+   /* The following structure represents a single deferred work item.   */
+   /* The BD_ADDR, EDIV, Rand and KeySize members are only valid for the*/
+   /* work types that need them.                                        */
+typedef struct _tagWork_Item_t
+{
+   Work_Type_t     Type;
+   BD_ADDR_t       BD_ADDR;
+   Word_t          EDIV;
+   Random_Number_t Rand;
+   Byte_t          KeySize;
+} Work_Item_t;
+
+#define WORK_ITEM_DATA_SIZE                              (sizeof(Work_Item_t))
+
+   /* The following structure holds the bonding information of an LE    */
+   /* device that is retained across an in-place restart of the stack   */
+   /* (see CloseStack()), together with the Client Characteristic       */
+   /* Configurations of the bonded device.                              */
+typedef struct _tagRetained_Bond_t
+{
+   Byte_t                Flags;
+   Byte_t                EncryptionKeySize;
+   GAP_LE_Address_Type_t ConnectionAddressType;
+   BD_ADDR_t             ConnectionBD_ADDR;
+   Long_Term_Key_t       LTK;
+   Random_Number_t       Rand;
+   Word_t                EDIV;
+   Word_t                Button_Client_Configuration_Descriptor;
+   Word_t                History_Client_Configuration_Descriptor;
+   Word_t                Gesture_Client_Configuration_Descriptor;
+   Word_t                Inputs_Client_Configuration_Descriptor;
+} Retained_Bond_t;
+
+#define RETAINED_BOND_DATA_SIZE                          (sizeof(Retained_Bond_t))
+
+   /* The following structure holds status information about a send     */
+   /* process.                                                          */
+typedef struct _tagSend_Info_t
+{
+   DWord_t BytesToSend;
+   DWord_t BytesSent;
+} Send_Info_t;
+
+   /* The following defines the format of a SPPLE Data Buffer.          */
+typedef struct __tagSPPLE_Data_Buffer_t
+{
+   unsigned int  InIndex;
+   unsigned int  OutIndex;
+   unsigned int  BytesFree;
+   unsigned int  BufferSize;
+   Byte_t        Buffer[SPPLE_DATA_CREDITS];
+} SPPLE_Data_Buffer_t;
+
+   /* The following structure represents the information we will store  */
+   /* on a Discovered GAP Service.                                      */
+typedef struct _tagGAPS_Client_Info_t
+{
+   Word_t DeviceNameHandle;
+   Word_t DeviceAppearanceHandle;
+} GAPS_Client_Info_t;
+
+   /* The following structure holds information on known Device         */
+   /* Appearance Values.                                                */
+typedef struct _tagGAPS_Device_Appearance_Mapping_t
+{
+   Word_t  Appearance;
+   char   *String;
+} GAPS_Device_Appearance_Mapping_t;
+
+   /* The following structure for a Master is used to hold a list of    */
+   /* information on all paired devices. For slave we will not use this */
+   /* structure.                                                        */
+typedef struct _tagDeviceInfoInfo_t
+{
+   Byte_t                       Flags;
+   Byte_t                       EncryptionKeySize;
+   GAP_LE_Address_Type_t        ConnectionAddressType;
+   BD_ADDR_t                    ConnectionBD_ADDR;
+   Long_Term_Key_t              LTK;
+   Random_Number_t              Rand;
+   Word_t                       EDIV;
+   unsigned int                 TransmitCredits;
+   SPPLE_Data_Buffer_t          ReceiveBuffer;
+   SPPLE_Data_Buffer_t          TransmitBuffer;
+   GAPS_Client_Info_t           GAPSClientInfo;
+   SPPLE_Client_Info_t          ClientInfo;
+   SPPLE_Server_Info_t          ServerInfo;
+   MYLE_Server_Info_t           MYLEServerInfo;
+   struct _tagDeviceInfoInfo_t *NextDeviceInfoInfoPtr;
+} DeviceInfo_t;
+
+#define DEVICE_INFO_DATA_SIZE                            (sizeof(DeviceInfo_t))
+
+   /* Defines the bit mask flags that may be set in the DeviceInfo_t    */
+   /* structure.                                                        */
+#define DEVICE_INFO_FLAGS_LTK_VALID                         0x01
+#define DEVICE_INFO_FLAGS_SERVICE_DISCOVERY_OUTSTANDING     0x02
+
+   /* User to represent a structure to hold a BD_ADDR return from       */
+   /* BD_ADDRToStr.                                                     */
+typedef char BoardStr_t[16];
+
+                        /* The Encryption Root Key should be generated  */
+                        /* in such a way as to guarantee 128 bits of    */
+                        /* entropy.                                     */
+static BTPSCONST Encryption_Key_t ER = {0x28, 0xBA, 0xE1, 0x37, 0x13, 0xB2, 0x20, 0x45, 0x16, 0xB2, 0x19, 0xD0, 0x80, 0xEE, 0x4A, 0x51};
+
+                        /* The Identity Root Key should be generated    */
+                        /* in such a way as to guarantee 128 bits of    */
+                        /* entropy.                                     */
+static BTPSCONST Encryption_Key_t IR = {0x41, 0x09, 0xA0, 0x88, 0x09, 0x6B, 0x70, 0xC0, 0x95, 0x23, 0x3C, 0x8C, 0x48, 0xFC, 0xC9, 0xFE};
+
+                        /* The following keys can be regerenated on the */
+                        /* fly using the constant IR and ER keys and    */
+                        /* are used globally, for all devices.          */
+static Encryption_Key_t DHK;
+static Encryption_Key_t IRK;
+
+                        /* Flags that DHK and IRK have been generated.  */
+                        /* They are only generated when they are first  */
+                        /* needed and are retained across an in-place   */
+                        /* restart of the stack.                        */
+static Boolean_t        KeysDiversified;
+
+   /* Internal Variables to this Module (Remember that all variables    */
+   /* declared static are initialized to 0 automatically by the         */
+   /* compiler as part of standard C/C++).                              */
+
+static unsigned int        GAPSInstanceID;          /* Holds the Instance ID for the   */
+                                                    /* GAP Service.                    */
+
+static unsigned int        HCIEventCallbackID;      /* Holds the Callback ID of the    */
+                                                    /* HCI Event Callback.             */
+
+static Work_Item_t         WorkQueue[WORK_QUEUE_SIZE]; /* Holds the work that has been */
+                                                    /* deferred from the Bluetooth     */
+                                                    /* callbacks to the main loop.     */
+
+static unsigned int        WorkQueueHead;           /* Holds the number of work items  */
+static unsigned int        WorkQueueTail;           /* queued and executed (the        */
+                                                    /* difference is the number of     */
+                                                    /* pending items).                 */
+
+static unsigned int        WorkQueueOverflows;      /* Holds the number of work items  */
+                                                    /* that had to be executed inline  */
+                                                    /* because the queue was full.     */
+
+static Retained_Bond_t     RetainedBonds[BOND_TABLE_SIZE]; /* Holds the LE bonds that  */
+static unsigned int        RetainedBondCount;       /* are retained while the stack is */
+                                                    /* restarted.                      */
+
+static Boolean_t           StackRestart;            /* Flags that the stack has been   */
+                                                    /* opened before (so the Bond Table*/
+                                                    /* is retained).                   */
+
+static Boolean_t           ApplicationFailed;       /* Flags that the application can  */
+                                                    /* no longer recover on its own    */
+                                                    /* (see QueryApplicationFailed()). */
+
+static GAPLE_Parameters_t  LE_Parameters;           /* Holds GAP Parameters like       */
+                                                    /* Discoverability, Connectability */
+                                                    /* Modes.                          */
+
+static DeviceInfo_t       *DeviceInfoList;          /* Holds the list head for the     */
+                                                    /* device info list.               */
+
+static unsigned int        BluetoothStackID;        /* Variable which holds the Handle */
+                                                    /* of the opened Bluetooth Protocol*/
+                                                    /* Stack.                          */
+
+static BD_ADDR_t           ConnectionBD_ADDR;       /* Holds the BD_ADDR of the        */
+                                                    /* currently connected device.     */
+
+static unsigned int        ConnectionID;            /* Holds the Connection ID of the  */
+                                                    /* currently connected device.     */
+
+static Boolean_t           ConnectionEncrypted;     /* Flags that the link to the      */
+                                                    /* currently connected device is   */
+                                                    /* encrypted.                      */
+
+static BD_ADDR_t           LastBondedBD_ADDR;       /* Holds the BD_ADDR of the most   */
+                                                    /* recently bonded device.         */
+
+static unsigned int        WhiteListSize;           /* Holds the number of entries of  */
+                                                    /* the controller's White List.    */
+
+static unsigned int        WhiteListCount;          /* Holds the number of bonded      */
+                                                    /* devices currently in the White  */
+                                                    /* List.                           */
+
+static Boolean_t           PairingWindowOpen;       /* Flags that the White List is not*/
+                                                    /* used yet, so that new devices   */
+                                                    /* can pair.                       */
+
+static Byte_t              BroadcastSequence;       /* Holds the rolling sequence      */
+                                                    /* number of the button state that */
+                                                    /* is broadcast in the advertising */
+                                                    /* data.                           */
+
+static Word_t              ConnectionMTU;           /* Holds the ATT MTU of the        */
+                                                    /* currently connected device.     */
+
+static DWord_t             JournalSequence;         /* Holds the Event Log sequence    */
+                                                    /* number of the first transition  */
+                                                    /* that has not yet been delivered */
+                                                    /* to the client.                  */
+
+static DWord_t             JournalLostCount;        /* Holds the number of transitions */
+                                                    /* that were overwritten before    */
+                                                    /* they could be delivered.        */
+
+static Boolean_t           JournalReliable;         /* Flags whether the client        */
+                                                    /* acknowledges the journal on the */
+                                                    /* current connection.             */
+
+static DWord_t             JournalAckSequence;      /* Holds the sequence number of the*/
+static DWord_t             JournalAckTime;          /* first unacknowledged transition */
+                                                    /* and the time of the last        */
+                                                    /* acknowledgement.                */
+
+static DWord_t             RetransmitSequence;      /* Holds the range of transitions  */
+static DWord_t             RetransmitEnd;           /* that is to be retransmitted.    */
+
+static Gesture_Event_t     LastGesture;             /* Holds the last gesture that was */
+                                                    /* recognized.                     */
+
+static Input_Bitmap_t      InputState;              /* Holds the state of all inputs at*/
+                                                    /* the last button poll.           */
+
+#ifndef LE_ONLY_BUILD
+
+static BD_ADDR_t           CurrentCBRemoteBD_ADDR;  /* Variable which holds the        */
+                                                    /* current CB BD_ADDR of the device*/
+                                                    /* which is currently pairing or   */
+                                                    /* authenticating.                 */
+
+
+static GAP_IO_Capability_t IOCapability;            /* Variable which holds the        */
+                                                    /* current I/O Capabilities that   */
+                                                    /* are to be used for Secure Simple*/
+                                                    /* Pairing.                        */
+
+static Boolean_t           MITMProtection;          /* Variable which flags whether or */
+                                                    /* not Man in the Middle (MITM)    */
+                                                    /* protection is to be requested   */
+                                                    /* during a Secure Simple Pairing  */
+                                                    /* procedure.                      */
+
+#endif
+
+unsigned int ServiceID;
+
+int g_button_state = 0;
+
+   /* The following string table is used to map HCI Version information */
+   /* to an easily displayable version string.                          */
+static BTPSCONST char *HCIVersionStrings[] =
+{
+   "1.0b",
+   "1.1",
+   "1.2",
+   "2.0",
+   "2.1",
+   "3.0",
+   "4.0",
+   "Unknown (greater 4.0)"
+} ;
+
+#define NUM_SUPPORTED_HCI_VERSIONS              (sizeof(HCIVersionStrings)/sizeof(char *) - 1)
+
+static Boolean_t CreateNewDeviceInfoEntry(DeviceInfo_t **ListHead, GAP_LE_Address_Type_t ConnectionAddressType, BD_ADDR_t ConnectionBD_ADDR);
+static DeviceInfo_t *SearchDeviceInfoEntryByBD_ADDR(DeviceInfo_t **ListHead, BD_ADDR_t BD_ADDR);
+static DeviceInfo_t *DeleteDeviceInfoEntry(DeviceInfo_t **ListHead, BD_ADDR_t BD_ADDR);
+static void FreeDeviceInfoEntryMemory(DeviceInfo_t *EntryToFree);
+static void FreeDeviceInfoList(DeviceInfo_t **ListHead);
+
+static void BD_ADDRToStr(BD_ADDR_t Board_Address, BoardStr_t BoardStr);
+
+static void DisplayFunctionError(char *Function,int Status);
+static void DisplayFunctionSuccess(char *Function);
+static void DisplayLocalDevice(void);
+
+static void SaveBonds(void);
+static void RestoreBonds(void);
+static int OpenStack(HCI_DriverInformation_t *HCI_DriverInformation, BTPS_Initialization_t *BTPS_Initialization);
+static int CloseStack(void);
+
+static int SetDisc(void);
+static int SetConnect(void);
+static int SetPairable(void);
+
+static void ConfigureCapabilities(GAP_LE_Pairing_Capabilities_t *Capabilities);
+static int SlavePairingRequestResponse(BD_ADDR_t BD_ADDR);
+static int EncryptionInformationRequestResponse(BD_ADDR_t BD_ADDR, Byte_t KeySize, GAP_LE_Authentication_Response_Information_t *GAP_LE_Authentication_Response_Information);
+static int LongTermKeyRequestResponse(BD_ADDR_t BD_ADDR, Word_t EDIV, Random_Number_t Rand);
+static int DiversifyKeys(void);
+#ifndef LE_ONLY_BUILD
+static int DeleteLinkKey(BD_ADDR_t BD_ADDR);
+#endif
+static void ForgetBond(Bond_Entry_t *BondEntry);
+
+#ifndef LE_ONLY_BUILD
+static int PINCodeResponse(ParameterList_t *TempParam);
+#endif
+static int AddDeviceToWhiteList(GAP_LE_Address_Type_t AddressType, BD_ADDR_t BD_ADDR);
+static int RemoveDeviceFromWhiteList(GAP_LE_Address_Type_t AddressType, BD_ADDR_t BD_ADDR);
+static int SetAdvertisingData(void);
+static int AdvertiseLE(ParameterList_t *TempParam);
+static int AdvertiseLEDirected(GAP_LE_Address_Type_t AddressType, BD_ADDR_t BD_ADDR);
+static int ReconnectLE(void);
+static void PairingWindowFunction(void *UserParameter);
+
+static void ProcessWork(Work_Item_t *WorkItem);
+static void ScheduleWork(Work_Item_t *WorkItem);
+static void WorkQueueFunction(void *UserParameter);
+
+static void DrainJournal(void);
+
+static void GestureCallback(BTPSCONST Gesture_Event_t *Event);
+static void NotifyInputs(BTPSCONST Input_Bitmap_t *State, BTPSCONST Input_Bitmap_t *Changes);
+
+#if NOTIFICATION_STORM_PERIOD
+static void NotificationStormFunction(void *UserParameter);
+#endif
+
+   /* BTPS Callback function prototypes.                                */
+static void BTPSAPI GAP_LE_Event_Callback(unsigned int BluetoothStackID,GAP_LE_Event_Data_t *GAP_LE_Event_Data, unsigned long CallbackParameter);
+static void BTPSAPI GATT_ServerEventCallback(unsigned int BluetoothStackID, GATT_Server_Event_Data_t *GATT_ServerEventData, unsigned long CallbackParameter);
+static void BTPSAPI GATT_Connection_Event_Callback(unsigned int BluetoothStackID, GATT_Connection_Event_Data_t *GATT_Connection_Event_Data, unsigned long CallbackParameter);
+#ifndef LE_ONLY_BUILD
+static void BTPSAPI GAP_Event_Callback(unsigned int BluetoothStackID, GAP_Event_Data_t *GAP_Event_Data, unsigned long CallbackParameter);
+#endif
+static void BTPSAPI HCI_Event_Callback(unsigned int BluetoothStackID, HCI_Event_Data_t *HCI_Event_Data, unsigned long CallbackParameter);
+static void BTPSAPI HCI_Debug_Callback(unsigned int BluetoothStackID, Boolean_t PacketSent, HCI_Packet_t *HCIPacket, unsigned long CallbackParameter);
+
+   /* The following function adds the specified Entry to the specified  */
+   /* List.  This function allocates and adds an entry to the list that */
+   /* has the same attributes as parameters to this function.  This     */
+   /* function will return FALSE if NO Entry was added.  This can occur */
+   /* if the element passed in was deemed invalid or the actual List    */
+   /* Head was invalid.                                                 */
+   /* ** NOTE ** This function does not insert duplicate entries into   */
+   /*            the list.  An element is considered a duplicate if the */
+   /*            Connection BD_ADDR.  When this occurs, this function   */
+   /*            returns NULL.                                          */
+static Boolean_t CreateNewDeviceInfoEntry(DeviceInfo_t **ListHead, GAP_LE_Address_Type_t ConnectionAddressType, BD_ADDR_t ConnectionBD_ADDR)
+{
+   Boolean_t     ret_val = FALSE;
+   DeviceInfo_t *DeviceInfoPtr;
+
+   /* Verify that the passed in parameters seem semi-valid.             */
+   if((ListHead) && (!COMPARE_NULL_BD_ADDR(ConnectionBD_ADDR)))
+   {
+      /* Allocate the memory for the entry.                             */
+      if((DeviceInfoPtr = BTPS_AllocateMemory(sizeof(DeviceInfo_t))) != NULL)
+      {
+         /* Initialize the entry.                                       */
+         BTPS_MemInitialize(DeviceInfoPtr, 0, sizeof(DeviceInfo_t));
+         DeviceInfoPtr->ConnectionAddressType = ConnectionAddressType;
+         DeviceInfoPtr->ConnectionBD_ADDR     = ConnectionBD_ADDR;
+
+         ret_val = BSC_AddGenericListEntry_Actual(ekBD_ADDR_t, BTPS_STRUCTURE_OFFSET(DeviceInfo_t, ConnectionBD_ADDR), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, NextDeviceInfoInfoPtr), (void **)(ListHead), (void *)(DeviceInfoPtr));
+         if(!ret_val)
+         {
+            /* Failed to add to list so we should free the memory that  */
+            /* we allocated for the entry.                              */
+            BTPS_FreeMemory(DeviceInfoPtr);
+         }
+      }
+   }
+
+   return(ret_val);
+}
+
+   /* The following function searches the specified List for the        */
+   /* specified Connection BD_ADDR.  This function returns NULL if      */
+   /* either the List Head is invalid, the BD_ADDR is invalid, or the   */
+   /* Connection BD_ADDR was NOT found.                                 */
+static DeviceInfo_t *SearchDeviceInfoEntryByBD_ADDR(DeviceInfo_t **ListHead, BD_ADDR_t BD_ADDR)
+{
+   return(BSC_SearchGenericListEntry(ekBD_ADDR_t, (void *)(&BD_ADDR), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, ConnectionBD_ADDR), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, NextDeviceInfoInfoPtr), (void **)(ListHead)));
+}
+
+   /* The following function searches the specified Key Info List for   */
+   /* the specified BD_ADDR and removes it from the List.  This function*/
+   /* returns NULL if either the List Head is invalid, the BD_ADDR is   */
+   /* invalid, or the specified Entry was NOT present in the list.  The */
+   /* entry returned will have the Next Entry field set to NULL, and    */
+   /* the caller is responsible for deleting the memory associated with */
+   /* this entry by calling the FreeKeyEntryMemory() function.          */
+static DeviceInfo_t *DeleteDeviceInfoEntry(DeviceInfo_t **ListHead, BD_ADDR_t BD_ADDR)
+{
+   return(BSC_DeleteGenericListEntry(ekBD_ADDR_t, (void *)(&BD_ADDR), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, ConnectionBD_ADDR), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, NextDeviceInfoInfoPtr), (void **)(ListHead)));
+}
+
+   /* This function frees the specified Key Info Information member     */
+   /* memory.                                                           */
+static void FreeDeviceInfoEntryMemory(DeviceInfo_t *EntryToFree)
+{
+   BSC_FreeGenericListEntryMemory((void *)(EntryToFree));
+}
+
+   /* The following function deletes (and free's all memory) every      */
+   /* element of the specified Key Info List. Upon return of this       */
+   /* function, the Head Pointer is set to NULL.                        */
+static void FreeDeviceInfoList(DeviceInfo_t **ListHead)
+{
+   BSC_FreeGenericListEntryList((void **)(ListHead), BTPS_STRUCTURE_OFFSET(DeviceInfo_t, NextDeviceInfoInfoPtr));
+}
+
+   /* The following function is responsible for converting data of type */
+   /* BD_ADDR to a string.  The first parameter of this function is the */
+   /* BD_ADDR to be converted to a string.  The second parameter of this*/
+   /* function is a pointer to the string in which the converted BD_ADDR*/
+   /* is to be stored.                                                  */
+static void BD_ADDRToStr(BD_ADDR_t Board_Address, BoardStr_t BoardStr)
+{
+   BTPS_SprintF((char *)BoardStr, "0x%02X%02X%02X%02X%02X%02X", Board_Address.BD_ADDR5, Board_Address.BD_ADDR4, Board_Address.BD_ADDR3, Board_Address.BD_ADDR2, Board_Address.BD_ADDR1, Board_Address.BD_ADDR0);
+}
+
+   /* Displays a function error message.                                */
+static void DisplayFunctionError(char *Function,int Status)
+{
+   Display(("%s Failed: %d.\r\n", Function, Status));
+}
+
+   /* Displays a function success message.                              */
+static void DisplayFunctionSuccess(char *Function)
+{
+   Display(("%s success.\r\n",Function));
+}
+
+   /* The following function displays the chipset and the Bluetooth     */
+   /* Device Address of the local device.  This function is only called */
+   /* once advertising has been enabled, since the queries are not      */
+   /* needed to start up.                                               */
+static void DisplayLocalDevice(void)
+{
+   BoardStr_t    BluetoothAddress;
+   BD_ADDR_t     BD_ADDR;
+   HCI_Version_t HCIVersion;
+
+   if(BluetoothStackID)
+   {
+      if(!HCI_Version_Supported(BluetoothStackID, &HCIVersion))
+         Display(("Device Chipset: %s.\r\n", (HCIVersion <= NUM_SUPPORTED_HCI_VERSIONS)?HCIVersionStrings[HCIVersion]:HCIVersionStrings[NUM_SUPPORTED_HCI_VERSIONS]));
+
+      /* Let's output the Bluetooth Device Address so that the user     */
+      /* knows what the Device Address is.                              */
+      if(!GAP_Query_Local_BD_ADDR(BluetoothStackID, &BD_ADDR))
+      {
+         BD_ADDRToStr(BD_ADDR, BluetoothAddress);
+
+         Display(("BD_ADDR: %s\r\n", BluetoothAddress));
+      }
+   }
+}
+
+   /* The following function is responsible for saving the bonding      */
+   /* information of all bonded LE devices (which is lost when the      */
+   /* Device Info List is freed) so that it can be restored when the    */
+   /* stack is opened again.                                            */
+static void SaveBonds(void)
+{
+   DeviceInfo_t    *DeviceInfo;
+   Retained_Bond_t *RetainedBond;
+
+   RetainedBondCount = 0;
+
+   for(DeviceInfo = DeviceInfoList; (DeviceInfo) && (RetainedBondCount < BOND_TABLE_SIZE); DeviceInfo = DeviceInfo->NextDeviceInfoInfoPtr)
+   {
+      if(DeviceInfo->Flags & DEVICE_INFO_FLAGS_LTK_VALID)
+      {
+         RetainedBond = &(RetainedBonds[RetainedBondCount++]);
+
+         RetainedBond->Flags                                   = DeviceInfo->Flags;
+         RetainedBond->EncryptionKeySize                       = DeviceInfo->EncryptionKeySize;
+         RetainedBond->ConnectionAddressType                   = DeviceInfo->ConnectionAddressType;
+         RetainedBond->ConnectionBD_ADDR                       = DeviceInfo->ConnectionBD_ADDR;
+         RetainedBond->LTK                                     = DeviceInfo->LTK;
+         RetainedBond->Rand                                    = DeviceInfo->Rand;
+         RetainedBond->EDIV                                    = DeviceInfo->EDIV;
+         RetainedBond->Button_Client_Configuration_Descriptor  = DeviceInfo->MYLEServerInfo.Button_Client_Configuration_Descriptor;
+         RetainedBond->History_Client_Configuration_Descriptor = DeviceInfo->MYLEServerInfo.History_Client_Configuration_Descriptor;
+         RetainedBond->Gesture_Client_Configuration_Descriptor = DeviceInfo->MYLEServerInfo.Gesture_Client_Configuration_Descriptor;
+         RetainedBond->Inputs_Client_Configuration_Descriptor  = DeviceInfo->MYLEServerInfo.Inputs_Client_Configuration_Descriptor;
+      }
+   }
+}
+
+   /* The following function is responsible for restoring the bonding   */
+   /* information that was saved by SaveBonds() into the (empty) Device */
+   /* Info List.  The bonded devices are also added to the White List   */
+   /* again, since it is cleared when the controller is reset.          */
+static void RestoreBonds(void)
+{
+   unsigned int     Index;
+   DeviceInfo_t    *DeviceInfo;
+   Retained_Bond_t *RetainedBond;
+
+   for(Index = 0; Index < RetainedBondCount; Index++)
+   {
+      RetainedBond = &(RetainedBonds[Index]);
+
+      if(CreateNewDeviceInfoEntry(&DeviceInfoList, RetainedBond->ConnectionAddressType, RetainedBond->ConnectionBD_ADDR))
+      {
+         if((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, RetainedBond->ConnectionBD_ADDR)) != NULL)
+         {
+            DeviceInfo->Flags                                                  = RetainedBond->Flags;
+            DeviceInfo->EncryptionKeySize                                      = RetainedBond->EncryptionKeySize;
+            DeviceInfo->LTK                                                    = RetainedBond->LTK;
+            DeviceInfo->Rand                                                   = RetainedBond->Rand;
+            DeviceInfo->EDIV                                                   = RetainedBond->EDIV;
+            DeviceInfo->MYLEServerInfo.Button_Client_Configuration_Descriptor  = RetainedBond->Button_Client_Configuration_Descriptor;
+            DeviceInfo->MYLEServerInfo.History_Client_Configuration_Descriptor = RetainedBond->History_Client_Configuration_Descriptor;
+            DeviceInfo->MYLEServerInfo.Gesture_Client_Configuration_Descriptor = RetainedBond->Gesture_Client_Configuration_Descriptor;
+            DeviceInfo->MYLEServerInfo.Inputs_Client_Configuration_Descriptor  = RetainedBond->Inputs_Client_Configuration_Descriptor;
+
+            AddDeviceToWhiteList(DeviceInfo->ConnectionAddressType, DeviceInfo->ConnectionBD_ADDR);
+         }
+      }
+   }
+
+   if(RetainedBondCount)
+      Display(("Restored %u bonded device(s).\r\n", RetainedBondCount));
+
+   RetainedBondCount = 0;
+}
+
+   /* The following function is responsible for opening the SS1         */
+   /* Bluetooth Protocol Stack.  This function accepts a pre-populated  */
+   /* HCI Driver Information structure that contains the HCI Driver     */
+   /* Transport Information.  This function returns zero on successful  */
+   /* execution and a negative value on all errors.                     */
+static int OpenStack(HCI_DriverInformation_t *HCI_DriverInformation, BTPS_Initialization_t *BTPS_Initialization)
+{
+   int                           Result;
+   int                           ret_val = 0;
+   unsigned int                  ServiceID;
+#ifndef LE_ONLY_BUILD
+   Byte_t                        Status;
+   BD_ADDR_t                     BD_ADDR;
+   L2CA_Link_Connect_Params_t    L2CA_Link_Connect_Params;
+#endif
+
+   /* First check to see if the Stack has already been opened.          */
+   if(!BluetoothStackID)
+   {
+      /* Next, makes sure that the Driver Information passed appears to */
+      /* be semi-valid.                                                 */
+      if(HCI_DriverInformation)
+      {
+         /* Initialize BTPSKNRl.                                        */
+         BTPS_Init((void *)BTPS_Initialization);
+
+         Display(("OpenStack().\r\n"));
+
+         /* Initialize the Stack                                        */
+         Result = BSC_Initialize(HCI_DriverInformation, 0);
+
+         /* Next, check the return value of the initialization to see   */
+         /* if it was successful.                                       */
+         if(Result > 0)
+         {
+            /* The Stack was initialized successfully, inform the user  */
+            /* and set the return value of the initialization function  */
+            /* to the Bluetooth Stack ID.                               */
+            BluetoothStackID = Result;
+            Display(("Bluetooth Stack ID: %d.\r\n", BluetoothStackID));
+
+            BootTime_Mark(bpController);
+
+            /* Watch the HCI packets that are exchanged with the        */
+            /* controller from now on (see HCI_Debug_Callback()).       */
+            if(BSC_RegisterDebugCallback(BluetoothStackID, HCI_Debug_Callback, 0))
+               Display(("Unable to register the HCI Debug Callback.\r\n"));
+
+            /* Initialize the Default Pairing Parameters.               */
+            LE_Parameters.IOCapability   = licNoInputNoOutput;
+            LE_Parameters.MITMProtection = FALSE;
+            LE_Parameters.OOBDataPresent = FALSE;
+
+            /* Initialize the default Broadcast Mode.                   */
+            LE_Parameters.BroadcastMode  = DEFAULT_BROADCAST_MODE;
+
+            /* Initialize the default White List Mode.                  */
+            LE_Parameters.WhiteListMode  = DEFAULT_WHITE_LIST_MODE;
+
+#ifndef LE_ONLY_BUILD
+
+            /* Initialize the default Secure Simple Pairing parameters. */
+            IOCapability                 = icNoInputNoOutput;
+            MITMProtection               = FALSE;
+
+#endif
+
+            /* * NOTE * The chipset and the Bluetooth Device Address are*/
+            /*          only displayed once advertising has been enabled*/
+            /*          (see DisplayLocalDevice()), so that they do not */
+            /*          delay the start-up.                             */
+
+            /* Determine how many bonded devices can be placed in the   */
+            /* controller's White List (which is empty after reset).    */
+            if(!GAP_LE_Read_White_List_Size(BluetoothStackID, &WhiteListSize))
+               Display(("White List Size: %u.\r\n", WhiteListSize));
+            else
+               WhiteListSize = 0;
+
+            WhiteListCount = 0;
+
+#ifndef LE_ONLY_BUILD
+
+            /* Go ahead and allow Master/Slave Role Switch.             */
+            L2CA_Link_Connect_Params.L2CA_Link_Connect_Request_Config  = cqAllowRoleSwitch;
+            L2CA_Link_Connect_Params.L2CA_Link_Connect_Response_Config = csMaintainCurrentRole;
+
+            L2CA_Set_Link_Connection_Configuration(BluetoothStackID, &L2CA_Link_Connect_Params);
+
+            if(HCI_Command_Supported(BluetoothStackID, HCI_SUPPORTED_COMMAND_WRITE_DEFAULT_LINK_POLICY_BIT_NUMBER) > 0)
+               HCI_Write_Default_Link_Policy_Settings(BluetoothStackID, (HCI_LINK_POLICY_SETTINGS_ENABLE_MASTER_SLAVE_SWITCH|HCI_LINK_POLICY_SETTINGS_ENABLE_SNIFF_MODE), &Status);
+
+            /* Delete all Stored Link Keys (unless the stack is         */
+            /* restarted in place, in which case the Bond Table is      */
+            /* retained).                                               */
+            if(!StackRestart)
+            {
+               ASSIGN_BD_ADDR(BD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+
+               DeleteLinkKey(BD_ADDR);
+            }
+
+            ASSIGN_BD_ADDR(CurrentCBRemoteBD_ADDR, 0, 0, 0, 0, 0, 0);
+
+#else
+
+            /* There are no stored link keys in an LE only build, simply*/
+            /* empty the Bond Table (unless the stack is restarted in   */
+            /* place).                                                  */
+            if(!StackRestart)
+               BondTable_Initialize();
+
+#endif
+
+            /* Flag that no connection is currently active.             */
+            ASSIGN_BD_ADDR(ConnectionBD_ADDR, 0, 0, 0, 0, 0, 0);
+
+            /* Flag that we have no Key Information in the Key List.    */
+            DeviceInfoList = NULL;
+
+            /* Initialize the GATT Service.                             */
+            if(!(Result = GATT_Initialize(BluetoothStackID, GATT_INITIALIZATION_FLAGS_SUPPORT_LE, GATT_Connection_Event_Callback, 0)))
+            {
+               /* Initialize the GAPS Service.                          */
+               Result = GAPS_Initialize_Service(BluetoothStackID, &ServiceID);
+               if(Result > 0)
+               {
+                  /* Save the Instance ID of the GAP Service.           */
+                  GAPSInstanceID = (unsigned int)Result;
+
+                  /* Set the GAP Device Name and Device Appearance.     */
+                  GAPS_Set_Device_Name(BluetoothStackID, GAPSInstanceID, LE_DEMO_DEVICE_NAME);
+                  GAPS_Set_Device_Appearance(BluetoothStackID, GAPSInstanceID, GAP_DEVICE_APPEARENCE_VALUE_GENERIC_COMPUTER);
+                  GAP_Set_Local_Device_Name(BluetoothStackID, LE_DEMO_DEVICE_NAME);
+
+                  /* Register for HCI Events to measure when the        */
+                  /* controller has sent a notification.                */
+                  if((Result = HCI_Register_Event_Callback(BluetoothStackID, HCI_Event_Callback, 0)) > 0)
+                     HCIEventCallbackID = (unsigned int)Result;
+                  else
+                     DisplayFunctionError("HCI_Register_Event_Callback", Result);
+
+                  /* Restore the bonds that were retained across a      */
+                  /* restart.  This is only done once the stack is fully*/
+                  /* up, if opening the stack fails the bonds stay      */
+                  /* retained for the next attempt.                     */
+                  RestoreBonds();
+
+                  BootTime_Mark(bpStack);
+
+                  /* Return success to the caller.                      */
+                  ret_val        = 0;
+               }
+               else
+               {
+                  /* The Stack was NOT initialized successfully, inform */
+                  /* the user and set the return value of the           */
+                  /* initialization function to an error.               */
+                  DisplayFunctionError("GAPS_Initialize_Service", Result);
+
+                  /* Cleanup GATT Module.                               */
+                  GATT_Cleanup(BluetoothStackID);
+
+                  /* Close the Stack so that it may be opened again.    */
+                  BSC_Shutdown(BluetoothStackID);
+
+                  BluetoothStackID = 0;
+
+                  ret_val          = UNABLE_TO_INITIALIZE_STACK;
+               }
+            }
+            else
+            {
+               /* The Stack was NOT initialized successfully, inform the*/
+               /* user and set the return value of the initialization   */
+               /* function to an error.                                 */
+               DisplayFunctionError("GATT_Initialize", Result);
+
+               /* Close the Stack so that it may be opened again.       */
+               BSC_Shutdown(BluetoothStackID);
+
+               BluetoothStackID = 0;
+
+               ret_val          = UNABLE_TO_INITIALIZE_STACK;
+            }
+         }
+         else
+         {
+            /* The Stack was NOT initialized successfully, inform the   */
+            /* user and set the return value of the initialization      */
+            /* function to an error.                                    */
+            DisplayFunctionError("BSC_Initialize", Result);
+
+            BluetoothStackID = 0;
+
+            ret_val          = UNABLE_TO_INITIALIZE_STACK;
+         }
+      }
+      else
+      {
+         /* One or more of the necessary parameters are invalid.        */
+         ret_val = INVALID_PARAMETERS_ERROR;
+      }
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for closing the SS1         */
+   /* Bluetooth Protocol Stack.  This function requires that the        */
+   /* Bluetooth Protocol stack previously have been initialized via the */
+   /* OpenStack() function.  This function returns zero on successful   */
+   /* execution and a negative value on all errors.                     */
+static int CloseStack(void)
+{
+   int ret_val = 0;
+
+   /* First check to see if the Stack has been opened.                  */
+   if(BluetoothStackID)
+   {
+      /* Cleanup GAP Service Module.                                    */
+      if(GAPSInstanceID)
+         GAPS_Cleanup_Service(BluetoothStackID, GAPSInstanceID);
+
+      /* Un-registered SPP LE Service.                                  */
+      if(ServiceID)
+         GATT_Un_Register_Service(BluetoothStackID, ServiceID);
+
+      /* Cleanup GATT Module.                                           */
+      GATT_Cleanup(BluetoothStackID);
+
+      /* Un-register the HCI Event Callback.                            */
+      if(HCIEventCallbackID)
+      {
+         HCI_Un_Register_Callback(BluetoothStackID, HCIEventCallbackID);
+
+         HCIEventCallbackID = 0;
+      }
+
+      /* Stop watching the HCI packets.                                 */
+      BSC_UnRegisterDebugCallback(BluetoothStackID);
+
+      /* Retain the bonds before the Key List is freed.                 */
+      SaveBonds();
+
+      /* Free the Key List while the BTPSKRNL memory is still available.*/
+      FreeDeviceInfoList(&DeviceInfoList);
+
+      Display(("Stack Shutdown.\r\n"));
+
+      /* Simply close the Stack                                         */
+      BSC_Shutdown(BluetoothStackID);
+
+      /* Free BTPSKRNL allocated memory.                                */
+      BTPS_DeInit();
+
+      /* Forget everything that refers to the closed stack (including   */
+      /* any pending work) so the stack can be opened again in place.   */
+      ServiceID          = 0;
+      GAPSInstanceID     = 0;
+      ConnectionID       = 0;
+      WorkQueueHead      = 0;
+      WorkQueueTail      = 0;
+      StackRestart       = TRUE;
+      ApplicationFailed  = FALSE;
+
+      /* Flag that the Stack is no longer initialized.                  */
+      BluetoothStackID = 0;
+
+      /* Flag success to the caller.                                    */
+      ret_val          = 0;
+   }
+   else
+   {
+      /* A valid Stack ID does not exist, inform to user.               */
+      ret_val = UNABLE_TO_INITIALIZE_STACK;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for placing the Local       */
+   /* Bluetooth Device into General Discoverablity Mode.  Once in this  */
+   /* mode the Device will respond to Inquiry Scans from other Bluetooth*/
+   /* Devices.  This function requires that a valid Bluetooth Stack ID  */
+   /* exists before running.  This function returns zero on successful  */
+   /* execution and a negative value if an error occurred.              */
+static int SetDisc(void)
+{
+   int ret_val = 0;
+
+   /* First, check that a valid Bluetooth Stack ID exists.              */
+   if(BluetoothStackID)
+   {
+      /* A semi-valid Bluetooth Stack ID exists, now attempt to set the */
+      /* attached Devices Discoverablity Mode to General.               */
+#ifndef LE_ONLY_BUILD
+      ret_val = GAP_Set_Discoverability_Mode(BluetoothStackID, dmGeneralDiscoverableMode, 0);
+#else
+      /* The BR/EDR Discoverability Mode is not used in an LE only build*/
+      ret_val = 0;
+#endif
+
+      /* Next, check the return value of the GAP Set Discoverability    */
+      /* Mode command for successful execution.                         */
+      if(!ret_val)
+      {
+         /* * NOTE * Discoverability is only applicable when we are     */
+         /*          advertising so save the default Discoverability    */
+         /*          Mode for later.                                    */
+         LE_Parameters.DiscoverabilityMode = dmGeneralDiscoverableMode;
+      }
+      else
+      {
+         /* An error occurred while trying to set the Discoverability   */
+         /* Mode of the Device.                                         */
+         DisplayFunctionError("Set Discoverable Mode", ret_val);
+      }
+   }
+   else
+   {
+      /* No valid Bluetooth Stack ID exists.                            */
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for placing the Local       */
+   /* Bluetooth Device into Connectable Mode.  Once in this mode the    */
+   /* Device will respond to Page Scans from other Bluetooth Devices.   */
+   /* This function requires that a valid Bluetooth Stack ID exists     */
+   /* before running.  This function returns zero on success and a      */
+   /* negative value if an error occurred.                              */
+static int SetConnect(void)
+{
+   int ret_val = 0;
+
+   /* First, check that a valid Bluetooth Stack ID exists.              */
+   if(BluetoothStackID)
+   {
+      /* Attempt to set the attached Device to be Connectable.          */
+#ifndef LE_ONLY_BUILD
+      ret_val = GAP_Set_Connectability_Mode(BluetoothStackID, cmConnectableMode);
+#else
+      /* The BR/EDR Connectability Mode is not used in an LE only build.*/
+      ret_val = 0;
+#endif
+
+      /* Next, check the return value of the                            */
+      /* GAP_Set_Connectability_Mode() function for successful          */
+      /* execution.                                                     */
+      if(!ret_val)
+      {
+         /* * NOTE * Connectability is only an applicable when          */
+         /*          advertising so we will just save the default       */
+         /*          connectability for the next time we enable         */
+         /*          advertising.                                       */
+         LE_Parameters.ConnectableMode = lcmConnectable;
+      }
+      else
+      {
+         /* An error occurred while trying to make the Device           */
+         /* Connectable.                                                */
+         DisplayFunctionError("Set Connectability Mode", ret_val);
+      }
+   }
+   else
+   {
+      /* No valid Bluetooth Stack ID exists.                            */
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for placing the local       */
+   /* Bluetooth device into Pairable mode.  Once in this mode the device*/
+   /* will response to pairing requests from other Bluetooth devices.   */
+   /* This function returns zero on successful execution and a negative */
+   /* value on all errors.                                              */
+static int SetPairable(void)
+{
+   int Result;
+   int ret_val = 0;
+
+   /* First, check that a valid Bluetooth Stack ID exists.              */
+   if(BluetoothStackID)
+   {
+      /* Attempt to set the attached device to be pairable.             */
+#ifndef LE_ONLY_BUILD
+      Result = GAP_Set_Pairability_Mode(BluetoothStackID, pmPairableMode);
+#else
+      /* The BR/EDR Pairability Mode is not used in an LE only build.   */
+      Result = 0;
+#endif
+
+      /* Next, check the return value of the GAP Set Pairability mode   */
+      /* command for successful execution.                              */
+      if(!Result)
+      {
+         /* The device has been set to pairable mode, now register an   */
+         /* Authentication Callback to handle the Authentication events */
+         /* if required.                                                */
+#ifndef LE_ONLY_BUILD
+         Result = GAP_Register_Remote_Authentication(BluetoothStackID, GAP_Event_Callback, (unsigned long)0);
+#else
+         Result = 0;
+#endif
+
+         /* Next, check the return value of the GAP Register Remote     */
+         /* Authentication command for successful execution.            */
+         if(!Result)
+         {
+            /* Now Set the LE Pairability.                              */
+
+            /* Attempt to set the attached device to be pairable.       */
+            Result = GAP_LE_Set_Pairability_Mode(BluetoothStackID, lpmPairableMode);
+
+            /* Next, check the return value of the GAP Set Pairability  */
+            /* mode command for successful execution.                   */
+            if(!Result)
+            {
+               /* The device has been set to pairable mode, now register*/
+               /* an Authentication Callback to handle the              */
+               /* Authentication events if required.                    */
+               Result = GAP_LE_Register_Remote_Authentication(BluetoothStackID, GAP_LE_Event_Callback, (unsigned long)0);
+
+               /* Next, check the return value of the GAP Register      */
+               /* Remote Authentication command for successful          */
+               /* execution.                                            */
+               if(Result)
+               {
+                  /* An error occurred while trying to execute this     */
+                  /* function.                                          */
+                  DisplayFunctionError("GAP_LE_Register_Remote_Authentication", Result);
+
+                  ret_val = Result;
+               }
+            }
+            else
+            {
+               /* An error occurred while trying to make the device     */
+               /* pairable.                                             */
+               DisplayFunctionError("GAP_LE_Set_Pairability_Mode", Result);
+
+               ret_val = Result;
+            }
+         }
+         else
+         {
+            /* An error occurred while trying to execute this function. */
+            DisplayFunctionError("GAP_Register_Remote_Authentication", Result);
+
+            ret_val = Result;
+         }
+      }
+      else
+      {
+         /* An error occurred while trying to make the device pairable. */
+         DisplayFunctionError("GAP_Set_Pairability_Mode", Result);
+
+         ret_val = Result;
+      }
+   }
+   else
+   {
+      /* No valid Bluetooth Stack ID exists.                            */
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function provides a mechanism to configure a        */
+   /* Pairing Capabilities structure with the application's pairing     */
+   /* parameters.                                                       */
+static void ConfigureCapabilities(GAP_LE_Pairing_Capabilities_t *Capabilities)
+{
+   /* Make sure the Capabilities pointer is semi-valid.                 */
+   if(Capabilities)
+   {
+      /* Configure the Pairing Cabilities structure.                    */
+      Capabilities->Bonding_Type                    = lbtBonding;
+      Capabilities->IO_Capability                   = LE_Parameters.IOCapability;
+      Capabilities->MITM                            = LE_Parameters.MITMProtection;
+      Capabilities->OOB_Present                     = LE_Parameters.OOBDataPresent;
+
+      /* ** NOTE ** This application always requests that we use the    */
+      /*            maximum encryption because this feature is not a    */
+      /*            very good one, if we set less than the maximum we   */
+      /*            will internally in GAP generate a key of the        */
+      /*            maximum size (we have to do it this way) and then   */
+      /*            we will zero out how ever many of the MSBs          */
+      /*            necessary to get the maximum size.  Also as a slave */
+      /*            we will have to use Non-Volatile Memory (per device */
+      /*            we are paired to) to store the negotiated Key Size. */
+      /*            By requesting the maximum (and by not storing the   */
+      /*            negotiated key size if less than the maximum) we    */
+      /*            allow the slave to power cycle and regenerate the   */
+      /*            LTK for each device it is paired to WITHOUT storing */
+      /*            any information on the individual devices we are    */
+      /*            paired to.                                          */
+      Capabilities->Maximum_Encryption_Key_Size        = GAP_LE_MAXIMUM_ENCRYPTION_KEY_SIZE;
+
+      /* This application only demostrates using Long Term Key's (LTK)  */
+      /* for encryption of a LE Link, however we could request and send */
+      /* all possible keys here if we wanted to.                        */
+      Capabilities->Receiving_Keys.Encryption_Key     = FALSE;
+      Capabilities->Receiving_Keys.Identification_Key = FALSE;
+      Capabilities->Receiving_Keys.Signing_Key        = FALSE;
+
+      Capabilities->Sending_Keys.Encryption_Key       = TRUE;
+      Capabilities->Sending_Keys.Identification_Key   = FALSE;
+      Capabilities->Sending_Keys.Signing_Key          = FALSE;
+   }
+}
+
+   /* The following function provides a mechanism of sending a Slave    */
+   /* Pairing Response to a Master's Pairing Request.                   */
+static int SlavePairingRequestResponse(BD_ADDR_t BD_ADDR)
+{
+   int                                          ret_val;
+   BoardStr_t                                   BoardStr;
+   GAP_LE_Authentication_Response_Information_t AuthenticationResponseData;
+
+   /* Make sure a Bluetooth Stack is open.                              */
+   if(BluetoothStackID)
+   {
+      BD_ADDRToStr(BD_ADDR, BoardStr);
+      Display(("Sending Pairing Response to %s.\r\n", BoardStr));
+
+      /* We must be the slave if we have received a Pairing Request     */
+      /* thus we will respond with our capabilities.                    */
+      AuthenticationResponseData.GAP_LE_Authentication_Type = larPairingCapabilities;
+      AuthenticationResponseData.Authentication_Data_Length = GAP_LE_PAIRING_CAPABILITIES_SIZE;
+
+      /* Configure the Application Pairing Parameters.                  */
+      ConfigureCapabilities(&(AuthenticationResponseData.Authentication_Data.Pairing_Capabilities));
+
+      /* Attempt to pair to the remote device.                          */
+      ret_val = GAP_LE_Authentication_Response(BluetoothStackID, BD_ADDR, &AuthenticationResponseData);
+
+      Display(("GAP_LE_Authentication_Response returned %d.\r\n", ret_val));
+   }
+   else
+   {
+      Display(("Stack ID Invalid.\r\n"));
+
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is provided to allow a mechanism of        */
+   /* responding to a request for Encryption Information to send to a   */
+   /* remote device.                                                    */
+static int EncryptionInformationRequestResponse(BD_ADDR_t BD_ADDR, Byte_t KeySize, GAP_LE_Authentication_Response_Information_t *GAP_LE_Authentication_Response_Information)
+{
+   int    ret_val;
+   Word_t LocalDiv;
+
+   /* Make sure a Bluetooth Stack is open.                              */
+   if(BluetoothStackID)
+   {
+      /* Make sure the input parameters are semi-valid.                 */
+      if((!COMPARE_NULL_BD_ADDR(BD_ADDR)) && (GAP_LE_Authentication_Response_Information))
+      {
+         Display(("   Calling GAP_LE_Generate_Long_Term_Key.\r\n"));
+
+         /* Generate a new LTK, EDIV and Rand tuple.                    */
+         if(!(ret_val = DiversifyKeys()))
+            ret_val = GAP_LE_Generate_Long_Term_Key(BluetoothStackID, (Encryption_Key_t *)(&DHK), (Encryption_Key_t *)(&ER), &(GAP_LE_Authentication_Response_Information->Authentication_Data.Encryption_Information.LTK), &LocalDiv, &(GAP_LE_Authentication_Response_Information->Authentication_Data.Encryption_Information.EDIV), &(GAP_LE_Authentication_Response_Information->Authentication_Data.Encryption_Information.Rand));
+         if(!ret_val)
+         {
+            Display(("   Encryption Information Request Response.\r\n"));
+
+            /* Response to the request with the LTK, EDIV and Rand      */
+            /* values.                                                  */
+            GAP_LE_Authentication_Response_Information->GAP_LE_Authentication_Type                                     = larEncryptionInformation;
+            GAP_LE_Authentication_Response_Information->Authentication_Data_Length                                     = GAP_LE_ENCRYPTION_INFORMATION_DATA_SIZE;
+            GAP_LE_Authentication_Response_Information->Authentication_Data.Encryption_Information.Encryption_Key_Size = KeySize;
+
+            ret_val = GAP_LE_Authentication_Response(BluetoothStackID, BD_ADDR, GAP_LE_Authentication_Response_Information);
+            if(!ret_val)
+            {
+               Display(("   GAP_LE_Authentication_Response (larEncryptionInformation) success.\r\n", ret_val));
+            }
+            else
+            {
+               Display(("   Error - SM_Generate_Long_Term_Key returned %d.\r\n", ret_val));
+            }
+         }
+         else
+         {
+            Display(("   Error - SM_Generate_Long_Term_Key returned %d.\r\n", ret_val));
+         }
+      }
+      else
+      {
+         Display(("Invalid Parameters.\r\n"));
+
+         ret_val = INVALID_PARAMETERS_ERROR;
+      }
+   }
+   else
+   {
+      Display(("Stack ID Invalid.\r\n"));
+
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is provided to allow a mechanism of        */
+   /* responding to a request for the Long Term Key of a remote device  */
+   /* that wants to start encryption.  The LTK is regenerated from the  */
+   /* specified EDIV and Rand values.                                   */
+static int LongTermKeyRequestResponse(BD_ADDR_t BD_ADDR, Word_t EDIV, Random_Number_t Rand)
+{
+   int                                           ret_val;
+   Long_Term_Key_t                               GeneratedLTK;
+   GAP_LE_Authentication_Response_Information_t  GAP_LE_Authentication_Response_Information;
+
+   /* Make sure a Bluetooth Stack is open.                              */
+   if(BluetoothStackID)
+   {
+      /* Regenerate the LTK for this connection and send it to the chip.*/
+      if(!(ret_val = DiversifyKeys()))
+         ret_val = GAP_LE_Regenerate_Long_Term_Key(BluetoothStackID, (Encryption_Key_t *)(&DHK), (Encryption_Key_t *)(&ER), EDIV, &Rand, &GeneratedLTK);
+      if(!ret_val)
+      {
+         Display(("GAP_LE_Regenerate_Long_Term_Key Success.\r\n"));
+
+         /* Respond with the Re-Generated Long Term Key.                */
+         GAP_LE_Authentication_Response_Information.GAP_LE_Authentication_Type                                        = larLongTermKey;
+         GAP_LE_Authentication_Response_Information.Authentication_Data_Length                                        = GAP_LE_LONG_TERM_KEY_INFORMATION_DATA_SIZE;
+         GAP_LE_Authentication_Response_Information.Authentication_Data.Long_Term_Key_Information.Encryption_Key_Size = GAP_LE_MAXIMUM_ENCRYPTION_KEY_SIZE;
+         GAP_LE_Authentication_Response_Information.Authentication_Data.Long_Term_Key_Information.Long_Term_Key       = GeneratedLTK;
+      }
+      else
+      {
+         Display(("GAP_LE_Regenerate_Long_Term_Key returned %d.\r\n", ret_val));
+
+         /* Since we failed to generate the requested key we should     */
+         /* respond with a negative response.                           */
+         GAP_LE_Authentication_Response_Information.GAP_LE_Authentication_Type = larLongTermKey;
+         GAP_LE_Authentication_Response_Information.Authentication_Data_Length = 0;
+      }
+
+      /* Send the Authentication Response.                              */
+      ret_val = GAP_LE_Authentication_Response(BluetoothStackID, BD_ADDR, &GAP_LE_Authentication_Response_Information);
+      if(ret_val)
+      {
+         Display(("GAP_LE_Authentication_Response returned %d.\r\n", ret_val));
+      }
+   }
+   else
+   {
+      Display(("Stack ID Invalid.\r\n"));
+
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for generating the DHK and  */
+   /* IRK from the constant Identity Root Key.  The keys are only       */
+   /* generated the first time they are needed (instead of when the     */
+   /* stack is opened) and are then retained, since they never change.  */
+   /* This function returns zero on successful execution and a negative */
+   /* value on all errors.                                              */
+static int DiversifyKeys(void)
+{
+   int ret_val = 0;
+
+   if(!KeysDiversified)
+   {
+      if(!(ret_val = GAP_LE_Diversify_Function(BluetoothStackID, (Encryption_Key_t *)(&IR), 1, 0, &IRK)))
+      {
+         if(!(ret_val = GAP_LE_Diversify_Function(BluetoothStackID, (Encryption_Key_t *)(&IR), 3, 0, &DHK)))
+            KeysDiversified = TRUE;
+      }
+
+      if(ret_val)
+         DisplayFunctionError("GAP_LE_Diversify_Function", ret_val);
+   }
+
+   return(ret_val);
+}
+
+#ifndef LE_ONLY_BUILD
+
+   /* The following function is a utility function that exists to delete*/
+   /* the specified Link Key from the Local Bluetooth Device.  If a NULL*/
+   /* Bluetooth Device Address is specified, then all Link Keys will be */
+   /* deleted.                                                          */
+static int DeleteLinkKey(BD_ADDR_t BD_ADDR)
+{
+   int           Result;
+   Byte_t        Status_Result;
+   Word_t        Num_Keys_Deleted = 0;
+   BD_ADDR_t     NULL_BD_ADDR;
+   Bond_Entry_t *BondEntry;
+
+   Result = HCI_Delete_Stored_Link_Key(BluetoothStackID, BD_ADDR, TRUE, &Status_Result, &Num_Keys_Deleted);
+
+   /* Any stored link keys for the specified address (or all) have been */
+   /* deleted from the chip.  Now, let's make sure that our Bond Table  */
+   /* is in sync with these changes.                                    */
+
+   /* First check to see all Link Keys were deleted.                    */
+   ASSIGN_BD_ADDR(NULL_BD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+
+   if(COMPARE_BD_ADDR(BD_ADDR, NULL_BD_ADDR))
+      BondTable_Initialize();
+   else
+   {
+      /* Individual Link Key.  Go ahead and see if know about the entry */
+      /* in the table.                                                  */
+      if((BondEntry = BondTable_Search(BD_ADDR)) != NULL)
+      {
+         BondEntry->Flags &= ~BOND_ENTRY_FLAGS_LINK_KEY_VALID;
+
+         /* Free the entry if the device is not bonded over LE either.  */
+         if(!BondEntry->Flags)
+            BondTable_Delete(BD_ADDR);
+      }
+   }
+
+   return(Result);
+}
+
+#endif
+
+   /* The following function is responsible for forgetting a device that*/
+   /* has been evicted from the Bond Table.  The LE bond of the device  */
+   /* (if any) is removed from the White List and from its Device Info  */
+   /* entry, the entry itself is freed unless the device is currently   */
+   /* connected.                                                        */
+static void ForgetBond(Bond_Entry_t *BondEntry)
+{
+   BoardStr_t    BoardStr;
+   DeviceInfo_t *DeviceInfo;
+
+   BD_ADDRToStr(BondEntry->BD_ADDR, BoardStr);
+   Display(("Bond Table full, forgetting %s.\r\n", BoardStr));
+
+   if(BondEntry->Flags & BOND_ENTRY_FLAGS_LE_BONDED)
+   {
+      RemoveDeviceFromWhiteList(BondEntry->AddressType, BondEntry->BD_ADDR);
+
+      if(COMPARE_BD_ADDR(BondEntry->BD_ADDR, ConnectionBD_ADDR))
+      {
+         if((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, BondEntry->BD_ADDR)) != NULL)
+            DeviceInfo->Flags &= ~DEVICE_INFO_FLAGS_LTK_VALID;
+      }
+      else
+      {
+         if((DeviceInfo = DeleteDeviceInfoEntry(&DeviceInfoList, BondEntry->BD_ADDR)) != NULL)
+            FreeDeviceInfoEntryMemory(DeviceInfo);
+      }
+   }
+}
+
+#ifndef LE_ONLY_BUILD
+
+   /* The following function is responsible for issuing a GAP           */
+   /* Authentication Response with a PIN Code value specified via the   */
+   /* input parameter.  This function returns zero on successful        */
+   /* execution and a negative value on all errors.                     */
+static int PINCodeResponse(ParameterList_t *TempParam)
+{
+   int                              Result;
+   int                              ret_val;
+   PIN_Code_t                       PINCode;
+   GAP_Authentication_Information_t GAP_Authentication_Information;
+
+   /* First, check that valid Bluetooth Stack ID exists.                */
+   if(BluetoothStackID)
+   {
+      /* First, check to see if there is an on-going Pairing operation  */
+      /* active.                                                        */
+      if(!COMPARE_NULL_BD_ADDR(CurrentCBRemoteBD_ADDR))
+      {
+         /* Make sure that all of the parameters required for this      */
+         /* function appear to be at least semi-valid.                  */
+         if((TempParam) && (TempParam->NumberofParameters > 0) && (TempParam->Params[0].strParam) && (BTPS_StringLength(TempParam->Params[0].strParam) > 0) && (BTPS_StringLength(TempParam->Params[0].strParam) <= sizeof(PIN_Code_t)))
+         {
+            /* Parameters appear to be valid, go ahead and convert the  */
+            /* input parameter into a PIN Code.                         */
+
+            /* Initialize the PIN code.                                 */
+            ASSIGN_PIN_CODE(PINCode, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+            BTPS_MemCopy(&PINCode, TempParam->Params[0].strParam, BTPS_StringLength(TempParam->Params[0].strParam));
+
+            /* Populate the response structure.                         */
+            GAP_Authentication_Information.GAP_Authentication_Type      = atPINCode;
+            GAP_Authentication_Information.Authentication_Data_Length   = (Byte_t)(BTPS_StringLength(TempParam->Params[0].strParam));
+            GAP_Authentication_Information.Authentication_Data.PIN_Code = PINCode;
+
+            /* Submit the Authentication Response.                      */
+            Result = GAP_Authentication_Response(BluetoothStackID, CurrentCBRemoteBD_ADDR, &GAP_Authentication_Information);
+
+            /* Check the return value for the submitted command for     */
+            /* success.                                                 */
+            if(!Result)
+            {
+               /* Operation was successful, inform the user.            */
+               Display(("GAP_Authentication_Response(), Pin Code Response Success.\r\n"));
+
+               /* Flag success to the caller.                           */
+               ret_val = 0;
+            }
+            else
+            {
+               /* Inform the user that the Authentication Response was  */
+               /* not successful.                                       */
+               Display(("GAP_Authentication_Response() Failure: %d.\r\n", Result));
+
+               ret_val = FUNCTION_ERROR;
+            }
+
+            /* Flag that there is no longer a current Authentication    */
+            /* procedure in progress.                                   */
+            ASSIGN_BD_ADDR(CurrentCBRemoteBD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+         }
+         else
+            ret_val = INVALID_PARAMETERS_ERROR;
+      }
+      else
+      {
+         /* There is not currently an on-going authentication operation,*/
+         /* inform the user of this error condition.                    */
+         Display(("PIN Code Authentication Response: Authentication not in progress.\r\n"));
+
+         ret_val = FUNCTION_ERROR;
+      }
+   }
+   else
+   {
+      /* No valid Bluetooth Stack ID exists.                            */
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+#endif
+
+   /* The following function is responsible for adding a bonded device  */
+   /* to the controller's White List.  Once the White List holds at     */
+   /* least one device (and White List Mode is enabled) advertising only*/
+   /* answers Scan and Connect Requests from the devices in the White   */
+   /* List.  This function returns zero on successful execution and a   */
+   /* negative value on all errors.                                     */
+   /* * NOTE * The White List may not be modified while advertising with*/
+   /*          a White List filter, this function is therefore only     */
+   /*          called while connected (i.e.  when a device has just     */
+   /*          bonded).                                                 */
+static int AddDeviceToWhiteList(GAP_LE_Address_Type_t AddressType, BD_ADDR_t BD_ADDR)
+{
+   int                       ret_val;
+   unsigned int              DevicesAdded;
+   GAP_LE_White_List_Entry_t WhiteListEntry;
+
+   /* First, check that valid Bluetooth Stack ID exists.                */
+   if(BluetoothStackID)
+   {
+      /* Make sure that there is room left in the White List.           */
+      if(WhiteListCount < WhiteListSize)
+      {
+         WhiteListEntry.Address_Type = AddressType;
+         WhiteListEntry.Address      = BD_ADDR;
+
+         ret_val = GAP_LE_Add_Device_To_White_List(BluetoothStackID, 1, &WhiteListEntry, &DevicesAdded);
+         if(!ret_val)
+            WhiteListCount += DevicesAdded;
+         else
+         {
+            Display(("GAP_LE_Add_Device_To_White_List returned %d.\r\n", ret_val));
+
+            ret_val = FUNCTION_ERROR;
+         }
+      }
+      else
+      {
+         Display(("White List full.\r\n"));
+
+         ret_val = FUNCTION_ERROR;
+      }
+   }
+   else
+   {
+      /* No valid Bluetooth Stack ID exists.                            */
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for removing a device (whose*/
+   /* bond is being deleted) from the controller's White List.  This    */
+   /* function returns zero on successful execution and a negative value*/
+   /* on all errors.                                                    */
+static int RemoveDeviceFromWhiteList(GAP_LE_Address_Type_t AddressType, BD_ADDR_t BD_ADDR)
+{
+   int                       ret_val;
+   unsigned int              DevicesRemoved;
+   GAP_LE_White_List_Entry_t WhiteListEntry;
+
+   /* First, check that valid Bluetooth Stack ID exists.                */
+   if(BluetoothStackID)
+   {
+      WhiteListEntry.Address_Type = AddressType;
+      WhiteListEntry.Address      = BD_ADDR;
+
+      ret_val = GAP_LE_Remove_Device_From_White_List(BluetoothStackID, 1, &WhiteListEntry, &DevicesRemoved);
+      if(!ret_val)
+         WhiteListCount -= (DevicesRemoved <= WhiteListCount)?DevicesRemoved:WhiteListCount;
+      else
+      {
+         Display(("GAP_LE_Remove_Device_From_White_List returned %d.\r\n", ret_val));
+
+         ret_val = FUNCTION_ERROR;
+      }
+   }
+   else
+   {
+      /* No valid Bluetooth Stack ID exists.                            */
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for building the LE         */
+   /* Advertising Data and writing it to the chip.  The Advertising Data*/
+   /* holds the Flags A/D Field and, in Broadcast Mode, a Manufacturer  */
+   /* Specific A/D Field that carries the current button state (see     */
+   /* MYLETyp.h for the format), so that passive scanners see every     */
+   /* button change without connecting.  This function may be called    */
+   /* while advertising is enabled to update the advertised button      */
+   /* state.  This function returns zero on successful execution and a  */
+   /* negative value on all errors.                                     */
+static int SetAdvertisingData(void)
+{
+   int                ret_val;
+   unsigned int       Length;
+   Advertising_Data_t AdvertisingData;
+
+   /* First, check that valid Bluetooth Stack ID exists.                */
+   if(BluetoothStackID)
+   {
+      BTPS_MemInitialize(&AdvertisingData, 0, sizeof(Advertising_Data_t));
+
+      /* Set the Flags A/D Field (1 byte type and 1 byte Flags.         */
+      AdvertisingData.Advertising_Data[0] = 2;
+      AdvertisingData.Advertising_Data[1] = HCI_LE_ADVERTISING_REPORT_DATA_TYPE_FLAGS;
+      AdvertisingData.Advertising_Data[2] = 0;
+
+      /* Configure the flags field based on the Discoverability Mode.   */
+      if(LE_Parameters.DiscoverabilityMode == dmGeneralDiscoverableMode)
+         AdvertisingData.Advertising_Data[2] = HCI_LE_ADVERTISING_FLAGS_GENERAL_DISCOVERABLE_MODE_FLAGS_BIT_MASK;
+      else
+      {
+         if(LE_Parameters.DiscoverabilityMode == dmLimitedDiscoverableMode)
+            AdvertisingData.Advertising_Data[2] = HCI_LE_ADVERTISING_FLAGS_LIMITED_DISCOVERABLE_MODE_FLAGS_BIT_MASK;
+      }
+
+      Length = AdvertisingData.Advertising_Data[0] + 1;
+
+      /* Append the Manufacturer Specific A/D Field (1 byte type,       */
+      /* Company Identifier, Sequence Number and button state).         */
+      if(LE_Parameters.BroadcastMode)
+      {
+         AdvertisingData.Advertising_Data[Length]     = (Byte_t)(1 + MYLE_BROADCAST_DATA_LENGTH);
+         AdvertisingData.Advertising_Data[Length + 1] = HCI_LE_ADVERTISING_REPORT_DATA_TYPE_MANUFACTURER_SPECIFIC;
+
+         ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(AdvertisingData.Advertising_Data[Length + 2]), MYLE_BROADCAST_COMPANY_IDENTIFIER);
+         ASSIGN_HOST_BYTE_TO_LITTLE_ENDIAN_UNALIGNED_BYTE(&(AdvertisingData.Advertising_Data[Length + 2 + WORD_SIZE]), BroadcastSequence);
+         ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(AdvertisingData.Advertising_Data[Length + 2 + WORD_SIZE + BYTE_SIZE]), g_button_state);
+
+         Length += (2 + MYLE_BROADCAST_DATA_LENGTH);
+      }
+
+      /* Write thee advertising data to the chip.                       */
+      ret_val = GAP_LE_Set_Advertising_Data(BluetoothStackID, Length, &AdvertisingData);
+      if(ret_val)
+      {
+         Display(("GAP_LE_Set_Advertising_Data(dtAdvertising) returned %d.\r\n", ret_val));
+
+         ret_val = FUNCTION_ERROR;
+      }
+   }
+   else
+   {
+      /* No valid Bluetooth Stack ID exists.                            */
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for enabling LE             */
+   /* Advertisements.  This function returns zero on successful         */
+   /* execution and a negative value on all errors.                     */
+static int AdvertiseLE(ParameterList_t *TempParam)
+{
+   int                                 ret_val;
+   int                                 Length;
+   Boolean_t                           Filter;
+   GAP_LE_Advertising_Parameters_t     AdvertisingParameters;
+   GAP_LE_Connectability_Parameters_t  ConnectabilityParameters;
+   Scan_Response_Data_t                ScanResponseData;
+
+   /* First, check that valid Bluetooth Stack ID exists.                */
+   if(BluetoothStackID)
+   {
+      /* Enable Advertising.  Set the Advertising Data.                 */
+      ret_val = SetAdvertisingData();
+      if(!ret_val)
+      {
+         BTPS_MemInitialize(&ScanResponseData, 0, sizeof(Scan_Response_Data_t));
+
+         /* Set the Scan Response Data.                                 */
+         Length = BTPS_StringLength(LE_DEMO_DEVICE_NAME);
+         if(Length < (ADVERTISING_DATA_MAXIMUM_SIZE - 2))
+         {
+            ScanResponseData.Scan_Response_Data[1] = HCI_LE_ADVERTISING_REPORT_DATA_TYPE_LOCAL_NAME_COMPLETE;
+         }
+         else
+         {
+            ScanResponseData.Scan_Response_Data[1] = HCI_LE_ADVERTISING_REPORT_DATA_TYPE_LOCAL_NAME_SHORTENED;
+            Length = (ADVERTISING_DATA_MAXIMUM_SIZE - 2);
+         }
+
+         ScanResponseData.Scan_Response_Data[0] = (Byte_t)(1 + Length);
+         BTPS_MemCopy(&(ScanResponseData.Scan_Response_Data[2]),LE_DEMO_DEVICE_NAME,Length);
+
+         ret_val = GAP_LE_Set_Scan_Response_Data(BluetoothStackID, (ScanResponseData.Scan_Response_Data[0] + 1), &ScanResponseData);
+         if(!ret_val)
+         {
+            /* Set up the advertising parameters.                       */
+            /* * NOTE * In White List Mode, Scan Requests (and Connect  */
+            /*          Requests if WHITE_LIST_CONNECT_FILTER is set)   */
+            /*          are only answered for bonded devices once there */
+            /*          is at least one and the pairing window has      */
+            /*          closed, until then any device may connect (and  */
+            /*          bond).                                          */
+            /* * NOTE * The White List holds the address a device bonded*/
+            /*          with, a device that uses a Resolvable Private   */
+            /*          Address is not matched once its address changes */
+            /*          (which is why Connect Requests are not filtered */
+            /*          by default).                                    */
+            Filter = ((LE_Parameters.WhiteListMode) && (WhiteListCount) && (!PairingWindowOpen));
+
+            AdvertisingParameters.Advertising_Channel_Map   = HCI_LE_ADVERTISING_CHANNEL_MAP_DEFAULT;
+            AdvertisingParameters.Scan_Request_Filter       = (Filter)?fpWhiteList:fpNoFilter;
+            AdvertisingParameters.Connect_Request_Filter    = ((Filter) && (WHITE_LIST_CONNECT_FILTER))?fpWhiteList:fpNoFilter;
+            AdvertisingParameters.Advertising_Interval_Min  = Config_Get()->AdvertisingIntervalMin;
+            AdvertisingParameters.Advertising_Interval_Max  = Config_Get()->AdvertisingIntervalMax;
+
+            /* Configure the Connectability Parameters.                 */
+            /* * NOTE * Since we do not ever put ourselves to be direct */
+            /*          connectable then we will set the DirectAddress  */
+            /*          to all 0s.                                      */
+            ConnectabilityParameters.Connectability_Mode   = LE_Parameters.ConnectableMode;
+            ConnectabilityParameters.Own_Address_Type      = latPublic;
+            ConnectabilityParameters.Direct_Address_Type   = latPublic;
+            ASSIGN_BD_ADDR(ConnectabilityParameters.Direct_Address, 0, 0, 0, 0, 0, 0);
+
+            /* Now enable advertising.                                  */
+            ret_val = GAP_LE_Advertising_Enable(BluetoothStackID, TRUE, &AdvertisingParameters, &ConnectabilityParameters, GAP_LE_Event_Callback, 0);
+            if(!ret_val)
+            {
+               Display(("GAP_LE_Advertising_Enable success.\r\n"));
+            }
+            else
+            {
+               Display(("GAP_LE_Advertising_Enable returned %d.\r\n", ret_val));
+
+               ret_val = FUNCTION_ERROR;
+            }
+         }
+         else
+         {
+            Display(("GAP_LE_Set_Advertising_Data(dtScanResponse) returned %d.\r\n", ret_val));
+
+            ret_val = FUNCTION_ERROR;
+         }
+      }
+   }
+   else
+   {
+      /* No valid Bluetooth Stack ID exists.                            */
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for enabling high duty cycle*/
+   /* Directed LE Advertisements towards the specified device.  Directed*/
+   /* Advertisements carry no Advertising Data and are only accepted by */
+   /* the specified device, which allows it to reconnect within a few   */
+   /* milliseconds.  The controller stops Directed Advertising on its   */
+   /* own after 1.28 seconds, which is reported as an LE Connection     */
+   /* Complete event with the Directed Advertising Timeout status.  This*/
+   /* function returns zero on successful execution and a negative value*/
+   /* on all errors.                                                    */
+static int AdvertiseLEDirected(GAP_LE_Address_Type_t AddressType, BD_ADDR_t BD_ADDR)
+{
+   int                                 ret_val;
+   GAP_LE_Advertising_Parameters_t     AdvertisingParameters;
+   GAP_LE_Connectability_Parameters_t  ConnectabilityParameters;
+
+   /* First, check that valid Bluetooth Stack ID exists.                */
+   if(BluetoothStackID)
+   {
+      /* Set up the advertising parameters.                             */
+      /* * NOTE * The advertising interval is ignored by the controller */
+      /*          for high duty cycle Directed Advertising.             */
+      AdvertisingParameters.Advertising_Channel_Map   = HCI_LE_ADVERTISING_CHANNEL_MAP_DEFAULT;
+      AdvertisingParameters.Scan_Request_Filter       = fpNoFilter;
+      AdvertisingParameters.Connect_Request_Filter    = fpNoFilter;
+      AdvertisingParameters.Advertising_Interval_Min  = Config_Get()->AdvertisingIntervalMin;
+      AdvertisingParameters.Advertising_Interval_Max  = Config_Get()->AdvertisingIntervalMax;
+
+      /* Configure the Connectability Parameters to only accept a       */
+      /* connection from the specified device.                          */
+      ConnectabilityParameters.Connectability_Mode   = lcmDirectConnectable;
+      ConnectabilityParameters.Own_Address_Type      = latPublic;
+      ConnectabilityParameters.Direct_Address_Type   = AddressType;
+      ConnectabilityParameters.Direct_Address        = BD_ADDR;
+
+      /* Now enable advertising.                                        */
+      ret_val = GAP_LE_Advertising_Enable(BluetoothStackID, TRUE, &AdvertisingParameters, &ConnectabilityParameters, GAP_LE_Event_Callback, 0);
+      if(!ret_val)
+      {
+         Display(("GAP_LE_Advertising_Enable (directed) success.\r\n"));
+      }
+      else
+      {
+         Display(("GAP_LE_Advertising_Enable (directed) returned %d.\r\n", ret_val));
+
+         ret_val = FUNCTION_ERROR;
+      }
+   }
+   else
+   {
+      /* No valid Bluetooth Stack ID exists.                            */
+      ret_val = INVALID_STACK_ID_ERROR;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function is responsible for advertising for a       */
+   /* reconnection after a link has been lost.  If we are bonded with a */
+   /* device, Directed Advertising towards the most recently bonded     */
+   /* device is tried first (the LE Connection Complete event with the  */
+   /* Directed Advertising Timeout status then falls back to Undirected */
+   /* Advertising).  Otherwise, or if Directed Advertising could not be */
+   /* enabled, Undirected Advertising is enabled immediately.  This     */
+   /* function returns zero on successful execution and a negative value*/
+   /* on all errors.                                                    */
+static int ReconnectLE(void)
+{
+   int           ret_val;
+   DeviceInfo_t *DeviceInfo;
+
+   if(((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, LastBondedBD_ADDR)) == NULL) || (!(DeviceInfo->Flags & DEVICE_INFO_FLAGS_LTK_VALID)) || (AdvertiseLEDirected(DeviceInfo->ConnectionAddressType, DeviceInfo->ConnectionBD_ADDR)))
+      ret_val = AdvertiseLE(NULL);
+   else
+      ret_val = 0;
+
+   return(ret_val);
+}
+
+   /* The following function is the scheduler function that closes the  */
+   /* pairing window WHITE_LIST_PAIRING_WINDOW ms after start-up.  If we*/
+   /* are advertising, advertising is restarted so that the White List  */
+   /* filter takes effect right away.                                   */
+   /* * NOTE * This function stays in the scheduler (it is removed by   */
+   /*          ShutdownApplication()), it does nothing once the window  */
+   /*          has closed.                                              */
+static void PairingWindowFunction(void *UserParameter)
+{
+   if(PairingWindowOpen)
+   {
+      PairingWindowOpen = FALSE;
+
+      Display(("Pairing window closed.\r\n"));
+
+      if((BluetoothStackID) && (!ConnectionID) && (LE_Parameters.WhiteListMode) && (WhiteListCount))
+      {
+         GAP_LE_Advertising_Disable(BluetoothStackID);
+
+         if(AdvertiseLE(NULL))
+            ApplicationFailed = TRUE;
+      }
+   }
+}
+
+   /* The following function is responsible for executing a single      */
+   /* deferred work item.                                               */
+static void ProcessWork(Work_Item_t *WorkItem)
+{
+   GAP_LE_Authentication_Response_Information_t GAP_LE_Authentication_Response_Information;
+
+   switch(WorkItem->Type)
+   {
+      case wtReconnect:
+         /* Without advertising we cannot be reached anymore, flag the  */
+         /* failure so the stack is restarted.                          */
+         if(ReconnectLE())
+            ApplicationFailed = TRUE;
+
+         /* Report the latencies and the load measured during the       */
+         /* connection.                                                 */
+         Latency_Display();
+         Perf_Display();
+         MemoryUsage_Display();
+
+#if HCI_CAPTURE_RECORDS
+
+         /* Dump the HCI traffic that led up to the disconnection.      */
+         HCICapture_Dump();
+
+#endif
+         break;
+      case wtAdvertise:
+         if(AdvertiseLE(NULL))
+            ApplicationFailed = TRUE;
+         break;
+      case wtLongTermKeyRequest:
+         LongTermKeyRequestResponse(WorkItem->BD_ADDR, WorkItem->EDIV, WorkItem->Rand);
+         break;
+      case wtEncryptionInformationRequest:
+         EncryptionInformationRequestResponse(WorkItem->BD_ADDR, WorkItem->KeySize, &GAP_LE_Authentication_Response_Information);
+         break;
+      case wtBootReport:
+         DisplayLocalDevice();
+         BootTime_Display();
+         MemoryUsage_Display();
+         break;
+   }
+}
+
+   /* The following function is responsible for deferring the specified */
+   /* work item from a Bluetooth callback to the main loop, so that the */
+   /* callback returns immediately and other stack events are not held  */
+   /* up by blocking HCI commands or key generation.  The Work Queue is */
+   /* bounded, if it is full the work item is executed immediately      */
+   /* instead (so no work is ever lost).                                */
+static void ScheduleWork(Work_Item_t *WorkItem)
+{
+   if((WorkQueueHead - WorkQueueTail) < WORK_QUEUE_SIZE)
+   {
+      WorkQueue[WorkQueueHead & (WORK_QUEUE_SIZE - 1)] = *WorkItem;
+
+      WorkQueueHead++;
+   }
+   else
+   {
+      WorkQueueOverflows++;
+
+      Display(("Work Queue full (%u), executing inline.\r\n", WorkQueueOverflows));
+
+      ProcessWork(WorkItem);
+   }
+}
+
+   /* The following function is the scheduler function that executes the*/
+   /* deferred work items on the main loop.  Only the work items that   */
+   /* are pending when this function is called are executed, work that  */
+   /* is scheduled meanwhile is executed on the next call.              */
+static void WorkQueueFunction(void *UserParameter)
+{
+   unsigned int Head;
+   Work_Item_t  WorkItem;
+
+   Head = WorkQueueHead;
+
+   while(WorkQueueTail != Head)
+   {
+      /* Copy the work item out of the queue before executing it, so    */
+      /* its slot may be reused by the work it schedules.               */
+      WorkItem = WorkQueue[WorkQueueTail & (WORK_QUEUE_SIZE - 1)];
+
+      WorkQueueTail++;
+
+      ProcessWork(&WorkItem);
+   }
+}
+
+/*********************************************************************/
+/**                           Service Table                         **/
+/*********************************************************************/
+
+/* The SPPLE Service Declaration UUID.                               */
+static BTPSCONST GATT_Primary_Service_128_Entry_t MYLE_Service_UUID =
+{
+	MYLE_SERVICE_UUID_CONSTANT
+};
+
+/* The Tx Characteristic Declaration.                                */
+static BTPSCONST GATT_Characteristic_Declaration_128_Entry_t MYLE_Button_Declaration =
+{
+	(GATT_CHARACTERISTIC_PROPERTIES_READ | GATT_CHARACTERISTIC_PROPERTIES_NOTIFY),
+	MYLE_BUTTON_CHARACTERISTIC_UUID_CONSTANT
+};
+
+/* The Tx Characteristic Value.                                      */
+static BTPSCONST GATT_Characteristic_Value_128_Entry_t  MYLE_Button_Value =
+{
+	MYLE_BUTTON_CHARACTERISTIC_UUID_CONSTANT,
+	0,
+	NULL
+};
+
+/* The Button Client Characteristic Configuration Descriptor.        */
+static BTPSCONST GATT_Characteristic_Descriptor_16_Entry_t MYLE_Button_Client_Characteristic_Configuration =
+{
+	GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_BLUETOOTH_UUID_CONSTANT,
+	GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_DESCRIPTOR_LENGTH,
+	NULL
+};
+
+/* The History Characteristic Declaration.                           */
+static BTPSCONST GATT_Characteristic_Declaration_128_Entry_t MYLE_History_Declaration =
+{
+	(GATT_CHARACTERISTIC_PROPERTIES_READ | GATT_CHARACTERISTIC_PROPERTIES_WRITE | GATT_CHARACTERISTIC_PROPERTIES_WRITE_WITHOUT_RESPONSE | GATT_CHARACTERISTIC_PROPERTIES_NOTIFY),
+	MYLE_HISTORY_CHARACTERISTIC_UUID_CONSTANT
+};
+
+/* The History Characteristic Value.                                 */
+static BTPSCONST GATT_Characteristic_Value_128_Entry_t  MYLE_History_Value =
+{
+	MYLE_HISTORY_CHARACTERISTIC_UUID_CONSTANT,
+	0,
+	NULL
+};
+
+/* The History Client Characteristic Configuration Descriptor.        */
+static BTPSCONST GATT_Characteristic_Descriptor_16_Entry_t MYLE_History_Client_Characteristic_Configuration =
+{
+	GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_BLUETOOTH_UUID_CONSTANT,
+	GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_DESCRIPTOR_LENGTH,
+	NULL
+};
+
+/* The Configuration Characteristic Declaration.                     */
+static BTPSCONST GATT_Characteristic_Declaration_128_Entry_t MYLE_Configuration_Declaration =
+{
+	(GATT_CHARACTERISTIC_PROPERTIES_READ | GATT_CHARACTERISTIC_PROPERTIES_WRITE),
+	MYLE_CONFIGURATION_CHARACTERISTIC_UUID_CONSTANT
+};
+
+/* The Configuration Characteristic Value.                           */
+static BTPSCONST GATT_Characteristic_Value_128_Entry_t  MYLE_Configuration_Value =
+{
+	MYLE_CONFIGURATION_CHARACTERISTIC_UUID_CONSTANT,
+	0,
+	NULL
+};
+
+/* The Telemetry Characteristic Declaration.                         */
+static BTPSCONST GATT_Characteristic_Declaration_128_Entry_t MYLE_Telemetry_Declaration =
+{
+	(GATT_CHARACTERISTIC_PROPERTIES_READ),
+	MYLE_TELEMETRY_CHARACTERISTIC_UUID_CONSTANT
+};
+
+/* The Telemetry Characteristic Value.                               */
+static BTPSCONST GATT_Characteristic_Value_128_Entry_t  MYLE_Telemetry_Value =
+{
+	MYLE_TELEMETRY_CHARACTERISTIC_UUID_CONSTANT,
+	0,
+	NULL
+};
+
+/* The Gesture Characteristic Declaration.                           */
+static BTPSCONST GATT_Characteristic_Declaration_128_Entry_t MYLE_Gesture_Declaration =
+{
+	(GATT_CHARACTERISTIC_PROPERTIES_READ | GATT_CHARACTERISTIC_PROPERTIES_NOTIFY),
+	MYLE_GESTURE_CHARACTERISTIC_UUID_CONSTANT
+};
+
+/* The Gesture Characteristic Value.                                 */
+static BTPSCONST GATT_Characteristic_Value_128_Entry_t  MYLE_Gesture_Value =
+{
+	MYLE_GESTURE_CHARACTERISTIC_UUID_CONSTANT,
+	0,
+	NULL
+};
+
+/* The Gesture Client Characteristic Configuration Descriptor.       */
+static BTPSCONST GATT_Characteristic_Descriptor_16_Entry_t MYLE_Gesture_Client_Characteristic_Configuration =
+{
+	GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_BLUETOOTH_UUID_CONSTANT,
+	GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_DESCRIPTOR_LENGTH,
+	NULL
+};
+
+/* The Inputs Characteristic Declaration.                            */
+static BTPSCONST GATT_Characteristic_Declaration_128_Entry_t MYLE_Inputs_Declaration =
+{
+	(GATT_CHARACTERISTIC_PROPERTIES_READ | GATT_CHARACTERISTIC_PROPERTIES_NOTIFY),
+	MYLE_INPUTS_CHARACTERISTIC_UUID_CONSTANT
+};
+
+/* The Inputs Characteristic Value.                                  */
+static BTPSCONST GATT_Characteristic_Value_128_Entry_t  MYLE_Inputs_Value =
+{
+	MYLE_INPUTS_CHARACTERISTIC_UUID_CONSTANT,
+	0,
+	NULL
+};
+
+/* The Inputs Client Characteristic Configuration Descriptor.        */
+static BTPSCONST GATT_Characteristic_Descriptor_16_Entry_t MYLE_Inputs_Client_Characteristic_Configuration =
+{
+	GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_BLUETOOTH_UUID_CONSTANT,
+	GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_DESCRIPTOR_LENGTH,
+	NULL
+};
+
+/* The Control Characteristic Declaration.                           */
+static BTPSCONST GATT_Characteristic_Declaration_128_Entry_t MYLE_Control_Declaration =
+{
+	(GATT_CHARACTERISTIC_PROPERTIES_WRITE | GATT_CHARACTERISTIC_PROPERTIES_WRITE_WITHOUT_RESPONSE),
+	MYLE_CONTROL_CHARACTERISTIC_UUID_CONSTANT
+};
+
+/* The Control Characteristic Value.                                 */
+static BTPSCONST GATT_Characteristic_Value_128_Entry_t  MYLE_Control_Value =
+{
+	MYLE_CONTROL_CHARACTERISTIC_UUID_CONSTANT,
+	0,
+	NULL
+};
+
+/* The following list describes every attribute of the MYLE service, */
+/* in the order in which they are registered with GATT.  Each entry  */
+/* is of the form:                                                   */
+/*                                                                   */
+/*    _x(Name, AttributeFlags, EntryType, Entry,                     */
+/*       HandlerFlags, Value, ValueLength, ReadFunction, WriteFunction)*/
+/*                                                                   */
+/* and is used to generate the MYLE_<Name>_ATTRIBUTE_OFFSET          */
+/* constants, the MYLE_Service[] table that is registered with GATT  */
+/* and the MYLE_Attribute_Handlers[] table that serves requests.     */
+/* * NOTE * To add a characteristic simply add its entries here, all */
+/*          offsets are derived automatically.                       */
+#define MYLE_SERVICE_ATTRIBUTES(_x)                                                                                                                                                                                                                                 \
+	_x(SERVICE_DECLARATION,                      GATT_ATTRIBUTE_FLAGS_READABLE,          aetPrimaryService128,            MYLE_Service_UUID,                                0,                                      NULL, 0, NULL,              NULL)               \
+	_x(BUTTON_CHARACTERISTIC_DECLARATION,        GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicDeclaration128, MYLE_Button_Declaration,                          0,                                      NULL, 0, NULL,              NULL)               \
+	_x(BUTTON_CHARACTERISTIC,                    GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicValue128,       MYLE_Button_Value,                                0,                                      NULL, 0, ReadButtonValue,   NULL)               \
+	_x(BUTTON_CHARACTERISTIC_CCD,                GATT_ATTRIBUTE_FLAGS_READABLE_WRITABLE, aetCharacteristicDescriptor16,   MYLE_Button_Client_Characteristic_Configuration,  0,                                      NULL, 0, ReadButtonCCCD,    WriteButtonCCCD)    \
+	_x(HISTORY_CHARACTERISTIC_DECLARATION,       GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicDeclaration128, MYLE_History_Declaration,                         0,                                      NULL, 0, NULL,              NULL)               \
+	_x(HISTORY_CHARACTERISTIC,                   GATT_ATTRIBUTE_FLAGS_READABLE_WRITABLE, aetCharacteristicValue128,       MYLE_History_Value,                               MYLE_ATTRIBUTE_HANDLER_FLAGS_LONG_READ, NULL, 0, ReadButtonHistory, WriteJournalAck)    \
+	_x(HISTORY_CHARACTERISTIC_CCD,               GATT_ATTRIBUTE_FLAGS_READABLE_WRITABLE, aetCharacteristicDescriptor16,   MYLE_History_Client_Characteristic_Configuration, 0,                                      NULL, 0, ReadHistoryCCCD,   WriteHistoryCCCD)   \
+	_x(CONFIGURATION_CHARACTERISTIC_DECLARATION, GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicDeclaration128, MYLE_Configuration_Declaration,                   0,                                      NULL, 0, NULL,              NULL)               \
+	_x(CONFIGURATION_CHARACTERISTIC,             GATT_ATTRIBUTE_FLAGS_READABLE_WRITABLE, aetCharacteristicValue128,       MYLE_Configuration_Value,                         0,                                      NULL, 0, ReadConfiguration, WriteConfiguration) \
+	_x(TELEMETRY_CHARACTERISTIC_DECLARATION,     GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicDeclaration128, MYLE_Telemetry_Declaration,                       0,                                      NULL, 0, NULL,              NULL)               \
+	_x(TELEMETRY_CHARACTERISTIC,                 GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicValue128,       MYLE_Telemetry_Value,                             0,                                      NULL, 0, ReadTelemetry,     NULL)               \
+	_x(GESTURE_CHARACTERISTIC_DECLARATION,       GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicDeclaration128, MYLE_Gesture_Declaration,                         0,                                      NULL, 0, NULL,              NULL)               \
+	_x(GESTURE_CHARACTERISTIC,                   GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicValue128,       MYLE_Gesture_Value,                               0,                                      NULL, 0, ReadGesture,       NULL)               \
+	_x(GESTURE_CHARACTERISTIC_CCD,               GATT_ATTRIBUTE_FLAGS_READABLE_WRITABLE, aetCharacteristicDescriptor16,   MYLE_Gesture_Client_Characteristic_Configuration, 0,                                      NULL, 0, ReadGestureCCCD,   WriteGestureCCCD)   \
+	_x(INPUTS_CHARACTERISTIC_DECLARATION,        GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicDeclaration128, MYLE_Inputs_Declaration,                          0,                                      NULL, 0, NULL,              NULL)               \
+	_x(INPUTS_CHARACTERISTIC,                    GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicValue128,       MYLE_Inputs_Value,                                0,                                      NULL, 0, ReadInputs,        NULL)               \
+	_x(INPUTS_CHARACTERISTIC_CCD,                GATT_ATTRIBUTE_FLAGS_READABLE_WRITABLE, aetCharacteristicDescriptor16,   MYLE_Inputs_Client_Characteristic_Configuration,  0,                                      NULL, 0, ReadInputsCCCD,    WriteInputsCCCD)    \
+	_x(CONTROL_CHARACTERISTIC_DECLARATION,       GATT_ATTRIBUTE_FLAGS_READABLE,          aetCharacteristicDeclaration128, MYLE_Control_Declaration,                         0,                                      NULL, 0, NULL,              NULL)               \
+	_x(CONTROL_CHARACTERISTIC,                   GATT_ATTRIBUTE_FLAGS_WRITABLE,          aetCharacteristicValue128,       MYLE_Control_Value,                               0,                                      NULL, 0, NULL,              WriteControl)
+
+/* The following enumerates the offset of each attribute in the MYLE */
+/* service (MYLE_<Name>_ATTRIBUTE_OFFSET) followed by the total      */
+/* number of attributes (MYLE_SERVICE_ATTRIBUTE_COUNT).              */
+enum
+{
+	MYLE_SERVICE_ATTRIBUTES(MYLE_ATTRIBUTE_OFFSET)
+	MYLE_SERVICE_ATTRIBUTE_COUNT
+};
+
+/* The following defines the MYLE service that is registered with   */
+/* the GATT_Register_Service function call.                          */
+/* * NOTE * This array will be registered with GATT in the call to   */
+/*          GATT_Register_Service.                                   */
+BTPSCONST GATT_Service_Attribute_Entry_t MYLE_Service[] =
+{
+	MYLE_SERVICE_ATTRIBUTES(MYLE_ATTRIBUTE_ENTRY)
+};
+
+/* Verify the layout of the service at compile time.                 */
+MYLE_STATIC_ASSERT((sizeof(MYLE_Service)/sizeof(GATT_Service_Attribute_Entry_t)) == MYLE_SERVICE_ATTRIBUTE_COUNT, MYLE_Service_Table_Size_Check);
+MYLE_STATIC_ASSERT(MYLE_SERVICE_DECLARATION_ATTRIBUTE_OFFSET == 0, MYLE_Service_Declaration_Check);
+MYLE_STATIC_ASSERT(MYLE_BUTTON_CHARACTERISTIC_ATTRIBUTE_OFFSET == (MYLE_BUTTON_CHARACTERISTIC_DECLARATION_ATTRIBUTE_OFFSET + 1), MYLE_Button_Characteristic_Check);
+MYLE_STATIC_ASSERT(MYLE_HISTORY_CHARACTERISTIC_ATTRIBUTE_OFFSET == (MYLE_HISTORY_CHARACTERISTIC_DECLARATION_ATTRIBUTE_OFFSET + 1), MYLE_History_Characteristic_Check);
+MYLE_STATIC_ASSERT(MYLE_CONFIGURATION_CHARACTERISTIC_ATTRIBUTE_OFFSET == (MYLE_CONFIGURATION_CHARACTERISTIC_DECLARATION_ATTRIBUTE_OFFSET + 1), MYLE_Configuration_Characteristic_Check);
+MYLE_STATIC_ASSERT(MYLE_TELEMETRY_CHARACTERISTIC_ATTRIBUTE_OFFSET == (MYLE_TELEMETRY_CHARACTERISTIC_DECLARATION_ATTRIBUTE_OFFSET + 1), MYLE_Telemetry_Characteristic_Check);
+MYLE_STATIC_ASSERT(MYLE_GESTURE_CHARACTERISTIC_ATTRIBUTE_OFFSET == (MYLE_GESTURE_CHARACTERISTIC_DECLARATION_ATTRIBUTE_OFFSET + 1), MYLE_Gesture_Characteristic_Check);
+MYLE_STATIC_ASSERT(MYLE_INPUTS_CHARACTERISTIC_ATTRIBUTE_OFFSET == (MYLE_INPUTS_CHARACTERISTIC_DECLARATION_ATTRIBUTE_OFFSET + 1), MYLE_Inputs_Characteristic_Check);
+MYLE_STATIC_ASSERT(MYLE_CONTROL_CHARACTERISTIC_ATTRIBUTE_OFFSET == (MYLE_CONTROL_CHARACTERISTIC_DECLARATION_ATTRIBUTE_OFFSET + 1), MYLE_Control_Characteristic_Check);
+
+/* Verify that a journal notification holding a single token fits in */
+/* the minimum ATT MTU (less the notification opcode and handle).    */
+MYLE_STATIC_ASSERT((MYLE_JOURNAL_HEADER_LENGTH + EVENT_CODEC_MAXIMUM_TOKEN_LENGTH) <= (ATT_PROTOCOL_MTU_MINIMUM_LE - 3), MYLE_Journal_Length_Check);
+
+/* Verify that an Inputs notification of the maximum number of inputs*/
+/* fits in the minimum ATT MTU.                                      */
+MYLE_STATIC_ASSERT(MYLE_INPUTS_VALUE_LENGTH(INPUT_MAXIMUM_INPUTS) <= (ATT_PROTOCOL_MTU_MINIMUM_LE - 3), MYLE_Inputs_Length_Check);
+
+/* Verify that every unacknowledged transition of the journal window */
+/* is still retained in the Event Log for a retransmission.          */
+MYLE_STATIC_ASSERT(MYLE_JOURNAL_WINDOW_SIZE < EVENT_LOG_SIZE, MYLE_Journal_Window_Check);
+
+/* This function will return zero on successful execution  */
+/* and a negative value on errors.                                   */
+static int RegisterService(ParameterList_t *TempParam)
+{
+	int                           ret_val;
+	GATT_Attribute_Handle_Group_t ServiceHandleGroup;
+
+	/* Verify that there is no active connection.                        */
+	if(!ConnectionID)
+	{
+		/* Verify that the Service is not already registered.             */
+		if(!ServiceID)
+		{
+			/* Initialize the handle group to 0 .                          */
+			ServiceHandleGroup.Starting_Handle = 0;
+			ServiceHandleGroup.Ending_Handle   = 0;
+
+			/* Register the SPPLE Service.                                 */
+			ret_val = GATT_Register_Service(BluetoothStackID,
+											GATT_SERVICE_FLAGS_LE_SERVICE,
+											MYLE_SERVICE_ATTRIBUTE_COUNT,
+											(GATT_Service_Attribute_Entry_t *)MYLE_Service,
+											&ServiceHandleGroup,
+											GATT_ServerEventCallback, 0);
+			if(ret_val > 0)
+			{
+				/* Display success message.                                 */
+				Display(("Sucessfully registered MYLE Service.\r\n"));
+
+				/* Save the ServiceID of the registered service.            */
+				ServiceID = (unsigned int)ret_val;
+
+				/* Return success to the caller.                            */
+				ret_val        = 0;
+			}
+		}
+		else
+		{
+			Display(("MYLE Service already registered.\r\n"));
+
+			ret_val = -1;
+		}
+	}
+	else
+	{
+		Display(("Connection current active.\r\n"));
+
+		ret_val = -1;
+	}
+
+	return(ret_val);
+}
+
+   /* The following type definition represents the function that is     */
+   /* called to serve a Read Request of a MYLE attribute.  The first    */
+   /* parameter is the Device Info entry of the client making the       */
+   /* request (or NULL if the client is unknown).  The second parameter */
+   /* is the offset into the value where the read starts (always zero   */
+   /* unless the attribute is flagged as supporting long reads).  The   */
+   /* third parameter holds the size of the buffer on input and receives*/
+   /* the number of bytes placed into the buffer on output.  The        */
+   /* function returns zero on success or an ATT Protocol Error Code on */
+   /* failure.                                                          */
+typedef Byte_t (*MYLE_Read_Function_t)(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer);
+
+   /* The following type definition represents the function that is     */
+   /* called to serve a Write Request of a MYLE attribute.  The first   */
+   /* parameter is the Device Info entry of the client making the       */
+   /* request (or NULL if the client is unknown).  The function returns */
+   /* zero on success or an ATT Protocol Error Code on failure.         */
+typedef Byte_t (*MYLE_Write_Function_t)(DeviceInfo_t *DeviceInfo, Word_t ValueLength, Byte_t *Value);
+
+   /* The following structure describes how requests for a single MYLE  */
+   /* attribute are served.  An attribute may either point to a constant*/
+   /* Value (which is served directly, including long reads) or provide */
+   /* Read and/or Write functions.  Attributes with neither are handled */
+   /* internally by GATT (declarations) or are rejected with the        */
+   /* appropriate error.                                                */
+typedef struct _tagMYLE_Attribute_Handler_t
+{
+   Byte_t                Flags;
+   Byte_t               *Value;
+   Word_t                ValueLength;
+   MYLE_Read_Function_t  ReadFunction;
+   MYLE_Write_Function_t WriteFunction;
+} MYLE_Attribute_Handler_t;
+
+   /* The following defines the bit mask flags that may be set in the   */
+   /* MYLE_Attribute_Handler_t structure.                               */
+#define MYLE_ATTRIBUTE_HANDLER_FLAGS_LONG_READ              0x01
+
+   /* Buffer used to build the value returned in a Read Response.  Reads*/
+   /* are served one at a time from the GATT Server callback so a single*/
+   /* buffer is shared by all attributes.                               */
+static Byte_t MYLEReadBuffer[SPPLE_DATA_BUFFER_LENGTH];
+
+   /* The following function serves a read of the MYLE Button           */
+   /* characteristic value.                                             */
+static Byte_t ReadButtonValue(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer)
+{
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(Buffer, g_button_state);
+
+   *ValueLength = MYLE_BUTTON_VALUE_LENGTH;
+
+   return(0);
+}
+
+   /* The following function is a utility function that serves a read of*/
+   /* a Client Characteristic Configuration Descriptor.  The first      */
+   /* parameter is the configuration that is stored for the requesting  */
+   /* client.                                                           */
+static Byte_t ReadClientConfiguration(Word_t Configuration, Word_t *ValueLength, Byte_t *Buffer)
+{
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(Buffer, Configuration);
+
+   *ValueLength = MYLE_CLIENT_CHARACTERISTIC_CONFIGURATION_VALUE_LENGTH;
+
+   return(0);
+}
+
+   /* The following function is a utility function that serves a write  */
+   /* of a Client Characteristic Configuration Descriptor.  The first   */
+   /* parameter is the name of the characteristic (for display purposes)*/
+   /* and the second points to the configuration that is stored for the */
+   /* requesting client (NULL if the client is unknown).                */
+static Byte_t WriteClientConfiguration(char *Name, Word_t *Configuration, Word_t ValueLength, Byte_t *Value)
+{
+   Byte_t ret_val;
+
+   if(ValueLength == MYLE_CLIENT_CHARACTERISTIC_CONFIGURATION_VALUE_LENGTH)
+   {
+      /* Store the configuration for this client, it is retained across */
+      /* connections if bonded.                                         */
+      if(Configuration)
+      {
+         *Configuration = READ_UNALIGNED_WORD_LITTLE_ENDIAN(Value);
+
+         Display(("%s notifications %s.\r\n", Name, (*Configuration & GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_NOTIFY_ENABLE)?"enabled":"disabled"));
+
+         ret_val = 0;
+      }
+      else
+         ret_val = ATT_PROTOCOL_ERROR_CODE_UNLIKELY_ERROR;
+   }
+   else
+      ret_val = ATT_PROTOCOL_ERROR_CODE_INVALID_ATTRIBUTE_VALUE_LENGTH;
+
+   return(ret_val);
+}
+
+   /* The following function serves a read of the MYLE Button Client    */
+   /* Characteristic Configuration Descriptor.                          */
+static Byte_t ReadButtonCCCD(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer)
+{
+   return(ReadClientConfiguration((Word_t)((DeviceInfo)?DeviceInfo->MYLEServerInfo.Button_Client_Configuration_Descriptor:0), ValueLength, Buffer));
+}
+
+   /* The following function serves a write of the MYLE Button Client   */
+   /* Characteristic Configuration Descriptor.                          */
+static Byte_t WriteButtonCCCD(DeviceInfo_t *DeviceInfo, Word_t ValueLength, Byte_t *Value)
+{
+   return(WriteClientConfiguration("Button", (DeviceInfo)?&(DeviceInfo->MYLEServerInfo.Button_Client_Configuration_Descriptor):NULL, ValueLength, Value));
+}
+
+   /* The following function serves a read of the MYLE Button History   */
+   /* Client Characteristic Configuration Descriptor.                   */
+static Byte_t ReadHistoryCCCD(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer)
+{
+   return(ReadClientConfiguration((Word_t)((DeviceInfo)?DeviceInfo->MYLEServerInfo.History_Client_Configuration_Descriptor:0), ValueLength, Buffer));
+}
+
+   /* The following function serves a write of the MYLE Button History  */
+   /* Client Characteristic Configuration Descriptor.  Enabling         */
+   /* notifications starts the delivery of the Offline Journal (see     */
+   /* DrainJournal()).                                                  */
+static Byte_t WriteHistoryCCCD(DeviceInfo_t *DeviceInfo, Word_t ValueLength, Byte_t *Value)
+{
+   return(WriteClientConfiguration("History", (DeviceInfo)?&(DeviceInfo->MYLEServerInfo.History_Client_Configuration_Descriptor):NULL, ValueLength, Value));
+}
+
+   /* The following function determines the first transition of a MYLE  */
+   /* Button History capture of the Event Log that ends before the      */
+   /* specified End sequence number.  The transitions are walked once,  */
+   /* from the newest, adding the length of each one encoded as a state */
+   /* token (see EventCodec_Transition_Length()) to a running total     */
+   /* until the next one would no longer fit in an attribute value.     */
+   /* This function returns the sequence number of the first transition */
+   /* of the capture (End if the capture is empty).                     */
+static DWord_t HistoryStart(DWord_t Oldest, DWord_t End)
+{
+   Word_t            Length;
+   DWord_t           ret_val;
+   DWord_t           Delta;
+   Boolean_t         Valid;
+   Event_Log_Entry_t Entry;
+   Event_Log_Entry_t Previous;
+
+   ret_val = End;
+   Length  = MYLE_HISTORY_HEADER_LENGTH;
+   Valid   = (Boolean_t)((ret_val > Oldest) && (EventLog_Get(ret_val - 1, &Entry)));
+
+   while(Valid)
+   {
+      Valid  = (Boolean_t)(((ret_val - 1) > Oldest) && (EventLog_Get(ret_val - 2, &Previous)));
+      Delta  = (Valid)?(Entry.TimeStamp - Previous.TimeStamp):0;
+
+      Length = (Word_t)(Length + EventCodec_Transition_Length(Delta, Entry.State));
+
+      if(Length > MYLE_HISTORY_MAXIMUM_LENGTH)
+         break;
+
+      ret_val--;
+
+      Entry = Previous;
+   }
+
+   return(ret_val);
+}
+
+   /* The following function serves a (possibly long) read of the MYLE  */
+   /* Button History characteristic value (see MYLETyp.h for the        */
+   /* format).  A read at offset zero captures the current contents of  */
+   /* the Event Log for the requesting client, reads at a non-zero      */
+   /* offset return the remainder of that capture.                      */
+   /* * NOTE * The value is encoded from the start of the capture for   */
+   /*          every read (the encoding is deterministic), only the part*/
+   /*          that overlaps the requested range is returned.           */
+static Byte_t ReadButtonHistory(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer)
+{
+   Byte_t            ret_val;
+   Byte_t            Field[MYLE_HISTORY_HEADER_LENGTH + EVENT_CODEC_MAXIMUM_TOKEN_LENGTH];
+   Word_t            Length;
+   Word_t            Position;
+   Word_t            FieldOffset;
+   Word_t            FieldLength;
+   DWord_t           Sequence;
+   DWord_t           End;
+   DWord_t           BaseTimeStamp;
+   Event_Codec_t     Codec;
+   Event_Log_Entry_t Entry;
+
+   /* A client must be known to hold a history capture.                 */
+   if(DeviceInfo)
+   {
+      /* A read at offset zero starts a new capture of the Event Log for*/
+      /* this client.  The oldest transitions are left out if the       */
+      /* encoded value would not fit in an attribute value.             */
+      if(!ValueOffset)
+      {
+         End      = EventLog_Next_Sequence();
+         Sequence = HistoryStart(EventLog_Oldest_Sequence(), End);
+
+         DeviceInfo->MYLEServerInfo.History_Read_Sequence  = Sequence;
+         DeviceInfo->MYLEServerInfo.History_Read_Count     = (Word_t)(End - Sequence);
+         DeviceInfo->MYLEServerInfo.History_Read_TimeStamp = BTPS_GetTickCount();
+      }
+
+      Sequence      = DeviceInfo->MYLEServerInfo.History_Read_Sequence;
+      End           = Sequence + DeviceInfo->MYLEServerInfo.History_Read_Count;
+      BaseTimeStamp = 0;
+      ret_val       = 0;
+
+      if(Sequence < End)
+      {
+         if(EventLog_Get(Sequence, &Entry))
+            BaseTimeStamp = Entry.TimeStamp;
+         else
+            ret_val = MYLE_ATT_ERROR_CODE_HISTORY_OVERWRITTEN;
+      }
+
+      ASSIGN_HOST_DWORD_TO_LITTLE_ENDIAN_UNALIGNED_DWORD(&(Field[0]), Sequence);
+      ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Field[DWORD_SIZE]), DeviceInfo->MYLEServerInfo.History_Read_Count);
+      ASSIGN_HOST_DWORD_TO_LITTLE_ENDIAN_UNALIGNED_DWORD(&(Field[DWORD_SIZE + WORD_SIZE]), DeviceInfo->MYLEServerInfo.History_Read_TimeStamp);
+      ASSIGN_HOST_DWORD_TO_LITTLE_ENDIAN_UNALIGNED_DWORD(&(Field[DWORD_SIZE + WORD_SIZE + DWORD_SIZE]), BaseTimeStamp);
+
+      EventCodec_Initialize(&Codec, Sequence, BaseTimeStamp);
+
+      /* Walk the fields (the header first, then one token at a time)   */
+      /* and copy the bytes that overlap the requested range into the   */
+      /* buffer.                                                        */
+      Length      = 0;
+      Position    = 0;
+      FieldLength = MYLE_HISTORY_HEADER_LENGTH;
+
+      while((!ret_val) && (FieldLength) && (Length < *ValueLength))
+      {
+         if((Position + FieldLength) > ValueOffset)
+         {
+            /* Skip the part of the first field that precedes the       */
+            /* requested offset.                                        */
+            FieldOffset  = (ValueOffset > Position)?(Word_t)(ValueOffset - Position):0;
+            FieldLength -= FieldOffset;
+
+            if(FieldLength > (*ValueLength - Length))
+               FieldLength = (Word_t)(*ValueLength - Length);
+
+            BTPS_MemCopy(&(Buffer[Length]), &(Field[FieldOffset]), FieldLength);
+
+            Length   += FieldLength;
+            Position  = (Word_t)(ValueOffset + Length);
+         }
+         else
+            Position += FieldLength;
+
+         /* Encode the next token (if any).                             */
+         if(Codec.Sequence < End)
+         {
+            if((FieldLength = EventCodec_Encode(&Codec, End, Field)) == 0)
+               ret_val = MYLE_ATT_ERROR_CODE_HISTORY_OVERWRITTEN;
+         }
+         else
+            FieldLength = 0;
+      }
+
+      /* An offset past the end of the value is invalid.                */
+      if((!ret_val) && (ValueOffset > Position))
+         ret_val = ATT_PROTOCOL_ERROR_CODE_INVALID_OFFSET;
+
+      *ValueLength = Length;
+   }
+   else
+      ret_val = ATT_PROTOCOL_ERROR_CODE_UNLIKELY_ERROR;
+
+   return(ret_val);
+}
+
+   /* The following function serves a write of an Offline Journal       */
+   /* acknowledgement to the MYLE Button History characteristic value   */
+   /* (see MYLETyp.h for the format).  The acknowledgement opens the    */
+   /* journal window and schedules the retransmission of the transitions*/
+   /* the client reports as missing, the journal is drained again right */
+   /* away.                                                             */
+static Byte_t WriteJournalAck(DeviceInfo_t *DeviceInfo, Word_t ValueLength, Byte_t *Value)
+{
+   Byte_t  ret_val;
+   Word_t  Missing;
+   DWord_t Ack;
+
+   if((ValueLength == MYLE_JOURNAL_ACK_LENGTH) || (ValueLength == MYLE_JOURNAL_ACK_MISSING_LENGTH))
+   {
+      Ack     = READ_UNALIGNED_DWORD_LITTLE_ENDIAN(Value);
+      Missing = (Word_t)((ValueLength == MYLE_JOURNAL_ACK_MISSING_LENGTH)?READ_UNALIGNED_WORD_LITTLE_ENDIAN(&(Value[DWORD_SIZE])):0);
+
+      /* A transition can only be acknowledged once it has been sent.   */
+      if(Ack <= JournalSequence)
+      {
+         /* The first acknowledgement of a connection sets the start of */
+         /* the window, later ones only move it forward.                */
+         if((!JournalReliable) || (Ack > JournalAckSequence))
+            JournalAckSequence = Ack;
+
+         JournalReliable = TRUE;
+         JournalAckTime  = BTPS_GetTickCount();
+
+         /* Skip the part of a retransmission that has been             */
+         /* acknowledged meanwhile.                                     */
+         if(RetransmitSequence < JournalAckSequence)
+            RetransmitSequence = JournalAckSequence;
+
+         if(Missing)
+         {
+            RetransmitSequence = Ack;
+            RetransmitEnd      = ((JournalSequence - Ack) > Missing)?(Ack + Missing):JournalSequence;
+         }
+
+         DrainJournal();
+
+         ret_val = 0;
+      }
+      else
+         ret_val = MYLE_ATT_ERROR_CODE_JOURNAL_ACK_INVALID;
+   }
+   else
+      ret_val = ATT_PROTOCOL_ERROR_CODE_INVALID_ATTRIBUTE_VALUE_LENGTH;
+
+   return(ret_val);
+}
+
+   /* The following function serves a read of the MYLE Configuration    */
+   /* characteristic value (see MYLETyp.h for the format).              */
+static Byte_t ReadConfiguration(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer)
+{
+   BTPSCONST Config_t *Config;
+
+   Config = Config_Get();
+
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[0 * WORD_SIZE]), Config->ButtonPollPeriod);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[1 * WORD_SIZE]), Config->AdvertisingIntervalMin);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[2 * WORD_SIZE]), Config->AdvertisingIntervalMax);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[3 * WORD_SIZE]), Config->HCILLTimeoutMin);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[4 * WORD_SIZE]), Config->HCILLTimeoutMax);
+   ASSIGN_HOST_BYTE_TO_LITTLE_ENDIAN_UNALIGNED_BYTE(&(Buffer[5 * WORD_SIZE]), Config->ButtonMask);
+   ASSIGN_HOST_BYTE_TO_LITTLE_ENDIAN_UNALIGNED_BYTE(&(Buffer[(5 * WORD_SIZE) + BYTE_SIZE]), Config->JournalBatchSize);
+
+   *ValueLength = MYLE_CONFIGURATION_VALUE_LENGTH;
+
+   return(0);
+}
+
+   /* The following function serves a write of the MYLE Configuration   */
+   /* characteristic value (see MYLETyp.h for the format).  Only bonded */
+   /* clients may change the configuration, and only over an encrypted  */
+   /* link (a bonded address alone may be spoofed).  A valid            */
+   /* configuration is applied immediately (the button poll period and  */
+   /* pin mask on the next button poll, the HCILL timeout bounds at the */
+   /* end of the current HCILL policy window and the remaining          */
+   /* parameters the next time they are used) and is written to flash   */
+   /* once the controller is idle.                                      */
+static Byte_t WriteConfiguration(DeviceInfo_t *DeviceInfo, Word_t ValueLength, Byte_t *Value)
+{
+   Byte_t   ret_val;
+   Config_t Config;
+
+   if((DeviceInfo) && (DeviceInfo->Flags & DEVICE_INFO_FLAGS_LTK_VALID) && (ConnectionEncrypted))
+   {
+      if(ValueLength == MYLE_CONFIGURATION_VALUE_LENGTH)
+      {
+         Config.ButtonPollPeriod       = READ_UNALIGNED_WORD_LITTLE_ENDIAN(&(Value[0 * WORD_SIZE]));
+         Config.AdvertisingIntervalMin = READ_UNALIGNED_WORD_LITTLE_ENDIAN(&(Value[1 * WORD_SIZE]));
+         Config.AdvertisingIntervalMax = READ_UNALIGNED_WORD_LITTLE_ENDIAN(&(Value[2 * WORD_SIZE]));
+         Config.HCILLTimeoutMin        = READ_UNALIGNED_WORD_LITTLE_ENDIAN(&(Value[3 * WORD_SIZE]));
+         Config.HCILLTimeoutMax        = READ_UNALIGNED_WORD_LITTLE_ENDIAN(&(Value[4 * WORD_SIZE]));
+         Config.ButtonMask             = READ_UNALIGNED_BYTE_LITTLE_ENDIAN(&(Value[5 * WORD_SIZE]));
+         Config.JournalBatchSize       = READ_UNALIGNED_BYTE_LITTLE_ENDIAN(&(Value[(5 * WORD_SIZE) + BYTE_SIZE]));
+
+         if(Config_Set(&Config))
+         {
+            Display(("Configuration updated.\r\n"));
+
+            ret_val = 0;
+         }
+         else
+            ret_val = MYLE_ATT_ERROR_CODE_CONFIGURATION_INVALID;
+      }
+      else
+         ret_val = ATT_PROTOCOL_ERROR_CODE_INVALID_ATTRIBUTE_VALUE_LENGTH;
+   }
+   else
+      ret_val = ATT_PROTOCOL_ERROR_CODE_INSUFFICIENT_AUTHENTICATION;
+
+   return(ret_val);
+}
+
+   /* The following function serves a read of the MYLE Telemetry        */
+   /* characteristic value (see MYLETyp.h for the format).              */
+static Byte_t ReadTelemetry(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer)
+{
+   MemoryUsage_t MemoryUsage;
+
+   MemoryUsage_Query(&MemoryUsage);
+
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[0 * WORD_SIZE]), MemoryUsage.StackSize);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[1 * WORD_SIZE]), MemoryUsage.StackUsed);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[2 * WORD_SIZE]), MemoryUsage.StackPeak);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[3 * WORD_SIZE]), MemoryUsage.HeapSize);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[4 * WORD_SIZE]), MemoryUsage.HeapUsed);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[5 * WORD_SIZE]), MemoryUsage.HeapPeak);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[6 * WORD_SIZE]), MemoryUsage.HeapLargestFree);
+
+   *ValueLength = MYLE_TELEMETRY_VALUE_LENGTH;
+
+   return(0);
+}
+
+   /* The following function is a utility function that formats the     */
+   /* specified gesture as a MYLE Gesture characteristic value (see     */
+   /* MYLETyp.h for the format).                                        */
+static void FormatGesture(BTPSCONST Gesture_Event_t *Event, Byte_t *Buffer)
+{
+   ASSIGN_HOST_BYTE_TO_LITTLE_ENDIAN_UNALIGNED_BYTE(&(Buffer[0]), Event->Button);
+   ASSIGN_HOST_BYTE_TO_LITTLE_ENDIAN_UNALIGNED_BYTE(&(Buffer[BYTE_SIZE]), Event->Gesture);
+   ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[BYTE_SIZE + BYTE_SIZE]), Event->Duration);
+   ASSIGN_HOST_DWORD_TO_LITTLE_ENDIAN_UNALIGNED_DWORD(&(Buffer[BYTE_SIZE + BYTE_SIZE + WORD_SIZE]), Event->TimeStamp);
+}
+
+   /* The following function serves a read of the MYLE Gesture          */
+   /* characteristic value.                                             */
+static Byte_t ReadGesture(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer)
+{
+   FormatGesture(&LastGesture, Buffer);
+
+   *ValueLength = MYLE_GESTURE_VALUE_LENGTH;
+
+   return(0);
+}
+
+   /* The following function serves a read of the MYLE Gesture Client   */
+   /* Characteristic Configuration Descriptor.                          */
+static Byte_t ReadGestureCCCD(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer)
+{
+   return(ReadClientConfiguration((Word_t)((DeviceInfo)?DeviceInfo->MYLEServerInfo.Gesture_Client_Configuration_Descriptor:0), ValueLength, Buffer));
+}
+
+   /* The following function serves a write of the MYLE Gesture Client  */
+   /* Characteristic Configuration Descriptor.                          */
+static Byte_t WriteGestureCCCD(DeviceInfo_t *DeviceInfo, Word_t ValueLength, Byte_t *Value)
+{
+   return(WriteClientConfiguration("Gesture", (DeviceInfo)?&(DeviceInfo->MYLEServerInfo.Gesture_Client_Configuration_Descriptor):NULL, ValueLength, Value));
+}
+
+   /* The following function is a utility function that formats the     */
+   /* specified input state and change mask (NULL for an empty mask) as */
+   /* a MYLE Inputs characteristic value (see MYLETyp.h for the         */
+   /* format).  This function returns the length of the value.          */
+static Word_t FormatInputs(BTPSCONST Input_Bitmap_t *State, BTPSCONST Input_Bitmap_t *Changes, Byte_t *Buffer)
+{
+   Byte_t Count;
+   Word_t Length;
+
+   Count  = Input_Get_Count();
+   Length = (Word_t)((Count + 7) / 8);
+
+   ASSIGN_HOST_BYTE_TO_LITTLE_ENDIAN_UNALIGNED_BYTE(Buffer, Count);
+
+   BTPS_MemCopy(&(Buffer[BYTE_SIZE]), State->Bits, Length);
+
+   if(Changes)
+      BTPS_MemCopy(&(Buffer[BYTE_SIZE + Length]), Changes->Bits, Length);
+   else
+      BTPS_MemInitialize(&(Buffer[BYTE_SIZE + Length]), 0, Length);
+
+   return(MYLE_INPUTS_VALUE_LENGTH(Count));
+}
+
+   /* The following function serves a read of the MYLE Inputs           */
+   /* characteristic value.                                             */
+static Byte_t ReadInputs(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer)
+{
+   *ValueLength = FormatInputs(&InputState, NULL, Buffer);
+
+   return(0);
+}
+
+   /* The following function serves a read of the MYLE Inputs Client    */
+   /* Characteristic Configuration Descriptor.                          */
+static Byte_t ReadInputsCCCD(DeviceInfo_t *DeviceInfo, Word_t ValueOffset, Word_t *ValueLength, Byte_t *Buffer)
+{
+   return(ReadClientConfiguration((Word_t)((DeviceInfo)?DeviceInfo->MYLEServerInfo.Inputs_Client_Configuration_Descriptor:0), ValueLength, Buffer));
+}
+
+   /* The following function serves a write of the MYLE Inputs Client   */
+   /* Characteristic Configuration Descriptor.                          */
+static Byte_t WriteInputsCCCD(DeviceInfo_t *DeviceInfo, Word_t ValueLength, Byte_t *Value)
+{
+   return(WriteClientConfiguration("Inputs", (DeviceInfo)?&(DeviceInfo->MYLEServerInfo.Inputs_Client_Configuration_Descriptor):NULL, ValueLength, Value));
+}
+
+   /* The following function serves a write of the MYLE Control         */
+   /* characteristic value (see MYLETyp.h for the format).  The commands*/
+   /* are checked in a first pass and applied in a second pass, so a    */
+   /* write is applied either completely or not at all.  Only a client  */
+   /* on an encrypted link may control the LEDs and outputs, which are  */
+   /* reset when the client disconnects.                                */
+   /* * NOTE * This function is called from the GATT Server callback,   */
+   /*          the commands take effect without waiting for the main    */
+   /*          loop.                                                    */
+static Byte_t WriteControl(DeviceInfo_t *DeviceInfo, Word_t ValueLength, Byte_t *Value)
+{
+   Byte_t       ret_val;
+   Byte_t       Opcode;
+   Byte_t       Parameter;
+   Word_t       Length;
+   Word_t       Index;
+   unsigned int Pass;
+
+   if((DeviceInfo) && (ConnectionEncrypted))
+   {
+      /* A write must hold at least one command.                        */
+      if(ValueLength)
+         ret_val = 0;
+      else
+         ret_val = ATT_PROTOCOL_ERROR_CODE_INVALID_ATTRIBUTE_VALUE_LENGTH;
+   }
+   else
+      ret_val = ATT_PROTOCOL_ERROR_CODE_INSUFFICIENT_AUTHENTICATION;
+
+   for(Pass = 0; (Pass < 2) && (!ret_val); Pass++)
+   {
+      for(Index = 0; (Index < ValueLength) && (!ret_val); Index += Length)
+      {
+         Opcode = READ_UNALIGNED_BYTE_LITTLE_ENDIAN(&(Value[Index]));
+
+         switch(Opcode)
+         {
+            case MYLE_CONTROL_OPCODE_SET_LED:
+               Length = MYLE_CONTROL_SET_LED_LENGTH;
+               break;
+            case MYLE_CONTROL_OPCODE_BLINK_LED:
+               Length = MYLE_CONTROL_BLINK_LED_LENGTH;
+               break;
+            case MYLE_CONTROL_OPCODE_WRITE_OUTPUTS:
+               Length = MYLE_CONTROL_WRITE_OUTPUTS_LENGTH;
+               break;
+            default:
+               Length = 0;
+               break;
+         }
+
+         if((Length) && ((ValueLength - Index) >= Length))
+         {
+            /* The first parameter of every command is the LED number or*/
+            /* the pin mask.                                            */
+            Parameter = READ_UNALIGNED_BYTE_LITTLE_ENDIAN(&(Value[Index + BYTE_SIZE]));
+
+            if(!Pass)
+            {
+               /* Only check the command in the first pass.             */
+               if((Opcode != MYLE_CONTROL_OPCODE_WRITE_OUTPUTS) && ((Parameter < CONTROL_FIRST_LED) || (Parameter >= CONTROL_NUMBER_OF_LEDS)))
+                  ret_val = MYLE_ATT_ERROR_CODE_CONTROL_INVALID;
+            }
+            else
+            {
+               switch(Opcode)
+               {
+                  case MYLE_CONTROL_OPCODE_SET_LED:
+                     Control_Set_LED(Parameter, (Boolean_t)(READ_UNALIGNED_BYTE_LITTLE_ENDIAN(&(Value[Index + (2 * BYTE_SIZE)])) != 0));
+                     break;
+                  case MYLE_CONTROL_OPCODE_BLINK_LED:
+                     Control_Blink_LED(Parameter, READ_UNALIGNED_WORD_LITTLE_ENDIAN(&(Value[Index + (2 * BYTE_SIZE)])));
+                     break;
+                  case MYLE_CONTROL_OPCODE_WRITE_OUTPUTS:
+                     Control_Write_Outputs(Parameter, READ_UNALIGNED_BYTE_LITTLE_ENDIAN(&(Value[Index + (2 * BYTE_SIZE)])));
+                     break;
+               }
+            }
+         }
+         else
+            ret_val = MYLE_ATT_ERROR_CODE_CONTROL_INVALID;
+      }
+   }
+
+   return(ret_val);
+}
+
+   /* The following table maps each entry of MYLE_Service[] (indexed by */
+   /* Attribute Offset) to the handler that serves it.  It is generated */
+   /* from the same attribute list as MYLE_Service[].                   */
+static BTPSCONST MYLE_Attribute_Handler_t MYLE_Attribute_Handlers[] =
+{
+   MYLE_SERVICE_ATTRIBUTES(MYLE_ATTRIBUTE_HANDLER)
+};
+
+#define MYLE_ATTRIBUTE_HANDLER_COUNT               (sizeof(MYLE_Attribute_Handlers)/sizeof(MYLE_Attribute_Handler_t))
+
+   /* Verify that every attribute of the service has a handler entry.   */
+MYLE_STATIC_ASSERT(MYLE_ATTRIBUTE_HANDLER_COUNT == MYLE_SERVICE_ATTRIBUTE_COUNT, MYLE_Attribute_Handler_Table_Size_Check);
+
+   /* The following function is responsible for serving a GATT Read     */
+   /* Request for a MYLE attribute.  The attribute is looked up directly*/
+   /* by its offset in the Attribute Handler table and either a Read    */
+   /* Response or an Error Response is sent.                            */
+static void ProcessMYLEReadRequest(GATT_Read_Request_Data_t *ReadRequestData)
+{
+   Byte_t                              ErrorCode;
+   Word_t                              ValueLength;
+   Byte_t                             *Value;
+   BTPSCONST MYLE_Attribute_Handler_t *Handler;
+
+   ValueLength = 0;
+   Value       = MYLEReadBuffer;
+
+   /* Make sure the attribute offset is one that we know about.         */
+   if(ReadRequestData->AttributeOffset < MYLE_ATTRIBUTE_HANDLER_COUNT)
+   {
+      Handler = &(MYLE_Attribute_Handlers[ReadRequestData->AttributeOffset]);
+
+      /* Only attributes flagged as long may be read at a non-zero      */
+      /* offset.                                                        */
+      if((!ReadRequestData->AttributeValueOffset) || (Handler->Flags & MYLE_ATTRIBUTE_HANDLER_FLAGS_LONG_READ))
+      {
+         if(Handler->Value)
+         {
+            /* Serve the constant value directly, starting at the       */
+            /* requested offset.                                        */
+            if(ReadRequestData->AttributeValueOffset <= Handler->ValueLength)
+            {
+               Value       = &(Handler->Value[ReadRequestData->AttributeValueOffset]);
+               ValueLength = (Word_t)(Handler->ValueLength - ReadRequestData->AttributeValueOffset);
+               ErrorCode   = 0;
+            }
+            else
+               ErrorCode = ATT_PROTOCOL_ERROR_CODE_INVALID_OFFSET;
+         }
+         else
+         {
+            if(Handler->ReadFunction)
+            {
+               ValueLength = (Word_t)sizeof(MYLEReadBuffer);
+               ErrorCode   = (*Handler->ReadFunction)(SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, ReadRequestData->RemoteDevice), ReadRequestData->AttributeValueOffset, &ValueLength, MYLEReadBuffer);
+            }
+            else
+               ErrorCode = ATT_PROTOCOL_ERROR_CODE_READ_NOT_PERMITTED;
+         }
+      }
+      else
+         ErrorCode = ATT_PROTOCOL_ERROR_CODE_ATTRIBUTE_NOT_LONG;
+   }
+   else
+      ErrorCode = ATT_PROTOCOL_ERROR_CODE_INVALID_HANDLE;
+
+   if(!ErrorCode)
+      GATT_Read_Response(BluetoothStackID, ReadRequestData->TransactionID, (unsigned int)ValueLength, Value);
+   else
+      GATT_Error_Response(BluetoothStackID, ReadRequestData->TransactionID, ReadRequestData->AttributeOffset, ErrorCode);
+}
+
+   /* The following function is responsible for serving a GATT Write    */
+   /* Request for a MYLE attribute.  The attribute is looked up directly*/
+   /* by its offset in the Attribute Handler table and either a Write   */
+   /* Response or an Error Response is sent.                            */
+static void ProcessMYLEWriteRequest(GATT_Write_Request_Data_t *WriteRequestData)
+{
+   Byte_t                              ErrorCode;
+   BTPSCONST MYLE_Attribute_Handler_t *Handler;
+
+   /* Make sure the attribute offset is one that we know about.         */
+   if(WriteRequestData->AttributeOffset < MYLE_ATTRIBUTE_HANDLER_COUNT)
+   {
+      Handler = &(MYLE_Attribute_Handlers[WriteRequestData->AttributeOffset]);
+
+      if(Handler->WriteFunction)
+      {
+         /* Prepared (long) writes are not supported.  A Prepare Write  */
+         /* (even at offset zero) is refused before it reaches the      */
+         /* handler, since the client may still cancel it.              */
+         if((!WriteRequestData->DelayWrite) && (!WriteRequestData->AttributeValueOffset))
+         {
+            if((WriteRequestData->AttributeValue) || (!WriteRequestData->AttributeValueLength))
+               ErrorCode = (*Handler->WriteFunction)(SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, WriteRequestData->RemoteDevice), WriteRequestData->AttributeValueLength, WriteRequestData->AttributeValue);
+            else
+               ErrorCode = ATT_PROTOCOL_ERROR_CODE_INVALID_ATTRIBUTE_VALUE_LENGTH;
+         }
+         else
+            ErrorCode = ATT_PROTOCOL_ERROR_CODE_ATTRIBUTE_NOT_LONG;
+      }
+      else
+         ErrorCode = ATT_PROTOCOL_ERROR_CODE_WRITE_NOT_PERMITTED;
+   }
+   else
+      ErrorCode = ATT_PROTOCOL_ERROR_CODE_INVALID_HANDLE;
+
+   if(!ErrorCode)
+      GATT_Write_Response(BluetoothStackID, WriteRequestData->TransactionID);
+   else
+      GATT_Error_Response(BluetoothStackID, WriteRequestData->TransactionID, WriteRequestData->AttributeOffset, ErrorCode);
+}
+
+   /* The following function is responsible for draining the Offline    */
+   /* Journal, i.e. the button transitions that have been recorded in   */
+   /* the Event Log but have not yet been delivered to the client.  The */
+   /* transitions are sent (in bulk) as notifications of the MYLE Button*/
+   /* History characteristic (see MYLETyp.h for the format) for as long */
+   /* as the client has subscribed and the stack accepts them.          */
+   /* Transitions that have been overwritten in the Event Log before    */
+   /* they could be delivered are accounted for in the header of the    */
+   /* next notification.                                                */
+   /* If the client acknowledges the journal (see WriteJournalAck()),   */
+   /* the transitions it reported as missing are retransmitted first,   */
+   /* new transitions are only sent within MYLE_JOURNAL_WINDOW_SIZE of  */
+   /* the last acknowledgement and everything that is unacknowledged is */
+   /* sent again once MYLE_JOURNAL_RETRANSMIT_TIMEOUT has passed without*/
+   /* an acknowledgement.                                               */
+   /* * NOTE * This function is called after every button poll and      */
+   /*          whenever the GATT transmit buffers become available      */
+   /*          again, so delivery resumes on its own after a reconnect  */
+   /*          or after the stack ran out of buffers.                   */
+static void DrainJournal(void)
+{
+   int                ret_val;
+   Word_t             Length;
+   Word_t             Limit;
+   Word_t             TokenLength;
+   Word_t             LostCount;
+   Byte_t             BatchSize;
+   Byte_t             Token[EVENT_CODEC_MAXIMUM_TOKEN_LENGTH];
+   DWord_t            Oldest;
+   DWord_t            Next;
+   DWord_t            First;
+   DWord_t            End;
+   DWord_t            Sequence;
+   DWord_t            BaseTimeStamp;
+   DWord_t            TimeStamp;
+   Boolean_t          Retransmit;
+   DeviceInfo_t      *DeviceInfo;
+   Event_Codec_t      Codec;
+   Event_Codec_t      Candidate;
+   Event_Log_Entry_t  Entry;
+   static Byte_t      Buffer[SPPLE_DATA_BUFFER_LENGTH];
+
+   /* Account for any undelivered transitions that have been          */
+   /* overwritten in the Event Log.                                     */
+   Oldest = EventLog_Oldest_Sequence();
+   if(JournalSequence < Oldest)
+   {
+      JournalLostCount += (Oldest - JournalSequence);
+      JournalSequence   = Oldest;
+   }
+
+   /* Overwritten transitions can neither be acknowledged nor           */
+   /* retransmitted.                                                    */
+   if(JournalAckSequence < Oldest)
+      JournalAckSequence = Oldest;
+
+   if(RetransmitSequence < Oldest)
+      RetransmitSequence = Oldest;
+
+   /* Only drain the journal to a connected client that has subscribed  */
+   /* via the History Client Characteristic Configuration Descriptor.   */
+   if((ConnectionID) && ((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, ConnectionBD_ADDR)) != NULL) && (DeviceInfo->MYLEServerInfo.History_Client_Configuration_Descriptor & GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_NOTIFY_ENABLE))
+   {
+      Next      = EventLog_Next_Sequence();
+      BatchSize = Config_Get()->JournalBatchSize;
+      Limit     = (Word_t)(ConnectionMTU - 3);
+      ret_val   = 1;
+
+      if(Limit > sizeof(Buffer))
+         Limit = sizeof(Buffer);
+
+      /* Send everything that is unacknowledged again if the client has */
+      /* stopped acknowledging (the last notifications may have been    */
+      /* lost without the client noticing).                             */
+      if((JournalReliable) && (JournalAckSequence < JournalSequence))
+      {
+         TimeStamp = BTPS_GetTickCount();
+
+         if((TimeStamp - JournalAckTime) >= MYLE_JOURNAL_RETRANSMIT_TIMEOUT)
+         {
+            RetransmitSequence = JournalAckSequence;
+            RetransmitEnd      = JournalSequence;
+            JournalAckTime     = TimeStamp;
+         }
+      }
+
+      while(ret_val > 0)
+      {
+         /* Retransmissions go first, new transitions are then sent as  */
+         /* far as the window allows.                                   */
+         Retransmit = (Boolean_t)(RetransmitSequence < RetransmitEnd);
+
+         if(Retransmit)
+         {
+            First     = RetransmitSequence;
+            End       = RetransmitEnd;
+            LostCount = 0;
+         }
+         else
+         {
+            First     = JournalSequence;
+            End       = Next;
+            LostCount = (Word_t)((JournalLostCount > 0xFFFF)?0xFFFF:JournalLostCount);
+
+            if((JournalReliable) && ((End - JournalAckSequence) > MYLE_JOURNAL_WINDOW_SIZE))
+               End = ((JournalAckSequence + MYLE_JOURNAL_WINDOW_SIZE) > First)?(JournalAckSequence + MYLE_JOURNAL_WINDOW_SIZE):First;
+         }
+
+         /* Build the notification header followed by as many tokens as */
+         /* fit in the current MTU (less the notification opcode and    */
+         /* handle), up to the configured batch size.                   */
+         if((BatchSize) && ((End - First) > BatchSize))
+            End = First + BatchSize;
+
+         if((First < End) && (EventLog_Get(First, &Entry)))
+            BaseTimeStamp = Entry.TimeStamp;
+         else
+            BaseTimeStamp = 0;
+
+         ASSIGN_HOST_DWORD_TO_LITTLE_ENDIAN_UNALIGNED_DWORD(Buffer, First);
+         ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(&(Buffer[DWORD_SIZE]), LostCount);
+         ASSIGN_HOST_DWORD_TO_LITTLE_ENDIAN_UNALIGNED_DWORD(&(Buffer[DWORD_SIZE + WORD_SIZE]), BaseTimeStamp);
+
+         Length = MYLE_JOURNAL_HEADER_LENGTH;
+
+         EventCodec_Initialize(&Codec, First, BaseTimeStamp);
+
+         /* A token is only committed if it fits, the codec is advanced */
+         /* on a copy until then.                                       */
+         while(Codec.Sequence < End)
+         {
+            Candidate = Codec;
+
+            if(((TokenLength = EventCodec_Encode(&Candidate, End, Token)) == 0) || ((Length + TokenLength) > Limit))
+               break;
+
+            BTPS_MemCopy(&(Buffer[Length]), Token, TokenLength);
+
+            Length += TokenLength;
+            Codec   = Candidate;
+         }
+
+         Sequence = Codec.Sequence;
+
+         /* Nothing more can be sent if not even one token fits (or the */
+         /* window is closed).                                          */
+         if((Sequence == First) && (!LostCount))
+            break;
+
+         ret_val = GATT_Handle_Value_Notification(BluetoothStackID, ServiceID, ConnectionID, MYLE_HISTORY_CHARACTERISTIC_ATTRIBUTE_OFFSET, Length, Buffer);
+
+         Perf_Count_Notification(Length, (Boolean_t)(ret_val > 0));
+
+         if(ret_val > 0)
+         {
+            /* The records have been delivered, advance the journal.    */
+            if(Retransmit)
+               RetransmitSequence = Sequence;
+            else
+            {
+               JournalSequence  = Sequence;
+               JournalLostCount = 0;
+            }
+         }
+      }
+   }
+}
+
+   /* The following function is called by the gesture engine (see       */
+   /* Gesture_Process()) for every recognized gesture.  The gesture is  */
+   /* notified to a connected client that has subscribed to the MYLE    */
+   /* Gesture characteristic.                                           */
+   /* * NOTE * Gestures are only delivered live, a client that needs    */
+   /*          every transition (including the ones that happened while */
+   /*          disconnected) uses the MYLE Button History instead.      */
+static void GestureCallback(BTPSCONST Gesture_Event_t *Event)
+{
+   int           Result;
+   Byte_t        Value[MYLE_GESTURE_VALUE_LENGTH];
+   DeviceInfo_t *DeviceInfo;
+
+   LastGesture = *Event;
+
+   Display(("Gesture %u on button %u (%u ms).\r\n", (unsigned int)Event->Gesture, (unsigned int)Event->Button, (unsigned int)Event->Duration));
+
+   if((ConnectionID) && ((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, ConnectionBD_ADDR)) != NULL) && (DeviceInfo->MYLEServerInfo.Gesture_Client_Configuration_Descriptor & GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_NOTIFY_ENABLE))
+   {
+      FormatGesture(Event, Value);
+
+      Result = GATT_Handle_Value_Notification(BluetoothStackID, ServiceID, ConnectionID, MYLE_GESTURE_CHARACTERISTIC_ATTRIBUTE_OFFSET, MYLE_GESTURE_VALUE_LENGTH, Value);
+
+      Perf_Count_Notification(MYLE_GESTURE_VALUE_LENGTH, (Boolean_t)(Result > 0));
+   }
+}
+
+   /* The following function notifies the specified input state and     */
+   /* change mask to a connected client that has subscribed to the MYLE */
+   /* Inputs characteristic.  All inputs that changed in a button poll  */
+   /* are sent in a single notification.                                */
+static void NotifyInputs(BTPSCONST Input_Bitmap_t *State, BTPSCONST Input_Bitmap_t *Changes)
+{
+   int           Result;
+   Word_t        Length;
+   Byte_t        Value[MYLE_INPUTS_VALUE_LENGTH(INPUT_MAXIMUM_INPUTS)];
+   DeviceInfo_t *DeviceInfo;
+
+   if((ConnectionID) && ((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, ConnectionBD_ADDR)) != NULL) && (DeviceInfo->MYLEServerInfo.Inputs_Client_Configuration_Descriptor & GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_NOTIFY_ENABLE))
+   {
+      Length = FormatInputs(State, Changes, Value);
+
+      Result = GATT_Handle_Value_Notification(BluetoothStackID, ServiceID, ConnectionID, MYLE_INPUTS_CHARACTERISTIC_ATTRIBUTE_OFFSET, Length, Value);
+
+      Perf_Count_Notification(Length, (Boolean_t)(Result > 0));
+   }
+}
+
+#if NOTIFICATION_STORM_PERIOD
+
+   /* The following function is the scheduler function of the           */
+   /* notification storm generator.  While a client is subscribed to the*/
+   /* MYLE Button characteristic, up to NOTIFICATION_STORM_BURST        */
+   /* notifications of the current button state are sent every          */
+   /* NOTIFICATION_STORM_PERIOD ms (or until GATT runs out of buffers). */
+   /* The generator is used together with the performance counters (see */
+   /* Perf_Display()) to measure the notification throughput and the    */
+   /* cost of serving requests while the link is saturated.             */
+   /* * NOTE * The storm generator is for test builds only, it is       */
+   /*          enabled by defining NOTIFICATION_STORM_PERIOD to a       */
+   /*          non-zero value.                                          */
+static void NotificationStormFunction(void *UserParameter)
+{
+   int           Result;
+   unsigned int  Count;
+   Byte_t        Value[MYLE_BUTTON_VALUE_LENGTH];
+   DeviceInfo_t *DeviceInfo;
+
+   if((ConnectionID) && ((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, ConnectionBD_ADDR)) != NULL) && (DeviceInfo->MYLEServerInfo.Button_Client_Configuration_Descriptor & GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_NOTIFY_ENABLE))
+   {
+      ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(Value, g_button_state);
+
+      for(Count = 0, Result = 1; (Count < NOTIFICATION_STORM_BURST) && (Result > 0); Count++)
+      {
+         Result = GATT_Handle_Value_Notification(BluetoothStackID, ServiceID, ConnectionID, MYLE_BUTTON_CHARACTERISTIC_ATTRIBUTE_OFFSET, MYLE_BUTTON_VALUE_LENGTH, Value);
+
+         Perf_Count_Notification(MYLE_BUTTON_VALUE_LENGTH, (Boolean_t)(Result > 0));
+      }
+   }
+}
+
+#endif
+
+   /* ***************************************************************** */
+   /*                         Event Callbacks                           */
+   /* ***************************************************************** */
+
+   /* The following function is for the GAP LE Event Receive Data       */
+   /* Callback.  This function will be called whenever a Callback has   */
+   /* been registered for the specified GAP LE Action that is associated*/
+   /* with the Bluetooth Stack.  This function passes to the caller the */
+   /* GAP LE Event Data of the specified Event and the GAP LE Event     */
+   /* Callback Parameter that was specified when this Callback was      */
+   /* installed.  The caller is free to use the contents of the GAP LE  */
+   /* Event Data ONLY in the context of this callback.  If the caller   */
+   /* requires the Data for a longer period of time, then the callback  */
+   /* function MUST copy the data into another Data Buffer.  This       */
+   /* function is guaranteed NOT to be invoked more than once           */
+   /* simultaneously for the specified installed callback (i.e.  this   */
+   /* function DOES NOT have be reentrant).  It Needs to be noted       */
+   /* however, that if the same Callback is installed more than once,   */
+   /* then the callbacks will be called serially.  Because of this, the */
+   /* processing in this function should be as efficient as possible.   */
+   /* It should also be noted that this function is called in the Thread*/
+   /* Context of a Thread that the User does NOT own.  Therefore,       */
+   /* processing in this function should be as efficient as possible    */
+   /* (this argument holds anyway because other GAP Events will not be  */
+   /* processed while this function call is outstanding).               */
+   /* * NOTE * This function MUST NOT Block and wait for Events that can*/
+   /*          only be satisfied by Receiving a Bluetooth Event         */
+   /*          Callback.  A Deadlock WILL occur because NO Bluetooth    */
+   /*          Callbacks will be issued while this function is currently*/
+   /*          outstanding.                                             */
+static void BTPSAPI GAP_LE_Event_Callback(unsigned int BluetoothStackID, GAP_LE_Event_Data_t *GAP_LE_Event_Data, unsigned long CallbackParameter)
+{
+   int                                           Result;
+   Word_t                                        ConnectionHandle;
+   BoardStr_t                                    BoardStr;
+   Boolean_t                                     Evicted;
+   DeviceInfo_t                                 *DeviceInfo;
+   Bond_Entry_t                                 *BondEntry;
+   Bond_Entry_t                                  EvictedEntry;
+   Work_Item_t                                   WorkItem;
+   GAP_LE_Authentication_Event_Data_t           *Authentication_Event_Data;
+   GAP_LE_Authentication_Response_Information_t  GAP_LE_Authentication_Response_Information;
+
+   /* Verify that all parameters to this callback are Semi-Valid.       */
+   if((BluetoothStackID) && (GAP_LE_Event_Data))
+   {
+      switch(GAP_LE_Event_Data->Event_Data_Type)
+      {
+         case etLE_Connection_Complete:
+            Display(("etLE_Connection_Complete with size %d.\r\n",(int)GAP_LE_Event_Data->Event_Data_Size));
+
+            if(GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data)
+            {
+               BD_ADDRToStr(GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Peer_Address, BoardStr);
+
+               Display(("Status:       0x%02X.\r\n", GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Status));
+               Display(("Role:         %s.\r\n", (GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Master)?"Master":"Slave"));
+               Display(("Address Type: %s.\r\n", (GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Peer_Address_Type == latPublic)?"Public":"Random"));
+               Display(("BD_ADDR:      %s.\r\n", BoardStr));
+
+               if(GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Status == HCI_ERROR_CODE_NO_ERROR)
+               {
+                  ConnectionBD_ADDR   = GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Peer_Address;
+                  ConnectionEncrypted = FALSE;
+
+                  /* A bonded device that reconnects becomes the Most   */
+                  /* Recently Used one in the Bond Table.               */
+                  BondTable_Search(ConnectionBD_ADDR);
+
+                  /* Make sure that no entry already exists.            */
+                  if((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, ConnectionBD_ADDR)) == NULL)
+                  {
+                     /* No entry exists so create one.                  */
+                     if(!CreateNewDeviceInfoEntry(&DeviceInfoList, GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Peer_Address_Type, ConnectionBD_ADDR))
+                        Display(("Failed to add device to Device Info List.\r\n"));
+                  }
+
+                  /* Count the ACL packets of this connection for the   */
+                  /* latency measurement.                               */
+                  if(!GAP_LE_Query_Connection_Handle(BluetoothStackID, ConnectionBD_ADDR, &ConnectionHandle))
+                     Latency_Set_Connection(ConnectionHandle);
+
+                  /* Set the LED.                                       */
+                  HAL_SetLED(0, 1);
+               }
+               else
+               {
+                  /* Directed Advertising towards the last bonded device*/
+                  /* timed out without a connection, fall back to       */
+                  /* Undirected Advertising.                            */
+                  if(GAP_LE_Event_Data->Event_Data.GAP_LE_Connection_Complete_Event_Data->Status == HCI_ERROR_CODE_DIRECTED_ADVERTISING_TIMEOUT)
+                  {
+                     WorkItem.Type = wtAdvertise;
+
+                     ScheduleWork(&WorkItem);
+                  }
+               }
+            }
+            break;
+         case etLE_Disconnection_Complete:
+            Display(("etLE_Disconnection_Complete with size %d.\r\n", (int)GAP_LE_Event_Data->Event_Data_Size));
+
+            if(GAP_LE_Event_Data->Event_Data.GAP_LE_Disconnection_Complete_Event_Data)
+            {
+               Display(("Status: 0x%02X.\r\n", GAP_LE_Event_Data->Event_Data.GAP_LE_Disconnection_Complete_Event_Data->Status));
+               Display(("Reason: 0x%02X.\r\n", GAP_LE_Event_Data->Event_Data.GAP_LE_Disconnection_Complete_Event_Data->Reason));
+
+               BD_ADDRToStr(GAP_LE_Event_Data->Event_Data.GAP_LE_Disconnection_Complete_Event_Data->Peer_Address, BoardStr);
+               Display(("BD_ADDR: %s.\r\n", BoardStr));
+
+               /* Advertise again (directed to the last bonded device   */
+               /* first, if any) and report the latencies measured      */
+               /* during the connection, both from the main loop.       */
+               WorkItem.Type = wtReconnect;
+
+               ScheduleWork(&WorkItem);
+
+               /* Check to see if the device info is present in the     */
+               /* list.                                                 */
+               if((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, ConnectionBD_ADDR)) != NULL)
+               {
+                  /* Flag that no service discovery operation is        */
+                  /* outstanding for this device.                       */
+                  DeviceInfo->Flags &= ~DEVICE_INFO_FLAGS_SERVICE_DISCOVERY_OUTSTANDING;
+
+                  /* Clear the CCCDs stored for this device.            */
+                  DeviceInfo->ServerInfo.Rx_Credit_Client_Configuration_Descriptor = 0;
+                  DeviceInfo->ServerInfo.Tx_Client_Configuration_Descriptor        = 0;
+
+                  /* The Client Characteristic Configuration of a bonded*/
+                  /* device persists across connections, so only clear  */
+                  /* the Button CCCD for devices we are not bonded with.*/
+                  if(!(DeviceInfo->Flags & DEVICE_INFO_FLAGS_LTK_VALID))
+                  {
+                     DeviceInfo->MYLEServerInfo.Button_Client_Configuration_Descriptor  = 0;
+                     DeviceInfo->MYLEServerInfo.History_Client_Configuration_Descriptor = 0;
+                     DeviceInfo->MYLEServerInfo.Gesture_Client_Configuration_Descriptor = 0;
+                     DeviceInfo->MYLEServerInfo.Inputs_Client_Configuration_Descriptor  = 0;
+                  }
+
+                  /* Clear the Transmit Credits count.                  */
+                  DeviceInfo->TransmitCredits = 0;
+               }
+
+               /* Clear the saved Connection BD_ADDR.                   */
+               ASSIGN_BD_ADDR(ConnectionBD_ADDR, 0, 0, 0, 0, 0, 0);
+
+               ConnectionEncrypted = FALSE;
+
+               /* Transitions that were sent but not acknowledged are   */
+               /* sent again on the next connection.                    */
+               if(JournalReliable)
+               {
+                  JournalSequence = JournalAckSequence;
+                  JournalReliable = FALSE;
+               }
+
+               RetransmitSequence = RetransmitEnd;
+
+               /* Undo the control of the disconnected client.          */
+               Control_Reset();
+
+               /* Clear the LED.                                        */
+               HAL_SetLED(0, 0);
+            }
+            break;
+         case etLE_Encryption_Change:
+            Display(("etLE_Encryption_Change with size %d.\r\n", (int)GAP_LE_Event_Data->Event_Data_Size));
+
+            /* Track whether the link to the connected device is        */
+            /* encrypted (see WriteConfiguration()).                    */
+            if((GAP_LE_Event_Data->Event_Data.GAP_LE_Encryption_Change_Event_Data) && (COMPARE_BD_ADDR(GAP_LE_Event_Data->Event_Data.GAP_LE_Encryption_Change_Event_Data->BD_ADDR, ConnectionBD_ADDR)))
+            {
+               Display(("Status: 0x%02X.\r\n", GAP_LE_Event_Data->Event_Data.GAP_LE_Encryption_Change_Event_Data->Encryption_Change_Status));
+
+               ConnectionEncrypted = (Boolean_t)((GAP_LE_Event_Data->Event_Data.GAP_LE_Encryption_Change_Event_Data->Encryption_Change_Status == HCI_ERROR_CODE_NO_ERROR) && (GAP_LE_Event_Data->Event_Data.GAP_LE_Encryption_Change_Event_Data->Encryption_Mode == emEnabled));
+            }
+            break;
+         case etLE_Encryption_Refresh_Complete:
+            Display(("etLE_Encryption_Refresh_Complete with size %d.\r\n", (int)GAP_LE_Event_Data->Event_Data_Size));
+
+            if((GAP_LE_Event_Data->Event_Data.GAP_LE_Encryption_Refresh_Complete_Event_Data) && (COMPARE_BD_ADDR(GAP_LE_Event_Data->Event_Data.GAP_LE_Encryption_Refresh_Complete_Event_Data->BD_ADDR, ConnectionBD_ADDR)))
+               ConnectionEncrypted = (Boolean_t)(GAP_LE_Event_Data->Event_Data.GAP_LE_Encryption_Refresh_Complete_Event_Data->Status == HCI_ERROR_CODE_NO_ERROR);
+            break;
+         case etLE_Authentication:
+            Display(("etLE_Authentication with size %d.\r\n", (int)GAP_LE_Event_Data->Event_Data_Size));
+
+            /* Make sure the authentication event data is valid before  */
+            /* continueing.                                             */
+            if((Authentication_Event_Data = GAP_LE_Event_Data->Event_Data.GAP_LE_Authentication_Event_Data) != NULL)
+            {
+               BD_ADDRToStr(Authentication_Event_Data->BD_ADDR, BoardStr);
+
+               switch(Authentication_Event_Data->GAP_LE_Authentication_Event_Type)
+               {
+                  case latLongTermKeyRequest:
+                     Display(("latKeyRequest(BD_ADDR = %s).\r\n", BoardStr));
+
+                     /* The other side of a connection is requesting    */
+                     /* that we start encryption.  Regenerating the LTK */
+                     /* is deferred to the main loop.                   */
+                     WorkItem.Type    = wtLongTermKeyRequest;
+                     WorkItem.BD_ADDR = Authentication_Event_Data->BD_ADDR;
+                     WorkItem.EDIV    = Authentication_Event_Data->Authentication_Event_Data.Long_Term_Key_Request.EDIV;
+                     WorkItem.Rand    = Authentication_Event_Data->Authentication_Event_Data.Long_Term_Key_Request.Rand;
+
+                     ScheduleWork(&WorkItem);
+                     break;
+                  case latPairingRequest:
+                     Display(("Pairing Request: %s.\r\n",BoardStr));
+
+                     /* This is a pairing request. Respond with a       */
+                     /* Pairing Response.                               */
+                     /* * NOTE * This is only sent from Master to Slave.*/
+                     /*          Thus we must be the Slave in this      */
+                     /*          connection.                            */
+
+                     /* Send the Pairing Response.                      */
+                     SlavePairingRequestResponse(Authentication_Event_Data->BD_ADDR);
+                     break;
+                  case latConfirmationRequest:
+                     Display(("latConfirmationRequest.\r\n"));
+
+                     if(Authentication_Event_Data->Authentication_Event_Data.Confirmation_Request.Request_Type == crtNone)
+                     {
+                        Display(("Invoking Just Works.\r\n"));
+
+                        /* Just Accept Just Works Pairing.              */
+                        GAP_LE_Authentication_Response_Information.GAP_LE_Authentication_Type = larConfirmation;
+
+                        /* By setting the Authentication_Data_Length to */
+                        /* any NON-ZERO value we are informing the GAP  */
+                        /* LE Layer that we are accepting Just Works    */
+                        /* Pairing.                                     */
+                        GAP_LE_Authentication_Response_Information.Authentication_Data_Length = DWORD_SIZE;
+
+                        Result = GAP_LE_Authentication_Response(BluetoothStackID, Authentication_Event_Data->BD_ADDR, &GAP_LE_Authentication_Response_Information);
+                        if(Result)
+                        {
+                           Display(("GAP_LE_Authentication_Response returned %d.\r\n",Result));
+                        }
+                     }
+                     break;
+                  case latSecurityEstablishmentComplete:
+                     Display(("Security Re-Establishment Complete: %s.\r\n", BoardStr));
+                     Display(("                            Status: 0x%02X.\r\n", Authentication_Event_Data->Authentication_Event_Data.Security_Establishment_Complete.Status));
+                     break;
+                  case latPairingStatus:
+                     Display(("Pairing Status: %s.\r\n", BoardStr));
+                     Display(("        Status: 0x%02X.\r\n", Authentication_Event_Data->Authentication_Event_Data.Pairing_Status.Status));
+
+                     if(Authentication_Event_Data->Authentication_Event_Data.Pairing_Status.Status == GAP_LE_PAIRING_STATUS_NO_ERROR)
+                     {
+                        Display(("Key Size: %d.\r\n", Authentication_Event_Data->Authentication_Event_Data.Pairing_Status.Negotiated_Encryption_Key_Size));
+
+                        /* Flag that we are now bonded with this device */
+                        /* so that its configuration is retained across */
+                        /* connections.                                 */
+                        if((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, Authentication_Event_Data->BD_ADDR)) != NULL)
+                        {
+                           /* Record the bond in the Bond Table, this   */
+                           /* may evict the Least Recently Used device. */
+                           BondEntry = BondTable_Add(DeviceInfo->ConnectionBD_ADDR, &EvictedEntry, &Evicted);
+
+                           if(Evicted)
+                              ForgetBond(&EvictedEntry);
+
+                           BondEntry->AddressType  = DeviceInfo->ConnectionAddressType;
+                           BondEntry->Flags       |= BOND_ENTRY_FLAGS_LE_BONDED;
+
+                           /* Add a newly bonded device to the White    */
+                           /* List.                                     */
+                           if(!(DeviceInfo->Flags & DEVICE_INFO_FLAGS_LTK_VALID))
+                              AddDeviceToWhiteList(DeviceInfo->ConnectionAddressType, DeviceInfo->ConnectionBD_ADDR);
+
+                           DeviceInfo->Flags |= DEVICE_INFO_FLAGS_LTK_VALID;
+
+                           /* Remember this device as the target of     */
+                           /* Directed Advertising on reconnection.     */
+                           LastBondedBD_ADDR = Authentication_Event_Data->BD_ADDR;
+                        }
+                     }
+                     else
+                     {
+                        /* Failed to pair so delete the key entry for   */
+                        /* this device and disconnect the link.         */
+                        if((DeviceInfo = DeleteDeviceInfoEntry(&DeviceInfoList, Authentication_Event_Data->BD_ADDR)) != NULL)
+                        {
+                           /* A previous bond with this device is gone, */
+                           /* remove it from the White List and the Bond*/
+                           /* Table as well.                            */
+                           if(DeviceInfo->Flags & DEVICE_INFO_FLAGS_LTK_VALID)
+                              RemoveDeviceFromWhiteList(DeviceInfo->ConnectionAddressType, DeviceInfo->ConnectionBD_ADDR);
+
+                           BondTable_Delete(DeviceInfo->ConnectionBD_ADDR);
+
+                           FreeDeviceInfoEntryMemory(DeviceInfo);
+                        }
+
+                        /* Disconnect the Link.                         */
+                        GAP_LE_Disconnect(BluetoothStackID, Authentication_Event_Data->BD_ADDR);
+                     }
+                     break;
+                  case latEncryptionInformationRequest:
+                     Display(("Encryption Information Request %s.\r\n", BoardStr));
+
+                     /* Generate new LTK,EDIV and Rand and respond with */
+                     /* them (deferred to the main loop).               */
+                     WorkItem.Type    = wtEncryptionInformationRequest;
+                     WorkItem.BD_ADDR = Authentication_Event_Data->BD_ADDR;
+                     WorkItem.KeySize = Authentication_Event_Data->Authentication_Event_Data.Encryption_Request_Information.Encryption_Key_Size;
+
+                     ScheduleWork(&WorkItem);
+                     break;
+               }
+            }
+            break;
+      }
+   }
+}
+
+
+   /* The following function is for an GATT Server Event Callback.  This*/
+   /* function will be called whenever a GATT Request is made to the    */
+   /* server who registers this function that cannot be handled         */
+   /* internally by GATT.  This function passes to the caller the GATT  */
+   /* Server Event Data that occurred and the GATT Server Event Callback*/
+   /* Parameter that was specified when this Callback was installed.    */
+   /* The caller is free to use the contents of the GATT Server Event   */
+   /* Data ONLY in the context of this callback.  If the caller requires*/
+   /* the Data for a longer period of time, then the callback function  */
+   /* MUST copy the data into another Data Buffer.  This function is    */
+   /* guaranteed NOT to be invoked more than once simultaneously for the*/
+   /* specified installed callback (i.e.  this function DOES NOT have be*/
+   /* reentrant).  It Needs to be noted however, that if the same       */
+   /* Callback is installed more than once, then the callbacks will be  */
+   /* called serially.  Because of this, the processing in this function*/
+   /* should be as efficient as possible.  It should also be noted that */
+   /* this function is called in the Thread Context of a Thread that the*/
+   /* User does NOT own.  Therefore, processing in this function should */
+   /* be as efficient as possible (this argument holds anyway because   */
+   /* another GATT Event (Server/Client or Connection) will not be      */
+   /* processed while this function call is outstanding).               */
+   /* * NOTE * This function MUST NOT Block and wait for Events that can*/
+   /*          only be satisfied by Receiving a Bluetooth Event         */
+   /*          Callback.  A Deadlock WILL occur because NO Bluetooth    */
+   /*          Callbacks will be issued while this function is currently*/
+   /*          outstanding.                                             */
+static void BTPSAPI GATT_ServerEventCallback(unsigned int BluetoothStackID, GATT_Server_Event_Data_t *GATT_ServerEventData, unsigned long CallbackParameter)
+{
+   Word_t StartTime;
+
+   StartTime = Perf_Get_Time();
+
+   /* Verify that all parameters to this callback are Semi-Valid.       */
+   if((BluetoothStackID) && (GATT_ServerEventData))
+   {
+      switch(GATT_ServerEventData->Event_Data_Type)
+      {
+         case etGATT_Server_Read_Request:
+            /* Verify that the Event Data is valid.                     */
+            if(GATT_ServerEventData->Event_Data.GATT_Read_Request_Data)
+            {
+               Perf_Count_Request(prReadRequest);
+
+               ProcessMYLEReadRequest(GATT_ServerEventData->Event_Data.GATT_Read_Request_Data);
+            }
+            else
+               Display(("Invalid Read Request Event Data.\r\n"));
+            break;
+         case etGATT_Server_Write_Request:
+            /* Verify that the Event Data is valid.                     */
+            if(GATT_ServerEventData->Event_Data.GATT_Write_Request_Data)
+            {
+               Perf_Count_Request(prWriteRequest);
+
+               ProcessMYLEWriteRequest(GATT_ServerEventData->Event_Data.GATT_Write_Request_Data);
+            }
+            else
+               Display(("Invalid Write Request Event Data.\r\n"));
+            break;
+      }
+   }
+
+   /* Account for the time spent serving the event.                     */
+   Perf_Count_Callback(StartTime);
+}
+
+   /* The following function is for an GATT Connection Event Callback.  */
+   /* This function is called for GATT Connection Events that occur on  */
+   /* the specified Bluetooth Stack.  This function passes to the caller*/
+   /* the GATT Connection Event Data that occurred and the GATT         */
+   /* Connection Event Callback Parameter that was specified when this  */
+   /* Callback was installed.  The caller is free to use the contents of*/
+   /* the GATT Client Event Data ONLY in the context of this callback.  */
+   /* If the caller requires the Data for a longer period of time, then */
+   /* the callback function MUST copy the data into another Data Buffer.*/
+   /* This function is guaranteed NOT to be invoked more than once      */
+   /* simultaneously for the specified installed callback (i.e.  this   */
+   /* function DOES NOT have be reentrant).  It Needs to be noted       */
+   /* however, that if the same Callback is installed more than once,   */
+   /* then the callbacks will be called serially.  Because of this, the */
+   /* processing in this function should be as efficient as possible.   */
+   /* It should also be noted that this function is called in the Thread*/
+   /* Context of a Thread that the User does NOT own.  Therefore,       */
+   /* processing in this function should be as efficient as possible    */
+   /* (this argument holds anyway because another GATT Event            */
+   /* (Server/Client or Connection) will not be processed while this    */
+   /* function call is outstanding).                                    */
+   /* * NOTE * This function MUST NOT Block and wait for Events that can*/
+   /*          only be satisfied by Receiving a Bluetooth Event         */
+   /*          Callback.  A Deadlock WILL occur because NO Bluetooth    */
+   /*          Callbacks will be issued while this function is currently*/
+   /*          outstanding.                                             */
+static void BTPSAPI GATT_Connection_Event_Callback(unsigned int BluetoothStackID, GATT_Connection_Event_Data_t *GATT_Connection_Event_Data, unsigned long CallbackParameter)
+{
+   BoardStr_t    BoardStr;
+
+   /* Verify that all parameters to this callback are Semi-Valid.       */
+   if((BluetoothStackID) && (GATT_Connection_Event_Data))
+   {
+      /* Determine the Connection Event that occurred.                  */
+      switch(GATT_Connection_Event_Data->Event_Data_Type)
+      {
+         case etGATT_Connection_Device_Connection:
+            if(GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data)
+            {
+               /* Save the Connection ID for later use.                 */
+               ConnectionID  = GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->ConnectionID;
+               ConnectionMTU = GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->MTU;
+
+               /* Start measuring the load of this connection.          */
+               Perf_Reset();
+
+               Display(("\r\netGATT_Connection_Device_Connection with size %u: \r\n", GATT_Connection_Event_Data->Event_Data_Size));
+               BD_ADDRToStr(GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->RemoteDevice, BoardStr);
+               Display(("Connection ID:   %u.\r\n", GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->ConnectionID));
+               Display(("Connection Type: %s.\r\n", ((GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->ConnectionType == gctLE)?"LE":"BR/EDR")));
+               Display(("Remote Device:   %s.\r\n", BoardStr));
+               Display(("Connection MTU:  %u.\r\n", GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_Data->MTU));
+            }
+            else
+               Display(("Error - Null Connection Data.\r\n"));
+            break;
+         case etGATT_Connection_Device_Connection_MTU_Update:
+            if(GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_MTU_Update_Data)
+            {
+               /* Larger journal notifications fit in the new MTU.      */
+               ConnectionMTU = GATT_Connection_Event_Data->Event_Data.GATT_Device_Connection_MTU_Update_Data->MTU;
+
+               Display(("\r\netGATT_Connection_Device_Connection_MTU_Update, MTU: %u.\r\n", ConnectionMTU));
+            }
+            break;
+         case etGATT_Connection_Device_Buffer_Empty:
+            /* Resume the delivery of the Offline Journal now that the  */
+            /* transmit buffers are available again.                    */
+            DrainJournal();
+            break;
+         case etGATT_Connection_Device_Disconnection:
+            if(GATT_Connection_Event_Data->Event_Data.GATT_Device_Disconnection_Data)
+            {
+               /* Clear the Connection ID.                              */
+               ConnectionID  = 0;
+               ConnectionMTU = 0;
+
+               Display(("\r\netGATT_Connection_Device_Disconnection with size %u: \r\n", GATT_Connection_Event_Data->Event_Data_Size));
+               BD_ADDRToStr(GATT_Connection_Event_Data->Event_Data.GATT_Device_Disconnection_Data->RemoteDevice, BoardStr);
+               Display(("Connection ID:   %u.\r\n", GATT_Connection_Event_Data->Event_Data.GATT_Device_Disconnection_Data->ConnectionID));
+               Display(("Connection Type: %s.\r\n", ((GATT_Connection_Event_Data->Event_Data.GATT_Device_Disconnection_Data->ConnectionType == gctLE)?"LE":"BR/EDR")));
+               Display(("Remote Device:   %s.\r\n", BoardStr));
+            }
+            else
+               Display(("Error - Null Disconnection Data.\r\n"));
+            break;
+      }
+   }
+}
+
+#ifndef LE_ONLY_BUILD
+
+   /* The following function is for the GAP Event Receive Data Callback.*/
+   /* This function will be called whenever a Callback has been         */
+   /* registered for the specified GAP Action that is associated with   */
+   /* the Bluetooth Stack.  This function passes to the caller the GAP  */
+   /* Event Data of the specified Event and the GAP Event Callback      */
+   /* Parameter that was specified when this Callback was installed.    */
+   /* The caller is free to use the contents of the GAP Event Data ONLY */
+   /* in the context of this callback.  If the caller requires the Data */
+   /* for a longer period of time, then the callback function MUST copy */
+   /* the data into another Data Buffer.  This function is guaranteed   */
+   /* NOT to be invoked more than once simultaneously for the specified */
+   /* installed callback (i.e.  this function DOES NOT have be          */
+   /* reentrant).  It Needs to be noted however, that if the same       */
+   /* Callback is installed more than once, then the callbacks will be  */
+   /* called serially.  Because of this, the processing in this function*/
+   /* should be as efficient as possible.  It should also be noted that */
+   /* this function is called in the Thread Context of a Thread that the*/
+   /* User does NOT own.  Therefore, processing in this function should */
+   /* be as efficient as possible (this argument holds anyway because   */
+   /* other GAP Events will not be processed while this function call is*/
+   /* outstanding).                                                     */
+   /* * NOTE * This function MUST NOT Block and wait for events that    */
+   /*          can only be satisfied by Receiving other GAP Events.  A  */
+   /*          Deadlock WILL occur because NO GAP Event Callbacks will  */
+   /*          be issued while this function is currently outstanding.  */
+static void BTPSAPI GAP_Event_Callback(unsigned int BluetoothStackID, GAP_Event_Data_t *GAP_Event_Data, unsigned long CallbackParameter)
+{
+   int                               Result;
+   Boolean_t                         Evicted;
+   BoardStr_t                        Callback_BoardStr;
+   Bond_Entry_t                     *BondEntry;
+   Bond_Entry_t                      EvictedEntry;
+   ParameterList_t                   Params;
+   GAP_Remote_Name_Event_Data_t     *GAP_Remote_Name_Event_Data;
+   GAP_Authentication_Information_t  GAP_Authentication_Information;
+
+   /* First, check to see if the required parameters appear to be       */
+   /* semi-valid.                                                       */
+   if((BluetoothStackID) && (GAP_Event_Data))
+   {
+      /* The parameters appear to be semi-valid, now check to see what  */
+      /* type the incoming event is.                                    */
+      switch(GAP_Event_Data->Event_Data_Type)
+      {
+         case etAuthentication:
+            /* An authentication event occurred, determine which type of*/
+            /* authentication event occurred.                           */
+            switch(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->GAP_Authentication_Event_Type)
+            {
+               case atLinkKeyRequest:
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atLinkKeyRequest: %s\r\n", Callback_BoardStr));
+
+                  /* Setup the authentication information response      */
+                  /* structure.                                         */
+                  GAP_Authentication_Information.GAP_Authentication_Type    = atLinkKey;
+                  GAP_Authentication_Information.Authentication_Data_Length = 0;
+
+                  /* See if we have stored a Link Key for the specified */
+                  /* device.                                            */
+                  if(((BondEntry = BondTable_Search(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device)) != NULL) && (BondEntry->Flags & BOND_ENTRY_FLAGS_LINK_KEY_VALID))
+                  {
+                     /* Link Key information stored, go ahead and       */
+                     /* respond with the stored Link Key.               */
+                     GAP_Authentication_Information.Authentication_Data_Length   = sizeof(Link_Key_t);
+                     GAP_Authentication_Information.Authentication_Data.Link_Key = BondEntry->LinkKey;
+                  }
+
+                  /* Submit the authentication response.                */
+                  Result = GAP_Authentication_Response(BluetoothStackID, GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, &GAP_Authentication_Information);
+
+                  /* Check the result of the submitted command.         */
+                  if(!Result)
+                     DisplayFunctionSuccess("GAP_Authentication_Response");
+                  else
+                     DisplayFunctionError("GAP_Authentication_Response", Result);
+                  break;
+               case atPINCodeRequest:
+                  /* A pin code request event occurred, first display   */
+                  /* the BD_ADD of the remote device requesting the pin.*/
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atPINCodeRequest: %s\r\n", Callback_BoardStr));
+
+                  /* Note the current Remote BD_ADDR that is requesting */
+                  /* the PIN Code.                                      */
+                  CurrentCBRemoteBD_ADDR = GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device;
+
+                  Params.NumberofParameters = 1;
+                  Params.Params[0].strParam = DEFAULT_PIN_CODE;
+
+                  PINCodeResponse(&Params);
+                  break;
+               case atAuthenticationStatus:
+                  /* An authentication status event occurred, display   */
+                  /* all relevant information.                          */
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atAuthenticationStatus: %d for %s\r\n", GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Authentication_Event_Data.Authentication_Status, Callback_BoardStr));
+
+                  /* Flag that there is no longer a current             */
+                  /* Authentication procedure in progress.              */
+                  ASSIGN_BD_ADDR(CurrentCBRemoteBD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+                  break;
+               case atLinkKeyCreation:
+                  /* A link key creation event occurred, first display  */
+                  /* the remote device that caused this event.          */
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atLinkKeyCreation: %s\r\n", Callback_BoardStr));
+
+                  /* Now store the link Key in the Bond Table (either   */
+                  /* over the old key or in a new entry, evicting the   */
+                  /* Least Recently Used device if the table is full).  */
+                  BondEntry = BondTable_Add(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, &EvictedEntry, &Evicted);
+
+                  if(Evicted)
+                     ForgetBond(&EvictedEntry);
+
+                  BondEntry->LinkKey  = GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Authentication_Event_Data.Link_Key_Info.Link_Key;
+                  BondEntry->Flags   |= BOND_ENTRY_FLAGS_LINK_KEY_VALID;
+
+                  Display(("Link Key Stored.\r\n"));
+                  break;
+               case atIOCapabilityRequest:
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atIOCapabilityRequest: %s\r\n", Callback_BoardStr));
+
+                  /* Setup the Authentication Information Response      */
+                  /* structure.                                         */
+                  GAP_Authentication_Information.GAP_Authentication_Type                                      = atIOCapabilities;
+                  GAP_Authentication_Information.Authentication_Data_Length                                   = sizeof(GAP_IO_Capabilities_t);
+                  GAP_Authentication_Information.Authentication_Data.IO_Capabilities.IO_Capability            = (GAP_IO_Capability_t)IOCapability;
+                  GAP_Authentication_Information.Authentication_Data.IO_Capabilities.MITM_Protection_Required = MITMProtection;
+                  GAP_Authentication_Information.Authentication_Data.IO_Capabilities.OOB_Data_Present         = FALSE;
+
+                  /* Submit the Authentication Response.                */
+                  Result = GAP_Authentication_Response(BluetoothStackID, GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, &GAP_Authentication_Information);
+
+                  /* Check the result of the submitted command.         */
+                  /* Check the result of the submitted command.         */
+                  if(!Result)
+                     DisplayFunctionSuccess("Auth");
+                  else
+                     DisplayFunctionError("Auth", Result);
+                  break;
+               case atIOCapabilityResponse:
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atIOCapabilityResponse: %s\r\n", Callback_BoardStr));
+                  break;
+               case atUserConfirmationRequest:
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atUserConfirmationRequest: %s\r\n", Callback_BoardStr));
+
+                  CurrentCBRemoteBD_ADDR = GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device;
+
+                  /* Invoke JUST Works Process...                       */
+                  GAP_Authentication_Information.GAP_Authentication_Type          = atUserConfirmation;
+                  GAP_Authentication_Information.Authentication_Data_Length       = (Byte_t)sizeof(Byte_t);
+                  GAP_Authentication_Information.Authentication_Data.Confirmation = TRUE;
+
+                  /* Submit the Authentication Response.                */
+                  Display(("\r\nAuto Accepting: %l\r\n", GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Authentication_Event_Data.Numeric_Value));
+
+                  Result = GAP_Authentication_Response(BluetoothStackID, GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, &GAP_Authentication_Information);
+
+                  if(!Result)
+                     DisplayFunctionSuccess("GAP_Authentication_Response");
+                  else
+                     DisplayFunctionError("GAP_Authentication_Response", Result);
+
+                  /* Flag that there is no longer a current             */
+                  /* Authentication procedure in progress.              */
+                  ASSIGN_BD_ADDR(CurrentCBRemoteBD_ADDR, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+                  break;
+               case atPasskeyRequest:
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atPasskeyRequest: %s\r\n", Callback_BoardStr));
+
+                  /* Note the current Remote BD_ADDR that is requesting */
+                  /* the Passkey.                                       */
+                  CurrentCBRemoteBD_ADDR = GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device;
+
+                  /* Inform the user that they will need to respond with*/
+                  /* a Passkey Response.                                */
+                  Display(("Respond with: PassKeyResponse\r\n"));
+                  break;
+               case atRemoteOutOfBandDataRequest:
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atRemoteOutOfBandDataRequest: %s\r\n", Callback_BoardStr));
+
+                  /* This application does not support OOB data so      */
+                  /* respond with a data length of Zero to force a      */
+                  /* negative reply.                                    */
+                  GAP_Authentication_Information.GAP_Authentication_Type    = atOutOfBandData;
+                  GAP_Authentication_Information.Authentication_Data_Length = 0;
+
+                  Result = GAP_Authentication_Response(BluetoothStackID, GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, &GAP_Authentication_Information);
+
+                  if(!Result)
+                     DisplayFunctionSuccess("GAP_Authentication_Response");
+                  else
+                     DisplayFunctionError("GAP_Authentication_Response", Result);
+                  break;
+               case atPasskeyNotification:
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atPasskeyNotification: %s\r\n", Callback_BoardStr));
+
+                  Display(("Passkey Value: %lu\r\n", GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Authentication_Event_Data.Numeric_Value));
+                  break;
+               case atKeypressNotification:
+                  BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Remote_Device, Callback_BoardStr);
+                  Display(("atKeypressNotification: %s\r\n", Callback_BoardStr));
+
+                  Display(("Keypress: %d\r\n", (int)GAP_Event_Data->Event_Data.GAP_Authentication_Event_Data->Authentication_Event_Data.Keypress_Type));
+                  break;
+               default:
+                  Display(("Un-handled Auth. Event.\r\n"));
+                  break;
+            }
+            break;
+         case etRemote_Name_Result:
+            /* Bluetooth Stack has responded to a previously issued     */
+            /* Remote Name Request that was issued.                     */
+            GAP_Remote_Name_Event_Data = GAP_Event_Data->Event_Data.GAP_Remote_Name_Event_Data;
+            if(GAP_Remote_Name_Event_Data)
+            {
+               /* Inform the user of the Result.                        */
+               BD_ADDRToStr(GAP_Remote_Name_Event_Data->Remote_Device, Callback_BoardStr);
+
+               Display(("BD_ADDR: %s.\r\n", Callback_BoardStr));
+
+               if(GAP_Remote_Name_Event_Data->Remote_Name)
+                  Display(("Name: %s.\r\n", GAP_Remote_Name_Event_Data->Remote_Name));
+               else
+                  Display(("Name: NULL.\r\n"));
+            }
+            break;
+         case etEncryption_Change_Result:
+            BD_ADDRToStr(GAP_Event_Data->Event_Data.GAP_Encryption_Mode_Event_Data->Remote_Device, Callback_BoardStr);
+            Display(("\r\netEncryption_Change_Result for %s, Status: 0x%02X, Mode: %s.\r\n", Callback_BoardStr,
+                                                                                             GAP_Event_Data->Event_Data.GAP_Encryption_Mode_Event_Data->Encryption_Change_Status,
+                                                                                             ((GAP_Event_Data->Event_Data.GAP_Encryption_Mode_Event_Data->Encryption_Mode == emDisabled)?"Disabled": "Enabled")));
+            break;
+         default:
+            /* An unknown/unexpected GAP event was received.            */
+            Display(("\r\nUnknown Event: %d.\r\n", GAP_Event_Data->Event_Data_Type));
+            break;
+      }
+   }
+}
+
+#endif
+
+   /* The following function is for the HCI Event Receive Data          */
+   /* Callback.  This function will be called whenever an HCI Event is  */
+   /* received from the controller.  This function passes to the caller */
+   /* the HCI Event Data of the specified Event and the HCI Event       */
+   /* Callback Parameter that was specified when this Callback was      */
+   /* installed.  The caller is free to use the contents of the HCI     */
+   /* Event Data ONLY in the context of this callback.  This function is*/
+   /* only used to mark the completion of transmitted packets for the   */
+   /* latency measurement (see Latency.h).                              */
+static void BTPSAPI HCI_Event_Callback(unsigned int BluetoothStackID, HCI_Event_Data_t *HCI_Event_Data, unsigned long CallbackParameter)
+{
+   unsigned int                                  Index;
+   HCI_Number_Of_Completed_Packets_Event_Data_t *Completed_Packets_Event_Data;
+
+   /* Verify that all parameters to this callback are Semi-Valid.       */
+   if((BluetoothStackID) && (HCI_Event_Data))
+   {
+      if((HCI_Event_Data->Event_Data_Type == etNumber_Of_Completed_Packets_Event) && ((Completed_Packets_Event_Data = HCI_Event_Data->Event_Data.HCI_Number_Of_Completed_Packets_Event_Data) != NULL))
+      {
+         for(Index = 0; Index < (unsigned int)Completed_Packets_Event_Data->Number_of_Handles; Index++)
+            Latency_Mark_Complete(Completed_Packets_Event_Data->HCI_Number_Of_Completed_Packets_Data[Index].Connection_Handle, Completed_Packets_Event_Data->HCI_Number_Of_Completed_Packets_Data[Index].HC_Num_Of_Completed_Packets);
+      }
+   }
+}
+
+   /* The following function is the Debug Callback that is registered   */
+   /* with the Bluetooth Stack.  This function is called for every HCI  */
+   /* packet that is sent to or received from the controller.  The ACL  */
+   /* packets that are sent are counted for the latency measurement     */
+   /* (see Latency.h) and all packets are captured if the HCI Capture is*/
+   /* present (see HCICapture.h).                                       */
+static void BTPSAPI HCI_Debug_Callback(unsigned int BluetoothStackID, Boolean_t PacketSent, HCI_Packet_t *HCIPacket, unsigned long CallbackParameter)
+{
+   /* Verify that all parameters to this callback are Semi-Valid.       */
+   if((BluetoothStackID) && (HCIPacket))
+   {
+      /* The packet starts with the Connection Handle (the upper four   */
+      /* bits are the Packet Boundary and Broadcast Flags).             */
+      if((PacketSent) && (HCIPacket->HCIPacketType == ptHCIACLDataPacket) && (HCIPacket->HCIPacketLength >= WORD_SIZE))
+         Latency_Mark_Sent((Word_t)(READ_UNALIGNED_WORD_LITTLE_ENDIAN(HCIPacket->HCIPacketData) & 0x0FFF));
+
+#if HCI_CAPTURE_RECORDS
+
+      HCICapture_Packet(PacketSent, HCIPacket);
+
+#endif
+   }
+}
+
+   /* ***************************************************************** */
+   /*                    End of Event Callbacks.                        */
+   /* ***************************************************************** */
+
+   /* The following function is used to initialize the application      */
+   /* instance.  This function should open the stack and prepare to     */
+   /* execute commands based on user input.  The first parameter passed */
+   /* to this function is the HCI Driver Information that will be used  */
+   /* when opening the stack and the second parameter is used to pass   */
+   /* parameters to BTPS_Init.  This function returns the               */
+   /* BluetoothStackID returned from BSC_Initialize on success or a     */
+   /* negative error code (of the form APPLICATION_ERROR_XXX).          */
+int InitializeApplication(HCI_DriverInformation_t *HCI_DriverInformation, BTPS_Initialization_t *BTPS_Initialization)
+{
+   int         ret_val = APPLICATION_ERROR_UNABLE_TO_OPEN_STACK;
+   Work_Item_t WorkItem;
+
+   /* Next, makes sure that the Driver Information passed appears to be */
+   /* semi-valid.                                                       */
+   if((HCI_DriverInformation) && (BTPS_Initialization))
+   {
+      /* Try to Open the stack and check if it was successful.          */
+      if(!OpenStack(HCI_DriverInformation, BTPS_Initialization))
+      {
+         /* Discard any gesture that was in progress.                   */
+         Gesture_Initialize();
+
+         /* Execute the work deferred from the Bluetooth callbacks on   */
+         /* the main loop.                                              */
+         if(!BTPS_AddFunctionToScheduler(WorkQueueFunction, NULL, WORK_QUEUE_PERIOD))
+            Display(("Unable to add the Work Queue to the scheduler.\r\n"));
+
+         /* Open the pairing window, the White List is not used until it*/
+         /* closes.                                                     */
+         PairingWindowOpen = TRUE;
+
+         if(!BTPS_AddFunctionToScheduler(PairingWindowFunction, NULL, WHITE_LIST_PAIRING_WINDOW))
+         {
+            Display(("Unable to add the Pairing Window to the scheduler.\r\n"));
+
+            PairingWindowOpen = FALSE;
+         }
+
+#if NOTIFICATION_STORM_PERIOD
+
+         /* Start the notification storm generator (test builds only).  */
+         if(!BTPS_AddFunctionToScheduler(NotificationStormFunction, NULL, NOTIFICATION_STORM_PERIOD))
+            Display(("Unable to add the Notification Storm to the scheduler.\r\n"));
+
+#endif
+
+         /* First, attempt to set the Device to be Connectable.         */
+         ret_val = SetConnect();
+
+         /* Next, check to see if the Device was successfully made      */
+         /* Connectable.                                                */
+         if(!ret_val)
+         {
+            /* Now that the device is Connectable attempt to make it    */
+            /* Discoverable.                                            */
+            ret_val = SetDisc();
+
+            /* Next, check to see if the Device was successfully made   */
+            /* Discoverable.                                            */
+            if(!ret_val)
+            {
+               /* Now that the device is discoverable attempt to make it*/
+               /* pairable.                                             */
+               ret_val = SetPairable();
+               if(!ret_val)
+               {
+                  /* Register an SPPLE Server and open an SPP Server.   */
+                  RegisterService(NULL);
+
+                  BootTime_Mark(bpServices);
+
+                  /* Advertise for connections.  Without advertising we */
+                  /* cannot be reached, flag the failure so the stack is*/
+                  /* restarted.                                         */
+                  if(!AdvertiseLE(NULL))
+                     BootTime_Mark(bpAdvertising);
+                  else
+                     ApplicationFailed = TRUE;
+
+                  /* Report the local device and the start-up times once*/
+                  /* we are advertising.                                */
+                  WorkItem.Type = wtBootReport;
+
+                  ScheduleWork(&WorkItem);
+
+                  /* Return success to the caller.                      */
+                  ret_val = (int)BluetoothStackID;
+               }
+               else
+                  DisplayFunctionError("SetPairable", ret_val);
+            }
+            else
+               DisplayFunctionError("SetDisc", ret_val);
+         }
+         else
+            DisplayFunctionError("SetDisc", ret_val);
+
+         /* In some error occurred then close the stack.                */
+         if(ret_val < 0)
+         {
+            /* Close the Bluetooth Stack.                               */
+            CloseStack();
+         }
+      }
+      else
+      {
+         /* There was an error while attempting to open the Stack.      */
+         Display(("Unable to open the stack.\r\n"));
+      }
+   }
+   else
+      ret_val = APPLICATION_ERROR_INVALID_PARAMETERS;
+
+   return(ret_val);
+}
+
+   /* The following function is used to shut down the application       */
+   /* instance so that it can be initialized again in place (see        */
+   /* InitializeApplication()).  The bonds and the configuration are    */
+   /* retained.                                                         */
+void ShutdownApplication(void)
+{
+   /* Remove the scheduled functions.                                   */
+   BTPS_DeleteFunctionFromScheduler(WorkQueueFunction, NULL);
+   BTPS_DeleteFunctionFromScheduler(PairingWindowFunction, NULL);
+
+#if NOTIFICATION_STORM_PERIOD
+
+   BTPS_DeleteFunctionFromScheduler(NotificationStormFunction, NULL);
+
+#endif
+
+   /* Close the Bluetooth Stack (if it is still open).                  */
+   if(BluetoothStackID)
+      CloseStack();
+}
+
+   /* The following function is used to determine whether the           */
+   /* application has detected a failure that it cannot recover from on */
+   /* its own (for example the controller refuses to advertise).  This  */
+   /* function returns TRUE if the application should be restarted.     */
+Boolean_t QueryApplicationFailed(void)
+{
+   return(ApplicationFailed);
+}
+
+
+Boolean_t send_notification()
+{
+	Boolean_t     ret_val = FALSE;
+	DeviceInfo_t *DeviceInfo;
+
+	Display(("Try to send notification\r\n"));
+
+	if(ConnectionID != 0)
+	{
+		/* Only notify a client that has subscribed via the Button    */
+		/* Client Characteristic Configuration Descriptor.            */
+		if(((DeviceInfo = SearchDeviceInfoEntryByBD_ADDR(&DeviceInfoList, ConnectionBD_ADDR)) != NULL) && (DeviceInfo->MYLEServerInfo.Button_Client_Configuration_Descriptor & GATT_CLIENT_CONFIGURATION_CHARACTERISTIC_NOTIFY_ENABLE))
+		{
+			Byte_t Temp[2];
+
+			ASSIGN_HOST_WORD_TO_LITTLE_ENDIAN_UNALIGNED_WORD(Temp, g_button_state);
+
+			Latency_Mark_Submit();
+
+			int Result = GATT_Handle_Value_Notification(BluetoothStackID, ServiceID, ConnectionID, MYLE_BUTTON_CHARACTERISTIC_ATTRIBUTE_OFFSET, MYLE_BUTTON_VALUE_LENGTH, (Byte_t *)Temp);
+
+			Perf_Count_Notification(MYLE_BUTTON_VALUE_LENGTH, (Boolean_t)(Result > 0));
+			if(Result > 0)
+			{
+				Latency_Mark_Notify();
+
+				ret_val = TRUE;
+			}
+			else
+			{
+				Display(("GATT_Handle_Value_Notification failed: %d\r\n", Result));
+			}
+		}
+		else
+			Display(("Not subscribed\r\n"));
+	}
+	else
+		Display(("Not connected\r\n"));
+
+	return(ret_val);
+}
+
+void port2_poll()
+{
+	DWord_t        Sequence;
+	DWord_t        TimeStamp;
+	unsigned int   Index;
+	Boolean_t      Changed;
+	Input_Bitmap_t State;
+	Input_Bitmap_t Changes;
+
+	Byte_t         ButtonMask;
+	Byte_t         Pressed;
+
+	ButtonMask = Config_Get()->ButtonMask;
+	TimeStamp  = BTPS_GetTickCount();
+
+	if((P2IN & ButtonMask) != g_button_state)
+	{
+		// only check the configured button pins, ignore rest
+		g_button_state = P2IN & ButtonMask;
+
+		Latency_Mark_Detect();
+
+		// record the transition in the event history
+		Sequence = EventLog_Add(TimeStamp, (Word_t)g_button_state);
+
+		// update the broadcast button state, it is only advertised while
+		// not connected (the next advertisement picks up the latest state)
+		if(LE_Parameters.BroadcastMode)
+		{
+			BroadcastSequence++;
+
+			if(ConnectionID == 0)
+				SetAdvertisingData();
+		}
+
+		// a transition that was notified live does not need to be journaled,
+		// unless older transitions are still waiting to be delivered or the
+		// client acknowledges the journal (live notifications carry no
+		// sequence number)
+		if((ConnectionID != 0) && (send_notification()) && (JournalSequence == Sequence) && (!JournalLostCount) && (!JournalReliable))
+		{
+			JournalSequence = Sequence + 1;
+		}
+	}
+
+	// recognize gestures, the buttons are active low (pull-ups) and the
+	// engine runs on every poll since clicks and long-presses complete
+	// by the passing of time
+	Pressed = (Byte_t)(~g_button_state & ButtonMask);
+
+	Gesture_Process(TimeStamp, Pressed, GestureCallback);
+
+	// scan the other inputs (if any) and notify every change of this poll
+	// at once as a bitmap with a change mask
+	Input_Scan(Pressed, &State);
+
+	for(Index = 0, Changed = FALSE; Index < INPUT_BITMAP_LENGTH; Index++)
+	{
+		Changes.Bits[Index] = (Byte_t)(State.Bits[Index] ^ InputState.Bits[Index]);
+
+		if(Changes.Bits[Index])
+			Changed = TRUE;
+	}
+
+	if(Changed)
+	{
+		InputState = State;
+
+		NotifyInputs(&State, &Changes);
+	}
+
+	// deliver anything that was recorded while disconnected
+	DrainJournal();
+}
+
+#pragma vector = PORT2_VECTOR
+__interrupt void PORT2_ISR(void)
+{
+	unsigned char Mask;
+
+	// this is used to wake MSP from low power mode if necessary
+	LPM3_EXIT;
+
+	// stamp the edge for the latency measurement
+	Latency_Mark_Edge();
+
+	// only touch the button pins, they are the pins whose interrupt
+	// ConfigureButtonInputs() (Main.c) has enabled
+	Mask  = P2IE;
+
+	P2IES = (unsigned char)((P2IES & ~Mask) | (P2IN & Mask));
+
+	P2IFG &= (unsigned char)~Mask;
+}
@@ -1,21 +1,22 @@
-/*****< sppledemo.h >**********************************************************/
-/*      Copyright 2001 - 2012 Stonestreet One.                                */
-/*      All Rights Reserved.                                                  */
-/*                                                                            */
-/*  SPPLEDEMO - Embedded Bluetooth SPP Emulation using GATT (LE) application. */
-/*                                                                            */
-/*  Author:  Tim Cook                                                         */
-/*                                                                            */
-/*** MODIFICATION HISTORY *****************************************************/
-/*                                                                            */
-/*   mm/dd/yy  F. Lastname    Description of Modification                     */
-/*   --------  -----------    ------------------------------------------------*/
-/*   04/16/12  Tim Cook       Initial creation.                               */
-/******************************************************************************/
-#ifndef __SPPLEDEMO_H__
-#define __SPPLEDEMO_H__
-
-#include "SPPLETyp.h"   /* GATT based SPP-like Types File.                    */
-
-#endif
-
+/*****< sppledemo.h >**********************************************************/
+/*      Copyright 2001 - 2012 Stonestreet One.                                */
+/*      All Rights Reserved.                                                  */
+/*                                                                            */
+/*  SPPLEDEMO - Embedded Bluetooth SPP Emulation using GATT (LE) application. */
+/*                                                                            */
+/*  Author:  Tim Cook                                                         */
+/*                                                                            */
+/*** MODIFICATION HISTORY *****************************************************/
+/*                                                                            */
+/*   mm/dd/yy  F. Lastname    Description of Modification                     */
+/*   --------  -----------    ------------------------------------------------*/
+/*   04/16/12  Tim Cook       Initial creation.                               */
+/******************************************************************************/
+#ifndef __SPPLEDEMO_H__
+#define __SPPLEDEMO_H__
+
+#include "SPPLETyp.h"   /* GATT based SPP-like Types File.                    */
+#include "MYLETyp.h"    /* Button panel GATT Service Types File.              */
+
+#endif
+